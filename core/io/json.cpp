@@ -51,6 +51,20 @@ String JSON::_make_indent(const String &p_indent, int p_size) {
 	return p_indent.repeat(p_size);
 }
 
+String JSON::stringify_float(double p_num, bool p_full_precision) {
+	// Only for exactly 0. If we have approximately 0 let the user decide how much
+	// precision they want.
+	if (p_num == double(0)) {
+		return String("0.0");
+	}
+
+	double magnitude = log10(Math::abs(p_num));
+	int total_digits = p_full_precision ? 17 : 14;
+	int precision = MAX(1, total_digits - (int)Math::floor(magnitude));
+
+	return String::num(p_num, precision);
+}
+
 String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
 	ERR_FAIL_COND_V_MSG(p_cur_indent > Variant::MAX_RECURSION_DEPTH, "...", "JSON structure is too deep. Bailing.");
 
@@ -69,21 +83,8 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 			return p_var.operator bool() ? "true" : "false";
 		case Variant::INT:
 			return itos(p_var);
-		case Variant::FLOAT: {
-			double num = p_var;
-
-			// Only for exactly 0. If we have approximately 0 let the user decide how much
-			// precision they want.
-			if (num == double(0)) {
-				return String("0.0");
-			}
-
-			double magnitude = log10(Math::abs(num));
-			int total_digits = p_full_precision ? 17 : 14;
-			int precision = MAX(1, total_digits - (int)Math::floor(magnitude));
-
-			return String::num(num, precision);
-		}
+		case Variant::FLOAT:
+			return stringify_float(p_var, p_full_precision);
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
 		case Variant::PACKED_FLOAT32_ARRAY:
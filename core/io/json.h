@@ -90,6 +90,7 @@ public:
 	Error parse(const String &p_json_string, bool p_keep_text = false);
 	String get_parsed_text() const;
 
+	static String stringify_float(double p_num, bool p_full_precision);
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	static Variant parse_string(const String &p_json_string);
 
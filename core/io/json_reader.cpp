@@ -0,0 +1,653 @@
+/**************************************************************************/
+/*  json_reader.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_reader.h"
+
+static void _append_utf8(LocalVector<uint8_t> &r_buf, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buf.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_buf.push_back(0xc0 | (p_char >> 6));
+		r_buf.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		r_buf.push_back(0xe0 | (p_char >> 12));
+		r_buf.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buf.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		r_buf.push_back(0xf0 | (p_char >> 18));
+		r_buf.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_buf.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buf.push_back(0x80 | (p_char & 0x3f));
+	}
+}
+
+void JSONReader::_reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream) {
+	file = p_file;
+	stream = p_stream;
+	buffer.resize(BUFFER_SIZE);
+	buffer_pos = 0;
+	buffer_size = 0;
+	source_ended = file.is_null() && stream.is_null();
+	containers.clear();
+	expecting = EXPECT_VALUE;
+	container_empty = false;
+	token_type = TOKEN_NONE;
+	value = Variant();
+	current_line = 1;
+	error = OK;
+	err_str = String();
+}
+
+bool JSONReader::_fill_buffer() {
+	if (source_ended) {
+		return false;
+	}
+
+	buffer_pos = 0;
+	buffer_size = 0;
+	if (file.is_valid()) {
+		buffer_size = file->get_buffer(buffer.ptr(), BUFFER_SIZE);
+		if (buffer_size < (uint32_t)BUFFER_SIZE) {
+			source_ended = true;
+		}
+	} else if (stream.is_valid()) {
+		int available = stream->get_available_bytes();
+		if (available > 0) {
+			int received = 0;
+			if (stream->get_partial_data(buffer.ptr(), MIN(available, BUFFER_SIZE), received) != OK) {
+				source_ended = true;
+			}
+			buffer_size = received;
+		} else if (stream->get_data(buffer.ptr(), 1) == OK) {
+			// Nothing buffered yet, wait for the next byte.
+			buffer_size = 1;
+		} else {
+			source_ended = true;
+		}
+	}
+
+	if (buffer_size == 0) {
+		source_ended = true;
+		return false;
+	}
+	return true;
+}
+
+int JSONReader::_skip_whitespace() {
+	while (true) {
+		int c = _peek_char();
+		if (c < 0 || c > 32) {
+			return c;
+		}
+		_get_char();
+	}
+}
+
+Error JSONReader::_set_error(const String &p_message) {
+	error = ERR_PARSE_ERROR;
+	err_str = p_message;
+	token_type = TOKEN_NONE;
+	value = Variant();
+	return error;
+}
+
+Error JSONReader::_parse_hex(char32_t &r_char) {
+	r_char = 0;
+	for (int j = 0; j < 4; j++) {
+		int c = _get_char();
+		if (c < 0) {
+			return _set_error("Unterminated string");
+		}
+		if (!is_hex_digit(c)) {
+			return _set_error("Malformed hex constant in string");
+		}
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else {
+			v = c - 'A' + 10;
+		}
+		r_char = (r_char << 4) | v;
+	}
+	return OK;
+}
+
+Error JSONReader::_parse_string(String &r_string) {
+	string_buf.clear();
+	while (true) {
+		int c = _get_char();
+		if (c < 0) {
+			return _set_error("Unterminated string");
+		} else if (c == '"') {
+			break;
+		} else if (c != '\\') {
+			// Raw UTF-8 bytes are kept as-is and decoded once at the end.
+			string_buf.push_back(c);
+			continue;
+		}
+
+		int next = _get_char();
+		char32_t res = 0;
+		switch (next) {
+			case -1:
+				return _set_error("Unterminated string");
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case 'u': {
+				Error err = _parse_hex(res);
+				if (err != OK) {
+					return err;
+				}
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (_get_char() != '\\' || _get_char() != 'u') {
+						return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					char32_t trail = 0;
+					err = _parse_hex(trail);
+					if (err != OK) {
+						return err;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					return _set_error("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+				}
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				res = next;
+			} break;
+			default: {
+				return _set_error("Invalid escape sequence");
+			}
+		}
+		_append_utf8(string_buf, res);
+	}
+
+	if (string_buf.is_empty()) {
+		r_string = String();
+	} else {
+		r_string = String::utf8((const char *)string_buf.ptr(), string_buf.size());
+	}
+	return OK;
+}
+
+int JSONReader::_read_digits() {
+	int count = 0;
+	while (is_digit(_peek_char())) {
+		number_buf.push_back(buffer[buffer_pos++]);
+		count++;
+	}
+	return count;
+}
+
+Error JSONReader::_parse_number_text(bool &r_integral) {
+	number_buf.clear();
+	r_integral = true;
+
+	// -?digits(.digits)?([eE][+-]?digits)?
+	if (_peek_char() == '-') {
+		number_buf.push_back(buffer[buffer_pos++]);
+	}
+	if (_peek_char() == '0') {
+		// No leading zeros.
+		number_buf.push_back(buffer[buffer_pos++]);
+		if (is_digit(_peek_char())) {
+			return _set_error("Malformed number");
+		}
+	} else if (_read_digits() == 0) {
+		return _set_error("Malformed number");
+	}
+
+	int c = _peek_char();
+	if (c == '.') {
+		r_integral = false;
+		number_buf.push_back(buffer[buffer_pos++]);
+		if (_read_digits() == 0) {
+			return _set_error("Malformed number");
+		}
+		c = _peek_char();
+	}
+
+	if (c == 'e' || c == 'E') {
+		r_integral = false;
+		number_buf.push_back(buffer[buffer_pos++]);
+		c = _peek_char();
+		if (c == '+' || c == '-') {
+			number_buf.push_back(buffer[buffer_pos++]);
+		}
+		if (_read_digits() == 0) {
+			return _set_error("Malformed number");
+		}
+	}
+
+	number_buf.push_back(0);
+	return OK;
+}
+
+Error JSONReader::_parse_identifier(Variant &r_value) {
+	String id;
+	while (true) {
+		int c = _peek_char();
+		if (c < 0 || !is_ascii_alphabet_char(c)) {
+			break;
+		}
+		id += char32_t(c);
+		buffer_pos++;
+	}
+
+	if (id == "true") {
+		r_value = true;
+	} else if (id == "false") {
+		r_value = false;
+	} else if (id == "null") {
+		r_value = Variant();
+	} else {
+		return _set_error(vformat("Expected 'true', 'false', or 'null', got '%s'", id));
+	}
+	return OK;
+}
+
+void JSONReader::_value_done() {
+	expecting = containers.is_empty() ? EXPECT_EOF : EXPECT_COMMA_OR_END;
+	container_empty = false;
+}
+
+void JSONReader::_end_container() {
+	_get_char();
+	token_type = containers[containers.size() - 1] ? TOKEN_OBJECT_END : TOKEN_ARRAY_END;
+	containers.resize(containers.size() - 1);
+	_value_done();
+}
+
+Error JSONReader::read() {
+	if (error != OK) {
+		return error;
+	}
+
+	token_type = TOKEN_NONE;
+	value = Variant();
+
+	while (true) {
+		int c = _skip_whitespace();
+		switch (expecting) {
+			case EXPECT_EOF: {
+				if (c < 0) {
+					return ERR_FILE_EOF;
+				}
+				return _set_error("Expected 'EOF'");
+			}
+			case EXPECT_COMMA_OR_END: {
+				bool in_object = containers[containers.size() - 1];
+				if (c == ',') {
+					_get_char();
+					expecting = in_object ? EXPECT_KEY : EXPECT_VALUE;
+					continue;
+				}
+				if (c == (in_object ? '}' : ']')) {
+					_end_container();
+					return OK;
+				}
+				return _set_error(in_object ? "Expected '}' or ','" : "Expected ','");
+			}
+			case EXPECT_KEY: {
+				if (c == '}' && container_empty) {
+					_end_container();
+					return OK;
+				}
+				if (c != '"') {
+					return _set_error("Expected key");
+				}
+				_get_char();
+				String key;
+				Error err = _parse_string(key);
+				if (err != OK) {
+					return err;
+				}
+				if (_skip_whitespace() != ':') {
+					return _set_error("Expected ':'");
+				}
+				_get_char();
+				expecting = EXPECT_VALUE;
+				container_empty = false;
+				token_type = TOKEN_KEY;
+				value = key;
+				return OK;
+			}
+			case EXPECT_VALUE: {
+				if (c == ']' && container_empty && !containers[containers.size() - 1]) {
+					_end_container();
+					return OK;
+				}
+				if (c == '{' || c == '[') {
+					if (containers.size() >= (uint32_t)Variant::MAX_RECURSION_DEPTH) {
+						return _set_error("JSON structure is too deep");
+					}
+					_get_char();
+					containers.push_back(c == '{');
+					expecting = c == '{' ? EXPECT_KEY : EXPECT_VALUE;
+					container_empty = true;
+					token_type = c == '{' ? TOKEN_OBJECT_BEGIN : TOKEN_ARRAY_BEGIN;
+					return OK;
+				}
+
+				if (c == '"') {
+					_get_char();
+					String str;
+					Error err = _parse_string(str);
+					if (err != OK) {
+						return err;
+					}
+					value = str;
+				} else if (c == '-' || is_digit(c)) {
+					bool integral;
+					Error err = _parse_number_text(integral);
+					if (err != OK) {
+						return err;
+					}
+					value = String::to_float(number_buf.ptr());
+				} else if (c >= 0 && is_ascii_alphabet_char(c)) {
+					Error err = _parse_identifier(value);
+					if (err != OK) {
+						return err;
+					}
+				} else if (c < 0) {
+					return _set_error("Expected value, got 'EOF'");
+				} else {
+					return _set_error("Unexpected character");
+				}
+				token_type = TOKEN_VALUE;
+				_value_done();
+				return OK;
+			}
+		}
+	}
+}
+
+Error JSONReader::skip_section() {
+	if (token_type == TOKEN_KEY) {
+		Error err = read();
+		if (err != OK) {
+			return err;
+		}
+	}
+	if (token_type != TOKEN_OBJECT_BEGIN && token_type != TOKEN_ARRAY_BEGIN) {
+		return OK;
+	}
+
+	int target_depth = get_depth() - 1;
+	while (get_depth() > target_depth) {
+		Error err = read();
+		if (err != OK) {
+			return err;
+		}
+	}
+	return OK;
+}
+
+Error JSONReader::_build_value(TokenType p_token, Variant &r_value) {
+	switch (p_token) {
+		case TOKEN_VALUE: {
+			r_value = value;
+		} break;
+		case TOKEN_OBJECT_BEGIN: {
+			Dictionary d;
+			while (true) {
+				Error err = read();
+				if (err != OK) {
+					return err;
+				}
+				if (token_type == TOKEN_OBJECT_END) {
+					break;
+				}
+				String key = value;
+				err = read();
+				if (err != OK) {
+					return err;
+				}
+				Variant v;
+				err = _build_value(token_type, v);
+				if (err != OK) {
+					return err;
+				}
+				d[key] = v;
+			}
+			r_value = d;
+		} break;
+		case TOKEN_ARRAY_BEGIN: {
+			Array a;
+			while (true) {
+				Error err = read();
+				if (err != OK) {
+					return err;
+				}
+				if (token_type == TOKEN_ARRAY_END) {
+					break;
+				}
+				Variant v;
+				err = _build_value(token_type, v);
+				if (err != OK) {
+					return err;
+				}
+				a.push_back(v);
+			}
+			r_value = a;
+		} break;
+		default: {
+			return _set_error("Expected value");
+		}
+	}
+	return OK;
+}
+
+Variant JSONReader::read_value() {
+	Error err = read();
+	if (err != OK) {
+		return Variant();
+	}
+	Variant ret;
+	err = _build_value(token_type, ret);
+	if (err != OK) {
+		return Variant();
+	}
+	token_type = TOKEN_VALUE;
+	value = ret;
+	return ret;
+}
+
+Error JSONReader::_begin_packed_array() {
+	if (error != OK) {
+		return error;
+	}
+
+	token_type = TOKEN_NONE;
+	value = Variant();
+
+	if (expecting == EXPECT_COMMA_OR_END && !containers[containers.size() - 1]) {
+		if (_skip_whitespace() != ',') {
+			return _set_error("Expected ','");
+		}
+		_get_char();
+		expecting = EXPECT_VALUE;
+	}
+	if (expecting != EXPECT_VALUE) {
+		return _set_error("Expected value");
+	}
+	if (_skip_whitespace() != '[') {
+		return _set_error("Expected '['");
+	}
+	_get_char();
+	return OK;
+}
+
+template <typename T, typename F>
+Vector<T> JSONReader::_read_packed_array(F p_convert) {
+	Vector<T> ret;
+	if (_begin_packed_array() != OK) {
+		return ret;
+	}
+
+	// Numbers are converted straight into the array, without going through a Variant each.
+	int count = 0;
+	T *w = nullptr;
+	while (true) {
+		int c = _skip_whitespace();
+		if (c == ']' && count == 0) {
+			_get_char();
+			break;
+		}
+		if (c != '-' && !is_digit(c)) {
+			_set_error("Expected number");
+			return Vector<T>();
+		}
+
+		bool integral;
+		if (_parse_number_text(integral) != OK) {
+			return Vector<T>();
+		}
+		if (count == ret.size()) {
+			ret.resize(MAX(16, count * 2));
+			w = ret.ptrw();
+		}
+		w[count++] = p_convert(number_buf.ptr(), integral);
+
+		c = _skip_whitespace();
+		if (c == ',') {
+			_get_char();
+		} else if (c == ']') {
+			_get_char();
+			break;
+		} else {
+			_set_error("Expected ','");
+			return Vector<T>();
+		}
+	}
+	ret.resize(count);
+
+	token_type = TOKEN_VALUE;
+	_value_done();
+	return ret;
+}
+
+PackedFloat32Array JSONReader::read_packed_float32_array() {
+	return _read_packed_array<float>([](const char *p_str, bool p_integral) {
+		return (float)String::to_float(p_str);
+	});
+}
+
+PackedFloat64Array JSONReader::read_packed_float64_array() {
+	return _read_packed_array<double>([](const char *p_str, bool p_integral) {
+		return String::to_float(p_str);
+	});
+}
+
+PackedInt32Array JSONReader::read_packed_int32_array() {
+	return _read_packed_array<int32_t>([](const char *p_str, bool p_integral) {
+		return p_integral ? (int32_t)String::to_int(p_str) : (int32_t)String::to_float(p_str);
+	});
+}
+
+PackedInt64Array JSONReader::read_packed_int64_array() {
+	return _read_packed_array<int64_t>([](const char *p_str, bool p_integral) {
+		return p_integral ? String::to_int(p_str) : (int64_t)String::to_float(p_str);
+	});
+}
+
+Error JSONReader::open(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s'.", p_path));
+	_reset(f, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONReader::open_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	_reset(p_file, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONReader::open_stream(const Ref<StreamPeer> &p_stream) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	_reset(Ref<FileAccess>(), p_stream);
+	return OK;
+}
+
+void JSONReader::close() {
+	_reset(Ref<FileAccess>(), Ref<StreamPeer>());
+	buffer.clear();
+}
+
+void JSONReader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("open", "path"), &JSONReader::open);
+	ClassDB::bind_method(D_METHOD("open_file", "file"), &JSONReader::open_file);
+	ClassDB::bind_method(D_METHOD("open_stream", "stream"), &JSONReader::open_stream);
+	ClassDB::bind_method(D_METHOD("close"), &JSONReader::close);
+
+	ClassDB::bind_method(D_METHOD("read"), &JSONReader::read);
+	ClassDB::bind_method(D_METHOD("get_token_type"), &JSONReader::get_token_type);
+	ClassDB::bind_method(D_METHOD("get_value"), &JSONReader::get_value);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONReader::get_depth);
+	ClassDB::bind_method(D_METHOD("get_current_line"), &JSONReader::get_current_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONReader::get_error_message);
+
+	ClassDB::bind_method(D_METHOD("skip_section"), &JSONReader::skip_section);
+	ClassDB::bind_method(D_METHOD("read_value"), &JSONReader::read_value);
+	ClassDB::bind_method(D_METHOD("read_packed_float32_array"), &JSONReader::read_packed_float32_array);
+	ClassDB::bind_method(D_METHOD("read_packed_float64_array"), &JSONReader::read_packed_float64_array);
+	ClassDB::bind_method(D_METHOD("read_packed_int32_array"), &JSONReader::read_packed_int32_array);
+	ClassDB::bind_method(D_METHOD("read_packed_int64_array"), &JSONReader::read_packed_int64_array);
+
+	BIND_ENUM_CONSTANT(TOKEN_NONE);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_END);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_END);
+	BIND_ENUM_CONSTANT(TOKEN_KEY);
+	BIND_ENUM_CONSTANT(TOKEN_VALUE);
+}
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  json_reader.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Pull parser reading JSON incrementally from a file or stream, without
+// building the whole document in memory.
+class JSONReader : public RefCounted {
+	GDCLASS(JSONReader, RefCounted);
+
+public:
+	enum TokenType {
+		TOKEN_NONE,
+		TOKEN_OBJECT_BEGIN,
+		TOKEN_OBJECT_END,
+		TOKEN_ARRAY_BEGIN,
+		TOKEN_ARRAY_END,
+		TOKEN_KEY,
+		TOKEN_VALUE,
+	};
+
+private:
+	enum Expecting {
+		EXPECT_VALUE,
+		EXPECT_KEY,
+		EXPECT_COMMA_OR_END,
+		EXPECT_EOF,
+	};
+
+	static const int BUFFER_SIZE = 65536;
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+
+	LocalVector<uint8_t> buffer;
+	uint32_t buffer_pos = 0;
+	uint32_t buffer_size = 0;
+	bool source_ended = true;
+
+	// One entry per open container, true for objects.
+	LocalVector<bool> containers;
+	Expecting expecting = EXPECT_VALUE;
+	bool container_empty = false;
+
+	TokenType token_type = TOKEN_NONE;
+	Variant value;
+	LocalVector<uint8_t> string_buf;
+	LocalVector<char> number_buf;
+
+	int current_line = 1;
+	Error error = OK;
+	String err_str;
+
+	bool _fill_buffer();
+	_FORCE_INLINE_ int _peek_char() {
+		if (buffer_pos >= buffer_size && !_fill_buffer()) {
+			return -1;
+		}
+		return buffer[buffer_pos];
+	}
+	_FORCE_INLINE_ int _get_char() {
+		int c = _peek_char();
+		if (c >= 0) {
+			buffer_pos++;
+			if (c == '\n') {
+				current_line++;
+			}
+		}
+		return c;
+	}
+	int _skip_whitespace();
+
+	Error _set_error(const String &p_message);
+	Error _parse_hex(char32_t &r_char);
+	Error _parse_string(String &r_string);
+	int _read_digits();
+	Error _parse_number_text(bool &r_integral);
+	Error _parse_identifier(Variant &r_value);
+	void _value_done();
+	void _end_container();
+	Error _build_value(TokenType p_token, Variant &r_value);
+	Error _begin_packed_array();
+	template <typename T, typename F>
+	Vector<T> _read_packed_array(F p_convert);
+	void _reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error open(const String &p_path);
+	Error open_file(const Ref<FileAccess> &p_file);
+	Error open_stream(const Ref<StreamPeer> &p_stream);
+	void close();
+
+	Error read();
+	TokenType get_token_type() const { return token_type; }
+	Variant get_value() const { return value; }
+	int get_depth() const { return containers.size(); }
+	int get_current_line() const { return current_line; }
+	String get_error_message() const { return err_str; }
+
+	Error skip_section();
+	Variant read_value();
+
+	PackedFloat32Array read_packed_float32_array();
+	PackedFloat64Array read_packed_float64_array();
+	PackedInt32Array read_packed_int32_array();
+	PackedInt64Array read_packed_int64_array();
+};
+
+VARIANT_ENUM_CAST(JSONReader::TokenType);
+
+#endif // JSON_READER_H
@@ -0,0 +1,280 @@
+/**************************************************************************/
+/*  json_writer.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_writer.h"
+
+#include "core/io/json.h"
+
+void JSONWriter::_reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream) {
+	file = p_file;
+	stream = p_stream;
+	buffer.clear();
+	buffer.reserve(BUFFER_SIZE);
+	containers.clear();
+	after_key = false;
+	has_root = false;
+	error = OK;
+}
+
+void JSONWriter::_write(const char *p_str, int p_len) {
+	if (buffer.size() + p_len > (uint32_t)BUFFER_SIZE) {
+		_flush_buffer();
+	}
+	if (p_len >= BUFFER_SIZE) {
+		// Too big to be worth buffering.
+		if (file.is_valid()) {
+			if (!file->store_buffer((const uint8_t *)p_str, p_len)) {
+				error = ERR_FILE_CANT_WRITE;
+			}
+		} else if (stream.is_valid()) {
+			Error err = stream->put_data((const uint8_t *)p_str, p_len);
+			if (err != OK) {
+				error = err;
+			}
+		}
+		return;
+	}
+	uint32_t ofs = buffer.size();
+	buffer.resize(ofs + p_len);
+	memcpy(buffer.ptr() + ofs, p_str, p_len);
+}
+
+void JSONWriter::_write_string(const String &p_string) {
+	CharString utf8 = p_string.utf8();
+	_write(utf8.get_data(), utf8.length());
+}
+
+Error JSONWriter::_begin_item(bool p_is_key) {
+	ERR_FAIL_COND_V_MSG(file.is_null() && stream.is_null(), ERR_UNCONFIGURED, "No file or stream is open.");
+
+	if (containers.is_empty()) {
+		ERR_FAIL_COND_V_MSG(p_is_key, ERR_INVALID_PARAMETER, "Keys can only be written inside an object.");
+		ERR_FAIL_COND_V_MSG(has_root, ERR_ALREADY_EXISTS, "A JSON document can only have one root value.");
+		has_root = true;
+		return OK;
+	}
+
+	Container &top = containers[containers.size() - 1];
+	if (top.object) {
+		if (p_is_key) {
+			ERR_FAIL_COND_V_MSG(after_key, ERR_INVALID_PARAMETER, "Expected a value after the key.");
+		} else {
+			ERR_FAIL_COND_V_MSG(!after_key, ERR_INVALID_PARAMETER, "Values in an object must be preceded by a key.");
+			after_key = false;
+			return OK;
+		}
+	} else {
+		ERR_FAIL_COND_V_MSG(p_is_key, ERR_INVALID_PARAMETER, "Keys can only be written inside an object.");
+	}
+
+	if (top.has_items) {
+		_write_char(',');
+	}
+	top.has_items = true;
+	return OK;
+}
+
+template <typename T>
+void JSONWriter::_write_int_array(const T *p_data, int p_size) {
+	_write_char('[');
+	for (int i = 0; i < p_size; i++) {
+		if (i > 0) {
+			_write_char(',');
+		}
+		_write_string(itos(p_data[i]));
+	}
+	_write_char(']');
+}
+
+template <typename T>
+void JSONWriter::_write_float_array(const T *p_data, int p_size) {
+	_write_char('[');
+	for (int i = 0; i < p_size; i++) {
+		if (i > 0) {
+			_write_char(',');
+		}
+		_write_string(JSON::stringify_float(p_data[i], full_precision));
+	}
+	_write_char(']');
+}
+
+Error JSONWriter::begin_object() {
+	Error err = _begin_item(false);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V_MSG(containers.size() >= (uint32_t)Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "JSON structure is too deep.");
+	_write_char('{');
+	containers.push_back({ true, false });
+	return OK;
+}
+
+Error JSONWriter::end_object() {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || !containers[containers.size() - 1].object, ERR_INVALID_PARAMETER, "No object to end.");
+	ERR_FAIL_COND_V_MSG(after_key, ERR_INVALID_PARAMETER, "Expected a value after the key.");
+	_write_char('}');
+	containers.resize(containers.size() - 1);
+	return OK;
+}
+
+Error JSONWriter::begin_array() {
+	Error err = _begin_item(false);
+	ERR_FAIL_COND_V(err != OK, err);
+	ERR_FAIL_COND_V_MSG(containers.size() >= (uint32_t)Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "JSON structure is too deep.");
+	_write_char('[');
+	containers.push_back({ false, false });
+	return OK;
+}
+
+Error JSONWriter::end_array() {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || containers[containers.size() - 1].object, ERR_INVALID_PARAMETER, "No array to end.");
+	_write_char(']');
+	containers.resize(containers.size() - 1);
+	return OK;
+}
+
+Error JSONWriter::write_key(const String &p_key) {
+	Error err = _begin_item(true);
+	ERR_FAIL_COND_V(err != OK, err);
+	_write_char('"');
+	_write_string(p_key.json_escape());
+	_write_char('"');
+	_write_char(':');
+	after_key = true;
+	return OK;
+}
+
+Error JSONWriter::write_value(const Variant &p_value) {
+	Error err = _begin_item(false);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	// Numeric packed arrays are written straight from their typed data, without converting them to an Array first.
+	switch (p_value.get_type()) {
+		case Variant::PACKED_INT32_ARRAY: {
+			const PackedInt32Array arr = p_value;
+			_write_int_array(arr.ptr(), arr.size());
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			const PackedInt64Array arr = p_value;
+			_write_int_array(arr.ptr(), arr.size());
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			const PackedFloat32Array arr = p_value;
+			_write_float_array(arr.ptr(), arr.size());
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			const PackedFloat64Array arr = p_value;
+			_write_float_array(arr.ptr(), arr.size());
+		} break;
+		default: {
+			_write_string(JSON::stringify(p_value, "", false, full_precision));
+		} break;
+	}
+	// Large values are written out right away, so they can fail here.
+	return error;
+}
+
+void JSONWriter::_flush_buffer() {
+	if (!buffer.is_empty()) {
+		if (file.is_valid()) {
+			if (!file->store_buffer(buffer.ptr(), buffer.size())) {
+				error = ERR_FILE_CANT_WRITE;
+			}
+		} else if (stream.is_valid()) {
+			Error err = stream->put_data(buffer.ptr(), buffer.size());
+			if (err != OK) {
+				error = err;
+			}
+		}
+		buffer.clear();
+	}
+}
+
+Error JSONWriter::flush() {
+	_flush_buffer();
+	if (file.is_valid() && error == OK) {
+		file->flush();
+	}
+	return error;
+}
+
+Error JSONWriter::open(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s'.", p_path));
+	flush();
+	_reset(f, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONWriter::open_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	flush();
+	_reset(p_file, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONWriter::open_stream(const Ref<StreamPeer> &p_stream) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	flush();
+	_reset(Ref<FileAccess>(), p_stream);
+	return OK;
+}
+
+Error JSONWriter::close() {
+	Error err = flush();
+	bool complete = containers.is_empty() && !after_key;
+	_reset(Ref<FileAccess>(), Ref<StreamPeer>());
+	ERR_FAIL_COND_V_MSG(!complete, ERR_INVALID_DATA, "Closing JSONWriter with unterminated objects or arrays.");
+	return err;
+}
+
+void JSONWriter::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("open", "path"), &JSONWriter::open);
+	ClassDB::bind_method(D_METHOD("open_file", "file"), &JSONWriter::open_file);
+	ClassDB::bind_method(D_METHOD("open_stream", "stream"), &JSONWriter::open_stream);
+	ClassDB::bind_method(D_METHOD("close"), &JSONWriter::close);
+
+	ClassDB::bind_method(D_METHOD("begin_object"), &JSONWriter::begin_object);
+	ClassDB::bind_method(D_METHOD("end_object"), &JSONWriter::end_object);
+	ClassDB::bind_method(D_METHOD("begin_array"), &JSONWriter::begin_array);
+	ClassDB::bind_method(D_METHOD("end_array"), &JSONWriter::end_array);
+	ClassDB::bind_method(D_METHOD("write_key", "key"), &JSONWriter::write_key);
+	ClassDB::bind_method(D_METHOD("write_value", "value"), &JSONWriter::write_value);
+	ClassDB::bind_method(D_METHOD("flush"), &JSONWriter::flush);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONWriter::get_depth);
+
+	ClassDB::bind_method(D_METHOD("set_full_precision", "enable"), &JSONWriter::set_full_precision);
+	ClassDB::bind_method(D_METHOD("is_full_precision"), &JSONWriter::is_full_precision);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "full_precision"), "set_full_precision", "is_full_precision");
+}
+
+JSONWriter::~JSONWriter() {
+	flush();
+}
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  json_writer.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Writes JSON incrementally to a file or stream, without building the whole
+// document as a single String.
+class JSONWriter : public RefCounted {
+	GDCLASS(JSONWriter, RefCounted);
+
+	static const int BUFFER_SIZE = 65536;
+
+	struct Container {
+		bool object = false;
+		bool has_items = false;
+	};
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+
+	LocalVector<uint8_t> buffer;
+	LocalVector<Container> containers;
+	bool after_key = false;
+	bool has_root = false;
+	bool full_precision = false;
+	Error error = OK;
+
+	void _write(const char *p_str, int p_len);
+	_FORCE_INLINE_ void _write_char(char p_char) {
+		buffer.push_back(p_char);
+		if (buffer.size() >= (uint32_t)BUFFER_SIZE) {
+			_flush_buffer();
+		}
+	}
+	void _write_string(const String &p_string);
+	template <typename T>
+	void _write_int_array(const T *p_data, int p_size);
+	template <typename T>
+	void _write_float_array(const T *p_data, int p_size);
+	void _flush_buffer();
+	Error _begin_item(bool p_is_key);
+	void _reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error open(const String &p_path);
+	Error open_file(const Ref<FileAccess> &p_file);
+	Error open_stream(const Ref<StreamPeer> &p_stream);
+	Error close();
+
+	Error begin_object();
+	Error end_object();
+	Error begin_array();
+	Error end_array();
+	Error write_key(const String &p_key);
+	Error write_value(const Variant &p_value);
+	Error flush();
+
+	int get_depth() const { return containers.size(); }
+
+	void set_full_precision(bool p_enable) { full_precision = p_enable; }
+	bool is_full_precision() const { return full_precision; }
+
+	~JSONWriter();
+};
+
+#endif // JSON_WRITER_H
@@ -93,9 +93,13 @@ enum {
 	// Version 4: New string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
 	// Version 6: Added PackedVector4Array Variant type.
-	FORMAT_VERSION = 6,
+	// Version 7: Packed arrays of fixed-size elements are aligned in the file.
+	FORMAT_VERSION = 7,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_ALIGNED_PACKED_ARRAYS = 7,
+	// Data of packed arrays starts at a multiple of this, so it can be read with a single bulk copy.
+	PACKED_ARRAY_ALIGNMENT = 16,
 };
 
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
@@ -107,6 +111,46 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+Error ResourceLoaderBinary::_advance_alignment() {
+	if (ver_format < FORMAT_VERSION_ALIGNED_PACKED_ARRAYS) {
+		return OK;
+	}
+	uint32_t extra = f->get_32();
+	ERR_FAIL_COND_V(extra >= PACKED_ARRAY_ALIGNMENT, ERR_FILE_CORRUPT);
+	for (uint32_t i = 0; i < extra; i++) {
+		f->get_8(); //pad to alignment
+	}
+	return OK;
+}
+
+// Reads reals stored with a different precision than `real_t`, still in bulk, and converts them.
+template <typename T>
+static void read_converted_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+	constexpr size_t CHUNK_SIZE = 256;
+	T chunk[CHUNK_SIZE];
+	while (count > 0) {
+		const size_t to_read = MIN(count, CHUNK_SIZE);
+		f->get_buffer((uint8_t *)chunk, to_read * sizeof(T));
+		if (f->is_big_endian()) {
+			for (size_t i = 0; i < to_read; i++) {
+				if constexpr (sizeof(T) == 8) {
+					uint64_t *ptr = (uint64_t *)&chunk[i];
+					*ptr = BSWAP64(*ptr);
+				} else {
+					uint32_t *ptr = (uint32_t *)&chunk[i];
+					*ptr = BSWAP32(*ptr);
+				}
+			}
+		}
+		for (size_t i = 0; i < to_read; i++) {
+			dst[i] = chunk[i];
+		}
+		dst += to_read;
+		count -= to_read;
+	}
+}
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
@@ -121,10 +165,8 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if constexpr (sizeof(real_t) == 4) {
-			// May be slower, but this is for compatibility. Eventually the data should be converted.
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
-			}
+			// Needs conversion, but this is for compatibility. Eventually the data should be converted.
+			read_converted_reals<double>(dst, f, count);
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
 		}
@@ -141,9 +183,7 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if constexpr (sizeof(real_t) == 8) {
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
-			}
+			read_converted_reals<float>(dst, f, count);
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
 		}
@@ -508,6 +548,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_BYTE_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<uint8_t> array;
 			array.resize(len);
@@ -520,6 +562,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT32_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<int32_t> array;
 			array.resize(len);
@@ -539,6 +583,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT64_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<int64_t> array;
 			array.resize(len);
@@ -558,6 +604,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_FLOAT32_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<float> array;
 			array.resize(len);
@@ -577,6 +625,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_FLOAT64_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<double> array;
 			array.resize(len);
@@ -608,6 +658,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR2_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<Vector2> array;
 			array.resize(len);
@@ -621,6 +673,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR3_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<Vector3> array;
 			array.resize(len);
@@ -634,6 +688,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_COLOR_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<Color> array;
 			array.resize(len);
@@ -655,6 +711,8 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR4_ARRAY: {
 			uint32_t len = f->get_32();
+			Error align_err = _advance_alignment();
+			ERR_FAIL_COND_V(align_err != OK, align_err);
 
 			Vector<Vector4> array;
 			array.resize(len);
@@ -1481,6 +1539,14 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 
 	int64_t size_diff = (int64_t)fw->get_position() - (int64_t)f->get_position();
 
+	// The internal resource table keeps its size, so pad after it to keep
+	// the shifted resource data at the same alignment as in the original file.
+	uint32_t align_padding = 0;
+	if (ver_format >= FORMAT_VERSION_ALIGNED_PACKED_ARRAYS) {
+		align_padding = (PACKED_ARRAY_ALIGNMENT - (size_diff % PACKED_ARRAY_ALIGNMENT + PACKED_ARRAY_ALIGNMENT) % PACKED_ARRAY_ALIGNMENT) % PACKED_ARRAY_ALIGNMENT;
+		size_diff += align_padding;
+	}
+
 	//internal resources
 	uint32_t int_resources_size = f->get_32();
 	fw->store_32(int_resources_size);
@@ -1492,6 +1558,10 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 		fw->store_64(offset + size_diff);
 	}
 
+	for (uint32_t i = 0; i < align_padding; i++) {
+		fw->store_8(0);
+	}
+
 	//rest of file
 	uint8_t b = f->get_8();
 	while (!f->eof_reached()) {
@@ -1592,6 +1662,32 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
+void ResourceFormatSaverBinaryInstance::_align_buffer(Ref<FileAccess> f) {
+	// The amount of padding is stored first, so readers never depend on the absolute file position.
+	uint32_t extra = (PACKED_ARRAY_ALIGNMENT - ((f->get_position() + 4) % PACKED_ARRAY_ALIGNMENT)) % PACKED_ARRAY_ALIGNMENT;
+	f->store_32(extra);
+	for (uint32_t i = 0; i < extra; i++) {
+		f->store_8(0); //pad to alignment
+	}
+}
+
+template <typename T>
+static void store_words(Ref<FileAccess> &f, const T *p_words, uint64_t p_count) {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+	if (!f->is_big_endian()) {
+		// Same byte order as `store_32()`/`store_64()` would produce, so store in bulk.
+		f->store_buffer((const uint8_t *)p_words, p_count * sizeof(T));
+		return;
+	}
+	for (uint64_t i = 0; i < p_count; i++) {
+		if constexpr (sizeof(T) == 8) {
+			f->store_64(((const uint64_t *)p_words)[i]);
+		} else {
+			f->store_32(((const uint32_t *)p_words)[i]);
+		}
+	}
+}
+
 void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
@@ -1899,6 +1995,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_align_buffer(f);
 			const uint8_t *r = arr.ptr();
 			f->store_buffer(r, len);
 			_pad_buffer(f, len);
@@ -1909,10 +2006,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(uint32_t(r[i]));
-			}
+			_align_buffer(f);
+			store_words(f, arr.ptr(), len);
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
@@ -1920,10 +2015,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(uint64_t(r[i]));
-			}
+			_align_buffer(f);
+			store_words(f, arr.ptr(), len);
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
@@ -1931,10 +2024,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i]);
-			}
+			_align_buffer(f);
+			store_words(f, arr.ptr(), len);
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
@@ -1942,10 +2033,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
-			}
+			_align_buffer(f);
+			store_words(f, arr.ptr(), len);
 
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
@@ -1964,11 +2053,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-			}
+			_align_buffer(f);
+			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
+			store_words(f, reinterpret_cast<const real_t *>(arr.ptr()), uint64_t(len) * 2);
 		} break;
 
 		case Variant::PACKED_VECTOR3_ARRAY: {
@@ -1976,12 +2063,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-			}
+			_align_buffer(f);
+			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
+			store_words(f, reinterpret_cast<const real_t *>(arr.ptr()), uint64_t(len) * 3);
 		} break;
 
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -1989,13 +2073,10 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_float(r[i].r);
-				f->store_float(r[i].g);
-				f->store_float(r[i].b);
-				f->store_float(r[i].a);
-			}
+			_align_buffer(f);
+			// Colors always use `float` even with double-precision support enabled
+			static_assert(sizeof(Color) == 4 * sizeof(float));
+			store_words(f, reinterpret_cast<const float *>(arr.ptr()), uint64_t(len) * 4);
 
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
@@ -2003,13 +2084,9 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector4> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
-			const Vector4 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-				f->store_real(r[i].w);
-			}
+			_align_buffer(f);
+			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
+			store_words(f, reinterpret_cast<const real_t *>(arr.ptr()), uint64_t(len) * 4);
 
 		} break;
 		default: {
@@ -88,6 +88,12 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// trees whose items rarely move can be left out of the incremental optimize done on each update
+	void params_set_incremental_optimize_tree_mask(uint32_t p_tree_mask) {
+		BVH_LOCKED_FUNCTION
+		tree._incremental_optimize_tree_mask = p_tree_mask;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
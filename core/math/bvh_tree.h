@@ -179,6 +179,7 @@ public:
 	BVH_Tree() {
 		for (int n = 0; n < NUM_TREES; n++) {
 			_root_node_id[n] = BVHCommon::INVALID;
+			_tree_needs_refit[n] = false;
 		}
 
 		// disallow zero leaf ids
@@ -362,6 +363,7 @@ private:
 			// we defer the refit updates until the update function is called once per frame
 			if (refit) {
 				leaf.set_dirty(true);
+				_tree_needs_refit[p_tree_id] = true;
 			}
 		} else {
 			// remove node if empty
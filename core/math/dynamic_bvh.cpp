@@ -30,6 +30,8 @@
 
 #include "dynamic_bvh.h"
 
+#include "core/object/worker_thread_pool.h"
+
 void DynamicBVH::_delete_node(Node *p_node) {
 	node_allocator.free(p_node);
 }
@@ -283,6 +285,123 @@ DynamicBVH::Node *DynamicBVH::_node_sort(Node *n, Node *&r) {
 	return (n);
 }
 
+real_t DynamicBVH::_sah_area(const Volume &p_volume) {
+	const Vector3 edges = p_volume.get_length();
+	return edges.x * edges.y + edges.y * edges.z + edges.z * edges.x;
+}
+
+DynamicBVH::Node *DynamicBVH::_sah_build(SAHBuild &r_build, uint32_t p_begin, uint32_t p_end, uint32_t p_slot, int p_split_depth) {
+	Node **leaves = r_build.leaves;
+	const uint32_t count = p_end - p_begin;
+	if (count == 1) {
+		return leaves[p_begin];
+	}
+
+	if (p_split_depth == 0 && count >= SAH_PARALLEL_MIN_LEAVES) {
+		// Build this subtree later from a worker thread. A subtree with N leaves
+		// uses the N - 1 internal nodes starting at its slot, and its root is the first one.
+		SAHBuildTask task;
+		task.begin = p_begin;
+		task.end = p_end;
+		task.slot = p_slot;
+		r_build.tasks.push_back(task);
+		return r_build.internal[p_slot];
+	}
+
+	Volume volume = leaves[p_begin]->volume;
+	Vector3 centroid_min = volume.get_center();
+	Vector3 centroid_max = centroid_min;
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		volume = volume.merge(leaves[i]->volume);
+		const Vector3 center = leaves[i]->volume.get_center();
+		centroid_min = centroid_min.min(center);
+		centroid_max = centroid_max.max(center);
+	}
+
+	int best_axis = -1;
+	int best_bin = 0;
+	real_t best_cost = INFINITY;
+
+	if (count > 2) {
+		for (int axis = 0; axis < 3; axis++) {
+			const real_t extent = centroid_max[axis] - centroid_min[axis];
+			if (extent <= 0) {
+				continue;
+			}
+			const real_t scale = SAH_BIN_COUNT / extent;
+
+			uint32_t bin_counts[SAH_BIN_COUNT] = {};
+			Volume bin_volumes[SAH_BIN_COUNT];
+			for (uint32_t i = p_begin; i < p_end; i++) {
+				const int bin = MIN(int((leaves[i]->volume.get_center()[axis] - centroid_min[axis]) * scale), SAH_BIN_COUNT - 1);
+				bin_volumes[bin] = bin_counts[bin] ? bin_volumes[bin].merge(leaves[i]->volume) : leaves[i]->volume;
+				bin_counts[bin]++;
+			}
+
+			// Sweep from the right to get the cost of everything past each split.
+			real_t right_cost[SAH_BIN_COUNT];
+			Volume accum;
+			uint32_t accum_count = 0;
+			for (int bin = SAH_BIN_COUNT - 1; bin > 0; bin--) {
+				if (bin_counts[bin]) {
+					accum = accum_count ? accum.merge(bin_volumes[bin]) : bin_volumes[bin];
+					accum_count += bin_counts[bin];
+				}
+				right_cost[bin] = accum_count ? _sah_area(accum) * accum_count : -1;
+			}
+
+			accum_count = 0;
+			for (int bin = 0; bin < SAH_BIN_COUNT - 1; bin++) {
+				if (bin_counts[bin]) {
+					accum = accum_count ? accum.merge(bin_volumes[bin]) : bin_volumes[bin];
+					accum_count += bin_counts[bin];
+				}
+				if (accum_count == 0 || right_cost[bin + 1] < 0) {
+					continue;
+				}
+				const real_t cost = _sah_area(accum) * accum_count + right_cost[bin + 1];
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_axis = axis;
+					best_bin = bin;
+				}
+			}
+		}
+	}
+
+	uint32_t mid = p_begin + count / 2;
+	if (best_axis >= 0) {
+		const real_t scale = SAH_BIN_COUNT / (centroid_max[best_axis] - centroid_min[best_axis]);
+		uint32_t left = p_begin;
+		uint32_t right = p_end;
+		while (left < right) {
+			const int bin = MIN(int((leaves[left]->volume.get_center()[best_axis] - centroid_min[best_axis]) * scale), SAH_BIN_COUNT - 1);
+			if (bin <= best_bin) {
+				left++;
+			} else {
+				right--;
+				SWAP(leaves[left], leaves[right]);
+			}
+		}
+		mid = left;
+	}
+	// Otherwise all centroids coincide, so any split is as good as another.
+
+	Node *node = r_build.internal[p_slot];
+	node->volume = volume;
+	node->children[0] = _sah_build(r_build, p_begin, mid, p_slot + 1, p_split_depth - 1);
+	node->children[1] = _sah_build(r_build, mid, p_end, p_slot + (mid - p_begin), p_split_depth - 1);
+	node->children[0]->parent = node;
+	node->children[1]->parent = node;
+	return node;
+}
+
+void DynamicBVH::_sah_build_task(void *p_userdata, uint32_t p_index) {
+	SAHBuild *build = (SAHBuild *)p_userdata;
+	const SAHBuildTask &task = build->tasks[p_index];
+	_sah_build(*build, task.begin, task.end, task.slot, -1);
+}
+
 void DynamicBVH::clear() {
 	if (bvh_root) {
 		_recurse_delete_node(bvh_root);
@@ -308,6 +427,50 @@ void DynamicBVH::optimize_top_down(int bu_threshold) {
 	}
 }
 
+// Rebuilds the whole tree with the surface area heuristic. Slower than the
+// other optimizations but gives much better trees, so it suits sets of
+// leaves that rarely change. Leaves are kept, so existing IDs stay valid.
+void DynamicBVH::optimize_sah(bool p_use_threads) {
+	if (!bvh_root || bvh_root->is_leaf()) {
+		return;
+	}
+
+	LocalVector<Node *> leaves;
+	_fetch_leaves(bvh_root, leaves);
+
+	LocalVector<Node *> internal;
+	internal.resize(leaves.size() - 1);
+	for (Node *&node : internal) {
+		node = _create_node(nullptr, nullptr);
+	}
+
+	SAHBuild build;
+	build.leaves = leaves.ptr();
+	build.internal = internal.ptr();
+
+	// Split the top of the tree serially until there are a few subtrees per thread.
+	int split_depth = -1;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_use_threads && pool && pool->get_thread_count() > 1 && WorkerThreadPool::get_thread_index() == -1 && leaves.size() >= SAH_PARALLEL_MIN_LEAVES * 2) {
+		split_depth = 1;
+		while ((1 << split_depth) < pool->get_thread_count() * 4) {
+			split_depth++;
+		}
+	}
+
+	bvh_root = _sah_build(build, 0, leaves.size(), 0, split_depth);
+	bvh_root->parent = nullptr;
+
+	if (build.tasks.size() == 1) {
+		_sah_build_task(&build, 0);
+	} else if (build.tasks.size() > 1) {
+		WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_sah_build_task, &build, build.tasks.size(), -1, true, SNAME("DynamicBVHBuild"));
+		pool->wait_for_group_task_completion(group_task);
+	}
+
+	opath = 0;
+}
+
 void DynamicBVH::optimize_incremental(int passes) {
 	if (passes < 0) {
 		passes = total_leaves;
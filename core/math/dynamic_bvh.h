@@ -246,6 +246,29 @@ private:
 	Node *_top_down(Node **leaves, int p_count, int p_bu_threshold);
 	Node *_node_sort(Node *n, Node *&r);
 
+	// Binned SAH build. Internal nodes are allocated up front so subtrees
+	// can be built from separate threads without touching the allocator.
+	enum {
+		SAH_BIN_COUNT = 16,
+		SAH_PARALLEL_MIN_LEAVES = 1024,
+	};
+
+	struct SAHBuildTask {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		uint32_t slot = 0;
+	};
+
+	struct SAHBuild {
+		Node **leaves = nullptr;
+		Node **internal = nullptr;
+		LocalVector<SAHBuildTask> tasks;
+	};
+
+	static real_t _sah_area(const Volume &p_volume);
+	static Node *_sah_build(SAHBuild &r_build, uint32_t p_begin, uint32_t p_end, uint32_t p_slot, int p_split_depth);
+	static void _sah_build_task(void *p_userdata, uint32_t p_index);
+
 	_FORCE_INLINE_ void _update(Node *leaf, int lookahead = -1);
 
 	void _extract_leaves(Node *p_node, List<ID> *r_elements);
@@ -291,6 +314,7 @@ public:
 	void optimize_bottom_up();
 	void optimize_top_down(int bu_threshold = 128);
 	void optimize_incremental(int passes);
+	void optimize_sah(bool p_use_threads = true);
 	ID insert(const AABB &p_box, void *p_userdata);
 	bool update(const ID &p_id, const AABB &p_box);
 	void remove(const ID &p_id);
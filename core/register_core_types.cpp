@@ -48,6 +48,8 @@
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
+#include "core/io/json_reader.h"
+#include "core/io/json_writer.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/io/packed_data_container.h"
@@ -247,6 +249,8 @@ void register_core_types() {
 
 	GDREGISTER_CLASS(XMLParser);
 	GDREGISTER_CLASS(JSON);
+	GDREGISTER_CLASS(JSONReader);
+	GDREGISTER_CLASS(JSONWriter);
 
 	GDREGISTER_CLASS(ConfigFile);
 
@@ -49,6 +49,14 @@
 #define snprintf _snprintf_s
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define USTRING_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define USTRING_SIMD_NEON
+#endif
+
 static const int MAX_DECIMALS = 32;
 
 static _FORCE_INLINE_ char32_t lower_case(char32_t c) {
@@ -1921,6 +1929,119 @@ CharString String::ascii(bool p_allow_extended) const {
 	return cs;
 }
 
+// Returns how many leading bytes of `p_src` are plain ASCII that can be copied as-is:
+// below 0x80, not NUL, and not '\r' when `p_skip_cr` is set.
+static _FORCE_INLINE_ int _utf8_ascii_run(const uint8_t *p_src, int p_len, bool p_skip_cr) {
+	int i = 0;
+#if defined(USTRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i cr = _mm_set1_epi8(p_skip_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, cr));
+		if (_mm_movemask_epi8(_mm_or_si128(v, special)) != 0) {
+			break;
+		}
+	}
+#elif defined(USTRING_SIMD_NEON)
+	const uint8x16_t zero = vdupq_n_u8(0);
+	const uint8x16_t cr = vdupq_n_u8(p_skip_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		const uint8x16_t special = vorrq_u8(vceqq_u8(v, zero), vceqq_u8(v, cr));
+		if (vmaxvq_u8(vorrq_u8(v, special)) >= 0x80) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		const uint8_t c = p_src[i];
+		if (c == 0 || c >= 0x80 || (p_skip_cr && c == '\r')) {
+			break;
+		}
+	}
+	return i;
+}
+
+// Widens `p_len` ASCII bytes to UTF-32.
+static _FORCE_INLINE_ void _ascii_to_utf32(const uint8_t *p_src, char32_t *p_dst, int p_len) {
+	int i = 0;
+#if defined(USTRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i lo = _mm_unpacklo_epi8(v, zero);
+		const __m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#elif defined(USTRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+		uint32_t *dst = (uint32_t *)(p_dst + i);
+		vst1q_u32(dst, vmovl_u16(vget_low_u16(lo)));
+		vst1q_u32(dst + 4, vmovl_u16(vget_high_u16(lo)));
+		vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(hi)));
+		vst1q_u32(dst + 12, vmovl_u16(vget_high_u16(hi)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = p_src[i];
+	}
+}
+
+// Returns how many leading characters of `p_src` are ASCII.
+static _FORCE_INLINE_ int _utf32_ascii_run(const char32_t *p_src, int p_len) {
+	int i = 0;
+#if defined(USTRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi32(~0x7f);
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, mask), zero)) != 0xffff) {
+			break;
+		}
+	}
+#elif defined(USTRING_SIMD_NEON)
+	for (; i + 4 <= p_len; i += 4) {
+		if (vmaxvq_u32(vld1q_u32((const uint32_t *)(p_src + i))) >= 0x80) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && p_src[i] < 0x80) {
+		i++;
+	}
+	return i;
+}
+
+// Narrows `p_len` ASCII characters to single bytes.
+static _FORCE_INLINE_ void _utf32_to_ascii(const char32_t *p_src, uint8_t *p_dst, int p_len) {
+	int i = 0;
+#if defined(USTRING_SIMD_SSE2)
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i *src = (const __m128i *)(p_src + i);
+		const __m128i ab = _mm_packs_epi32(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+		const __m128i cd = _mm_packs_epi32(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(ab, cd));
+	}
+#elif defined(USTRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint32_t *src = (const uint32_t *)(p_src + i);
+		const uint16x8_t ab = vcombine_u16(vmovn_u32(vld1q_u32(src)), vmovn_u32(vld1q_u32(src + 4)));
+		const uint16x8_t cd = vcombine_u16(vmovn_u32(vld1q_u32(src + 8)), vmovn_u32(vld1q_u32(src + 12)));
+		vst1q_u8(p_dst + i, vcombine_u8(vmovn_u16(ab), vmovn_u16(cd)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = p_src[i];
+	}
+}
+
 String String::utf8(const char *p_utf8, int p_len) {
 	String ret;
 	ret.parse_utf8(p_utf8, p_len);
@@ -1950,11 +2071,16 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		}
 	}
 
+	if (p_len < 0) {
+		// Decoding stops at the first NUL anyway, knowing the length allows reading in blocks.
+		p_len = strlen(p_utf8);
+	}
+
 	bool decode_error = false;
 	bool decode_failed = false;
 	{
 		const char *ptrtmp = p_utf8;
-		const char *ptrtmp_limit = p_len >= 0 ? &p_utf8[p_len] : nullptr;
+		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
 		uint8_t c_start = 0;
 		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
@@ -1964,6 +2090,17 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 			uint8_t c = *ptrtmp >= 0 ? *ptrtmp : uint8_t(256 + *ptrtmp);
 #endif
 
+			if (skip == 0 && c < 0x80) {
+				// Count runs of plain ASCII in bulk.
+				int ascii = _utf8_ascii_run((const uint8_t *)ptrtmp, ptrtmp_limit - ptrtmp, p_skip_cr);
+				if (ascii > 0) {
+					cstr_size += ascii;
+					str_size += ascii;
+					ptrtmp += ascii;
+					continue;
+				}
+			}
+
 			if (skip == 0) {
 				if (p_skip_cr && c == '\r') {
 					ptrtmp++;
@@ -2036,6 +2173,18 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		uint8_t c = *p_utf8 >= 0 ? *p_utf8 : uint8_t(256 + *p_utf8);
 #endif
 
+		if (skip == 0 && c < 0x80) {
+			// Copy runs of plain ASCII in bulk.
+			int ascii = _utf8_ascii_run((const uint8_t *)p_utf8, cstr_size, p_skip_cr);
+			if (ascii > 0) {
+				_ascii_to_utf32((const uint8_t *)p_utf8, dst, ascii);
+				dst += ascii;
+				p_utf8 += ascii;
+				cstr_size -= ascii;
+				continue;
+			}
+		}
+
 		if (skip == 0) {
 			if (p_skip_cr && c == '\r') {
 				p_utf8++;
@@ -2119,7 +2268,10 @@ CharString String::utf8() const {
 	for (int i = 0; i < l; i++) {
 		uint32_t c = d[i];
 		if (c <= 0x7f) { // 7 bits.
-			fl += 1;
+			// Count runs of ASCII in bulk.
+			int ascii = _utf32_ascii_run(d + i, l - i);
+			fl += ascii;
+			i += ascii - 1;
 		} else if (c <= 0x7ff) { // 11 bits
 			fl += 2;
 		} else if (c <= 0xffff) { // 16 bits
@@ -2152,7 +2304,11 @@ CharString String::utf8() const {
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
-			APPEND_CHAR(c);
+			// Copy runs of ASCII in bulk.
+			int ascii = _utf32_ascii_run(d + i, l - i);
+			_utf32_to_ascii(d + i, cdst, ascii);
+			cdst += ascii;
+			i += ascii - 1;
 		} else if (c <= 0x7ff) { // 11 bits
 			APPEND_CHAR(uint32_t(0xc0 | ((c >> 6) & 0x1f))); // Top 5 bits.
 			APPEND_CHAR(uint32_t(0x80 | (c & 0x3f))); // Bottom 6 bits.
@@ -35,4 +35,23 @@ CommandQueueMT::CommandQueueMT() {
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	// Commands that were never flushed are destroyed without being run, so the arguments they hold are released.
+	uint64_t read_pos = ring_read_pos.load(std::memory_order_relaxed);
+	const uint64_t write_pos = ring_write_pos.load(std::memory_order_acquire);
+	while (read_pos != write_pos) {
+		const uint64_t offset = read_pos & (ring_mem.size() - 1);
+		const RingHeader *header = reinterpret_cast<RingHeader *>(ring_mem.ptr() + offset);
+		if (!header->skip) {
+			reinterpret_cast<CommandBase *>(ring_mem.ptr() + offset + sizeof(RingHeader))->~CommandBase();
+		}
+		read_pos += header->size;
+	}
+
+	uint64_t read_ptr = flush_read_ptr;
+	while (read_ptr < command_mem.size()) {
+		uint64_t size = reinterpret_cast<CommandHeader *>(&command_mem[read_ptr])->size;
+		read_ptr += sizeof(CommandHeader);
+		reinterpret_cast<CommandBase *>(&command_mem[read_ptr])->~CommandBase();
+		read_ptr += size;
+	}
 }
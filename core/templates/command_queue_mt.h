@@ -34,9 +34,12 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
+#include "core/templates/vector.h"
 #include "core/typedefs.h"
 
 class CommandQueueMT {
@@ -102,9 +105,47 @@ class CommandQueueMT {
 		_FORCE_INLINE_ auto &get() { return ::tuple_get<I>(args); }
 	};
 
+	// Calls the method once per element of the argument arrays, so a batch of updates costs a single
+	// enqueue. The arrays are copy-on-write, so pushing the command only takes a reference to them.
+	template <typename T, typename M, typename... Args>
+	struct CommandBatch : public CommandBase {
+		T *instance;
+		M method;
+		Tuple<Vector<Args>...> args;
+
+		_FORCE_INLINE_ CommandBatch(T *p_instance, M p_method, const Vector<Args> &...p_args) :
+				CommandBase(false), instance(p_instance), method(p_method), args(p_args...) {}
+
+		void call() override {
+			const int count = ::tuple_get<0>(args).size();
+			for (int i = 0; i < count; i++) {
+				call_impl(i, BuildIndexSequence<sizeof...(Args)>{});
+			}
+		}
+
+	private:
+		template <size_t... I>
+		_FORCE_INLINE_ void call_impl(int p_index, IndexSequence<I...>) {
+			(instance->*method)(::tuple_get<I>(args)[p_index]...);
+		}
+	};
+
 	/***** BASE *******/
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t PRODUCER_RING_SIZE_KB = 256;
+	static const uint32_t PRODUCER_RING_SPIN_ITERATIONS = 2048;
+
+	struct CommandHeader {
+		uint64_t size;
+		// Producer ring position at the time of the push. The command runs after every ring command before it.
+		uint64_t ring_pos;
+	};
+
+	struct RingHeader {
+		uint32_t size;
+		uint32_t skip; // Filler up to the end of the ring, there's no command to call.
+	};
 
 	BinaryMutex mutex;
 	LocalVector<uint8_t> command_mem;
@@ -115,6 +156,16 @@ class CommandQueueMT {
 	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
 	uint64_t flush_read_ptr = 0;
 
+	// Single producer, single consumer ring the producer thread pushes to without locking.
+	// Positions are monotonic byte offsets; the consumer is whoever flushes while holding the mutex.
+	// Each position sits on its own cache line so the two threads don't invalidate each other.
+	LocalVector<uint8_t> ring_mem;
+	Thread::ID ring_producer = Thread::UNASSIGNED_ID;
+	bool ring_flushing = false;
+	alignas(64) std::atomic<uint64_t> ring_write_pos = { 0 };
+	alignas(64) std::atomic<uint64_t> ring_read_pos = { 0 };
+	alignas(64) std::atomic<bool> ring_consumer_idle = { false };
+
 	template <typename T, typename... Args>
 	_FORCE_INLINE_ void create_command(Args &&...p_args) {
 		// alloc size is size+T+safeguard
@@ -122,14 +173,59 @@ class CommandQueueMT {
 		static_assert(alloc_size < UINT32_MAX, "Type too large to fit in the command queue.");
 
 		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + sizeof(uint64_t));
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		void *cmd = &command_mem[size + sizeof(uint64_t)];
+		command_mem.resize(size + alloc_size + sizeof(CommandHeader));
+		CommandHeader *header = reinterpret_cast<CommandHeader *>(&command_mem[size]);
+		header->size = alloc_size;
+		header->ring_pos = ring_write_pos.load(std::memory_order_acquire);
+		void *cmd = &command_mem[size + sizeof(CommandHeader)];
 		new (cmd) T(std::forward<Args>(p_args)...);
 	}
 
+	template <typename T, typename... Args>
+	_FORCE_INLINE_ bool _push_ring(Args &&...p_args) {
+		constexpr uint64_t entry_size = sizeof(RingHeader) + ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
+		const uint64_t capacity = ring_mem.size();
+
+		uint64_t write_pos = ring_write_pos.load(std::memory_order_relaxed);
+		uint64_t offset = write_pos & (capacity - 1);
+		// Commands are never split across the end of the ring.
+		const uint64_t skip = offset + entry_size > capacity ? capacity - offset : 0;
+		if (write_pos + skip + entry_size - ring_read_pos.load(std::memory_order_acquire) > capacity) {
+			// Full, the caller falls back to the locked buffer.
+			return false;
+		}
+
+		if (skip) {
+			RingHeader *filler = reinterpret_cast<RingHeader *>(ring_mem.ptr() + offset);
+			filler->size = skip;
+			filler->skip = true;
+			write_pos += skip;
+			offset = 0;
+		}
+
+		RingHeader *header = reinterpret_cast<RingHeader *>(ring_mem.ptr() + offset);
+		header->size = entry_size;
+		header->skip = false;
+		new (ring_mem.ptr() + offset + sizeof(RingHeader)) T(std::forward<Args>(p_args)...);
+
+		// Sequentially consistent so the idle check can't be reordered before publishing, see wait_for_pending().
+		ring_write_pos.store(write_pos + entry_size, std::memory_order_seq_cst);
+		if (ring_consumer_idle.load(std::memory_order_seq_cst)) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
+		}
+		return true;
+	}
+
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
+		if constexpr (!NeedsSync) {
+			if (ring_producer != Thread::UNASSIGNED_ID && Thread::get_caller_id() == ring_producer) {
+				if (likely(_push_ring<T>(std::forward<Args>(args)...))) {
+					return;
+				}
+			}
+		}
+
 		MutexLock mlock(mutex);
 		create_command<T>(std::forward<Args>(args)...);
 
@@ -143,6 +239,10 @@ class CommandQueueMT {
 		}
 	}
 
+	_FORCE_INLINE_ bool _is_ring_pending() const {
+		return ring_write_pos.load(std::memory_order_acquire) != ring_read_pos.load(std::memory_order_relaxed);
+	}
+
 	_FORCE_INLINE_ void _prevent_sync_wraparound() {
 		bool safe_to_reset = !sync_awaiters;
 		bool already_sync_to_latest = sync_head == sync_tail;
@@ -152,17 +252,55 @@ class CommandQueueMT {
 		}
 	}
 
+	void _flush_ring_command(MutexLock<BinaryMutex> &p_lock, uint64_t p_read_pos) {
+		const uint64_t offset = p_read_pos & (ring_mem.size() - 1);
+		const RingHeader *header = reinterpret_cast<RingHeader *>(ring_mem.ptr() + offset);
+		const uint64_t size = header->size;
+
+		if (!header->skip) {
+			// Ring memory is never reallocated, so the command stays put while it runs.
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(ring_mem.ptr() + offset + sizeof(RingHeader));
+			ring_flushing = true;
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(p_lock);
+			cmd->call();
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+			ring_flushing = false;
+			cmd->~CommandBase();
+		}
+
+		// Hand the memory back to the producer.
+		ring_read_pos.store(p_read_pos + size, std::memory_order_release);
+	}
+
 	void _flush() {
-		if (unlikely(flush_read_ptr)) {
+		if (unlikely(flush_read_ptr || ring_flushing)) {
 			// Re-entrant call.
 			return;
 		}
 
 		MutexLock lock(mutex);
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
+		while (true) {
+			const bool has_command = flush_read_ptr < command_mem.size();
+
+			if (!ring_mem.is_empty()) {
+				// Locked commands were pushed after every ring command before their ring_pos, so those run first.
+				// A ring_pos past the read position is always published already, as it was read before the push.
+				const uint64_t read_pos = ring_read_pos.load(std::memory_order_relaxed);
+				if (!has_command || reinterpret_cast<CommandHeader *>(&command_mem[flush_read_ptr])->ring_pos > read_pos) {
+					if (read_pos != ring_write_pos.load(std::memory_order_acquire)) {
+						_flush_ring_command(lock, read_pos);
+						continue;
+					}
+				}
+			}
+
+			if (!has_command) {
+				break;
+			}
+
+			uint64_t size = reinterpret_cast<CommandHeader *>(&command_mem[flush_read_ptr])->size;
+			flush_read_ptr += sizeof(CommandHeader);
 			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
 			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
 			cmd->call();
@@ -225,8 +363,16 @@ public:
 		_push_internal<CommandType, true>(p_instance, p_method, r_ret, std::forward<Args>(p_args)...);
 	}
 
+	template <typename T, typename M, typename... Args>
+	void push_batch(T *p_instance, M p_method, const Vector<Args> &...p_args) {
+		// One command calling the method for every element, no sync. All arrays must have the same size.
+		static_assert(sizeof...(Args) > 0, "Batched commands need at least one argument array.");
+		using CommandType = CommandBatch<T, M, Args...>;
+		_push_internal<CommandType, false>(p_instance, p_method, p_args...);
+	}
+
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(command_mem.size() > 0 || _is_ring_pending())) {
 			_flush();
 		}
 	}
@@ -250,6 +396,42 @@ public:
 		pump_task_id = p_task_id;
 	}
 
+	// Lets p_producer push commands that don't sync through a lock-free ring instead of the mutex, e.g. the main
+	// thread feeding a server thread. Other threads keep using the locked buffer, and flushing replays both in
+	// submission order. Must be called before p_producer pushes anything.
+	void set_producer_thread(Thread::ID p_producer) {
+		MutexLock lock(mutex);
+		ERR_FAIL_COND_MSG(_is_ring_pending(), "Can't change the producer thread while it has commands pending.");
+		if (ring_mem.is_empty()) {
+			ring_mem.resize(PRODUCER_RING_SIZE_KB * 1024);
+		}
+		ring_producer = p_producer;
+	}
+
+	// Returns once there may be commands to flush. Meant for the pump task: when a producer ring is in use it
+	// busy-waits for a short while first, so a steady stream of commands is picked up without going through
+	// the WorkerThreadPool to wake up.
+	void wait_for_pending() {
+		if (ring_mem.is_empty()) {
+			WorkerThreadPool::get_singleton()->yield();
+			return;
+		}
+
+		for (uint32_t i = 0; i < PRODUCER_RING_SPIN_ITERATIONS; i++) {
+			if (_is_ring_pending()) {
+				return;
+			}
+			_cpu_pause();
+		}
+
+		// Pairs with the producer publishing before checking this flag, so one of the two always notices the other.
+		ring_consumer_idle.store(true, std::memory_order_seq_cst);
+		if (ring_write_pos.load(std::memory_order_seq_cst) == ring_read_pos.load(std::memory_order_relaxed)) {
+			WorkerThreadPool::get_singleton()->yield();
+		}
+		ring_consumer_idle.store(false, std::memory_order_relaxed);
+	}
+
 	CommandQueueMT();
 	~CommandQueueMT();
 };
@@ -45,6 +45,8 @@ public:
 		uint32_t readahead_filled = 0;
 		bool eof = false;
 
+		char32_t _refill_and_get_char();
+
 	protected:
 		bool readahead_enabled = true;
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
@@ -53,7 +55,13 @@ public:
 	public:
 		char32_t saved = 0;
 
-		char32_t get_char();
+		_FORCE_INLINE_ char32_t get_char() {
+			// is within buffer?
+			if (readahead_pointer < readahead_filled) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _refill_and_get_char();
+		}
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
@@ -61,6 +69,8 @@ public:
 		virtual ~Stream() {}
 	};
 
+	// Hands the file's raw UTF-8 bytes to the tokenizer in READAHEAD_SIZE chunks, one byte per char32_t;
+	// is_utf8() tells get_token() to decode string tokens from those bytes.
 	struct StreamFile : public Stream {
 	protected:
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) override;
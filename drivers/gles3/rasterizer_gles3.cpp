@@ -350,6 +350,7 @@ RasterizerGLES3::RasterizerGLES3() {
 
 				if (!shader_cache_dir.is_empty()) {
 					ShaderGLES3::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_shader_cache_dir(shader_cache_dir.path_join("compiler"));
 				}
 			}
 		}
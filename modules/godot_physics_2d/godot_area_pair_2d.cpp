@@ -91,6 +91,10 @@ void GodotAreaPair2D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint2D::SortKey GodotAreaPair2D::get_sort_key() const {
+	return make_sort_key(body->get_self(), body_shape, area->get_self(), area_shape);
+}
+
 GodotAreaPair2D::GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotArea2D *p_area, int p_area_shape) {
 	body = p_body;
 	area = p_area;
@@ -174,6 +178,10 @@ void GodotArea2Pair2D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint2D::SortKey GodotArea2Pair2D::get_sort_key() const {
+	return make_sort_key(area_a->get_self(), shape_a, area_b->get_self(), shape_b);
+}
+
 GodotArea2Pair2D::GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotArea2D *p_area_b, int p_shape_b) {
 	area_a = p_area_a;
 	area_b = p_area_b;
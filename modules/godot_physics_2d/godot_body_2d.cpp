@@ -389,6 +389,41 @@ Variant GodotBody2D::get_state(PhysicsServer2D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody2D::save_state(State &r_state) const {
+	r_state.rid = get_self().get_id();
+	r_state.transform = get_transform();
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody2D::restore_state(const State &p_state) {
+	// Unlike setting BODY_STATE_TRANSFORM, this neither wakes up neighbors nor starts a kinematic motion.
+	_set_transform(p_state.transform);
+	_set_inv_transform(get_transform().affine_inverse());
+	_update_transform_dependent();
+	new_transform = get_transform();
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+
+	set_active(p_state.active);
+}
+
 void GodotBody2D::set_space(GodotSpace2D *p_space) {
 	if (get_space()) {
 		wakeup_neighbours();
@@ -606,12 +641,20 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		integration_moved_shapes = true;
 	}
 
 	contact_count = 0;
 }
 
+void GodotBody2D::finish_integrate_forces() {
+	if (integration_moved_shapes) {
+		integration_moved_shapes = false;
+		_update_shapes_broadphase();
+	}
+}
+
 void GodotBody2D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
 		return;
@@ -619,15 +662,11 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
+			integration_stopped = true; //stopped moving, deactivate
 		}
 		return;
 	}
@@ -644,7 +683,11 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
+	if (continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED) {
+		_update_shapes(false);
+		integration_moved_shapes = true;
+	}
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -654,6 +697,26 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody2D::finish_integrate_velocities() {
+	if (mode == PhysicsServer2D::BODY_MODE_STATIC || !get_space()) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (integration_moved_shapes) {
+		integration_moved_shapes = false;
+		_update_shapes_broadphase();
+	}
+
+	if (integration_stopped) {
+		integration_stopped = false;
+		set_active(false);
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -100,6 +100,10 @@ class GodotBody2D : public GodotCollisionObject2D {
 	PhysicsServer2D::CCDMode continuous_cd_mode = PhysicsServer2D::CCD_MODE_DISABLED;
 	bool omit_force_integration = false;
 	bool active = true;
+
+	// Space updates left by integrate_forces() and integrate_velocities() for the finish_* methods.
+	bool integration_moved_shapes = false;
+	bool integration_stopped = false;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 	void _mass_properties_changed();
@@ -300,6 +304,25 @@ public:
 	void set_state(PhysicsServer2D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer2D::BodyState p_state) const;
 
+	// Everything the simulation changes between steps, copied as is by GodotSpace2D::save_state().
+	struct State {
+		uint64_t rid = 0;
+		Transform2D transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		Vector2 constant_force;
+		real_t constant_torque = 0.0;
+		real_t still_time = 0.0;
+		uint32_t active = 0;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection_mode(PhysicsServer2D::CCDMode p_mode) { continuous_cd_mode = p_mode; }
 	_FORCE_INLINE_ PhysicsServer2D::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
 
@@ -315,8 +338,12 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Integration only touches this body, so different bodies can be integrated on different threads. The space is
+	// updated afterwards by calling the matching finish_* method on the physics thread, in a deterministic order.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
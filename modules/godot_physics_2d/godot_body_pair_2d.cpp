@@ -593,6 +593,43 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint2D::SortKey GodotBodyPair2D::get_sort_key() const {
+	return make_sort_key(A->get_self(), shape_A, B->get_self(), shape_B);
+}
+
+void GodotBodyPair2D::save_state(State &r_state) const {
+	r_state.body_A = A->get_self().get_id();
+	r_state.body_B = B->get_self().get_id();
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+	r_state.sep_axis = sep_axis;
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+}
+
+bool GodotBodyPair2D::matches_state(const State &p_state) const {
+	// Contacts are stored relative to A, so the pair must not have been recreated the other way around.
+	return p_state.body_A == A->get_self().get_id() && p_state.body_B == B->get_self().get_id() && p_state.shape_A == shape_A && p_state.shape_B == shape_B;
+}
+
+void GodotBodyPair2D::restore_state(const State &p_state) {
+	sep_axis = p_state.sep_axis;
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	contact_count = CLAMP(p_state.contact_count, 0, (int32_t)MAX_CONTACTS);
+	collided = p_state.collided;
+}
+
+void GodotBodyPair2D::clear_state() {
+	sep_axis = Vector2();
+	contact_count = 0;
+	collided = false;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
@@ -157,7 +157,7 @@ void GodotCollisionObject2D::_unregister_shapes() {
 	}
 }
 
-void GodotCollisionObject2D::_update_shapes() {
+void GodotCollisionObject2D::_update_shapes(bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -175,6 +175,10 @@ void GodotCollisionObject2D::_update_shapes() {
 		shape_aabb.grow_by((s.aabb_cache.size.x + s.aabb_cache.size.y) * 0.5 * 0.05);
 		s.aabb_cache = shape_aabb;
 
+		if (!p_update_broadphase) {
+			continue;
+		}
+
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
@@ -184,7 +188,7 @@ void GodotCollisionObject2D::_update_shapes() {
 	}
 }
 
-void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
+void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion, bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -202,6 +206,10 @@ void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion)
 		shape_aabb = shape_aabb.merge(Rect2(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
 
+		if (!p_update_broadphase) {
+			continue;
+		}
+
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
@@ -211,6 +219,26 @@ void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion)
 	}
 }
 
+void GodotCollisionObject2D::_update_shapes_broadphase() {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
+
+		if (s.bpid == 0) {
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
+			space->get_broadphase()->set_static(s.bpid, _static);
+		}
+
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject2D::_set_space(GodotSpace2D *p_space) {
 	GodotSpace2D *old_space = space;
 	space = p_space;
@@ -75,10 +75,12 @@ private:
 
 	SelfList<GodotCollisionObject2D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
-	void _update_shapes_with_motion(const Vector2 &p_motion);
+	// Without p_update_broadphase, only the cached shape AABBs are updated, which is safe to do on any thread.
+	// _update_shapes_broadphase() then moves the shapes to them.
+	void _update_shapes(bool p_update_broadphase = true);
+	void _update_shapes_with_motion(const Vector2 &p_motion, bool p_update_broadphase = true);
+	void _update_shapes_broadphase();
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
@@ -99,6 +101,11 @@ public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
+	// RIDs increase as objects are created, so this orders objects by creation.
+	struct SelfComparator {
+		_FORCE_INLINE_ bool operator()(const GodotCollisionObject2D *p_a, const GodotCollisionObject2D *p_b) const { return p_a->get_self() < p_b->get_self(); }
+	};
+
 	_FORCE_INLINE_ void set_instance_id(const ObjectID &p_instance_id) { instance_id = p_instance_id; }
 	_FORCE_INLINE_ ObjectID get_instance_id() const { return instance_id; }
 
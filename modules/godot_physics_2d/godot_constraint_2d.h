@@ -60,6 +60,56 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Identifies a constraint by the objects it connects rather than by when it was created,
+	// deterministic stepping sorts islands by it.
+	struct SortKey {
+		uint64_t ids[2] = {};
+		int sub_indices[2] = {};
+
+		_FORCE_INLINE_ bool operator<(const SortKey &p_other) const {
+			if (ids[0] != p_other.ids[0]) {
+				return ids[0] < p_other.ids[0];
+			}
+			if (ids[1] != p_other.ids[1]) {
+				return ids[1] < p_other.ids[1];
+			}
+			if (sub_indices[0] != p_other.sub_indices[0]) {
+				return sub_indices[0] < p_other.sub_indices[0];
+			}
+			return sub_indices[1] < p_other.sub_indices[1];
+		}
+	};
+
+	struct SortComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const { return p_a->get_sort_key() < p_b->get_sort_key(); }
+	};
+
+	static _FORCE_INLINE_ SortKey make_sort_key(const RID &p_a, int p_sub_index_a, const RID &p_b, int p_sub_index_b) {
+		SortKey key;
+		if (p_b < p_a || (p_a == p_b && p_sub_index_b < p_sub_index_a)) {
+			key.ids[0] = p_b.get_id();
+			key.ids[1] = p_a.get_id();
+			key.sub_indices[0] = p_sub_index_b;
+			key.sub_indices[1] = p_sub_index_a;
+		} else {
+			key.ids[0] = p_a.get_id();
+			key.ids[1] = p_b.get_id();
+			key.sub_indices[0] = p_sub_index_a;
+			key.sub_indices[1] = p_sub_index_b;
+		}
+		return key;
+	}
+
+	// Joints are keyed by their own RID, pairs override this with the RIDs of both objects.
+	virtual SortKey get_sort_key() const {
+		SortKey key;
+		key.ids[0] = self.get_id();
+		return key;
+	}
+
+	// Body pairs keep contacts between steps, which are saved with the space state.
+	virtual bool is_body_pair() const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -115,6 +115,9 @@ public:
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
+	virtual uint64_t space_get_state_hash(RID p_space) const override;
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) override;
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
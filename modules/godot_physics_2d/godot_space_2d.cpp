@@ -34,6 +34,7 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
 
@@ -56,29 +57,25 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
-
+int GodotPhysicsDirectSpaceState2D::_intersect_point(const PointParameters &p_parameters, const Vector2 &p_position, ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const {
 	Rect2 aabb;
-	aabb.position = p_parameters.position - Vector2(0.00001, 0.00001);
+	aabb.position = p_position - Vector2(0.00001, 0.00001);
 	aabb.size = Vector2(0.00002, 0.00002);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	int cc = 0;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
 
 		if (p_parameters.pick_point && !col_obj->is_pickable()) {
 			continue;
@@ -88,11 +85,11 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 			continue;
 		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		GodotShape2D *shape = col_obj->get_shape(shape_idx);
 
-		Vector2 local_point = (col_obj->get_transform() * col_obj->get_shape_transform(shape_idx)).affine_inverse().xform(p_parameters.position);
+		Vector2 local_point = (col_obj->get_transform() * col_obj->get_shape_transform(shape_idx)).affine_inverse().xform(p_position);
 
 		if (!shape->contains_point(local_point)) {
 			continue;
@@ -115,16 +112,22 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
 
+	return _intersect_point(p_parameters, p_parameters.position, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const {
 	Vector2 begin, end;
 	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -135,17 +138,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -205,6 +208,11 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -254,39 +262,36 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
-	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
-
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
+void GodotPhysicsDirectSpaceState2D::_cast_motion(GodotShape2D *p_shape, const ShapeParameters &p_parameters, const Transform2D &p_transform, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const {
+	Rect2 aabb = p_transform.xform(p_shape->get_aabb());
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver2D::solve(p_shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
@@ -300,7 +305,7 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+			bool collided = GodotCollisionSolver2D::solve(p_shape, p_transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
 
 			if (collided) {
 				hi = fraction;
@@ -333,7 +338,13 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
 
+	_cast_motion(shape, p_parameters, p_parameters.transform, p_closest_safe, p_closest_unsafe, space->intersection_query_results, space->intersection_query_subindex_results);
 	return true;
 }
 
@@ -501,6 +512,125 @@ bool GodotPhysicsDirectSpaceState2D::rest_info(const ShapeParameters &p_paramete
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState2D::_intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	LocalVector<GodotCollisionObject2D *> cull_results;
+	cull_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	int from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		p_batch->hits[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], p_batch->results[i], cull_results.ptr(), cull_subindices.ptr());
+	}
+}
+
+void GodotPhysicsDirectSpaceState2D::_intersect_points_chunk(uint32_t p_chunk, PointBatch *p_batch) {
+	LocalVector<GodotCollisionObject2D *> cull_results;
+	cull_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	int from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		p_batch->hits[i] = _intersect_point(*p_batch->parameters, p_batch->points[i], &p_batch->results[i], 1, cull_results.ptr(), cull_subindices.ptr()) > 0;
+	}
+}
+
+void GodotPhysicsDirectSpaceState2D::_cast_motions_chunk(uint32_t p_chunk, MotionBatch *p_batch) {
+	LocalVector<GodotCollisionObject2D *> cull_results;
+	cull_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	ShapeParameters parameters = *p_batch->parameters;
+
+	int from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		Transform2D transform = parameters.transform;
+		transform.set_origin(p_batch->origins[i]);
+		parameters.motion = p_batch->motions[i];
+		_cast_motion(p_batch->shape, parameters, transform, p_batch->closest_safe[i], p_batch->closest_unsafe[i], cull_results.ptr(), cull_subindices.ptr());
+	}
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_intersect_rays_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_rays_chunk, &batch, chunk_count, -1, true, SNAME("Physics2DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_points(const PointParameters &p_parameters, const Vector2 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) {
+	PointBatch batch;
+	batch.parameters = &p_parameters;
+	batch.points = p_points;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_intersect_points_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_points_chunk, &batch, chunk_count, -1, true, SNAME("Physics2DIntersectPoints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	ERR_FAIL_COND(space->locked);
+
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	MotionBatch batch;
+	batch.shape = shape;
+	batch.parameters = &p_parameters;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.count = p_count;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_cast_motions_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_cast_motions_chunk, &batch, chunk_count, -1, true, SNAME("Physics2DCastMotions"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 int GodotSpace2D::_cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb) {
@@ -1216,11 +1346,167 @@ GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
 
+static _FORCE_INLINE_ uint64_t _hash_real(real_t p_value, uint64_t p_hash) {
+	return hash64_murmur3_64(hash_make_uint64_t(p_value), p_hash);
+}
+
+static _FORCE_INLINE_ uint64_t _hash_vector2(const Vector2 &p_value, uint64_t p_hash) {
+	p_hash = _hash_real(p_value.x, p_hash);
+	return _hash_real(p_value.y, p_hash);
+}
+
+uint64_t GodotSpace2D::get_state_hash() const {
+	LocalVector<const GodotCollisionObject2D *> sorted_objects;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			sorted_objects.push_back(object);
+		}
+	}
+	sorted_objects.sort_custom<GodotCollisionObject2D::SelfComparator>();
+
+	// Only the order of the RIDs is used, their values differ between processes.
+	uint64_t hash = HASH_MURMUR3_SEED;
+	for (const GodotCollisionObject2D *object : sorted_objects) {
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+		const Transform2D &transform = body->get_transform();
+		hash = _hash_vector2(transform.columns[0], hash);
+		hash = _hash_vector2(transform.columns[1], hash);
+		hash = _hash_vector2(transform.columns[2], hash);
+		hash = _hash_vector2(body->get_linear_velocity(), hash);
+		hash = _hash_real(body->get_angular_velocity(), hash);
+		hash = hash64_murmur3_64(body->is_active(), hash);
+	}
+
+	return hash;
+}
+
+// Saved states are a header followed by body and pair records, each copied as is from memory.
+// They can only be restored by the same build in the same process, since bodies are found by RID.
+struct SpaceStateHeader2D {
+	uint32_t magic = 0x32535047; // "GPS2"
+	uint32_t body_state_size = sizeof(GodotBody2D::State);
+	uint32_t pair_state_size = sizeof(GodotBodyPair2D::State);
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+Vector<uint8_t> GodotSpace2D::save_state() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Can't save the state of a space while it's being stepped.");
+
+	LocalVector<const GodotBody2D *> bodies;
+	LocalVector<const GodotBodyPair2D *> pairs;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+		bodies.push_back(body);
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			// Pairs are listed by both bodies, only save them once from A.
+			if (E.second == 0 && E.first->is_body_pair()) {
+				pairs.push_back(static_cast<const GodotBodyPair2D *>(E.first));
+			}
+		}
+	}
+
+	SpaceStateHeader2D header;
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(SpaceStateHeader2D) + bodies.size() * sizeof(GodotBody2D::State) + pairs.size() * sizeof(GodotBodyPair2D::State));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(SpaceStateHeader2D));
+	w += sizeof(SpaceStateHeader2D);
+
+	for (const GodotBody2D *body : bodies) {
+		GodotBody2D::State body_state;
+		body->save_state(body_state);
+		memcpy(w, &body_state, sizeof(GodotBody2D::State));
+		w += sizeof(GodotBody2D::State);
+	}
+
+	for (const GodotBodyPair2D *pair : pairs) {
+		GodotBodyPair2D::State pair_state;
+		pair->save_state(pair_state);
+		memcpy(w, &pair_state, sizeof(GodotBodyPair2D::State));
+		w += sizeof(GodotBodyPair2D::State);
+	}
+
+	return state;
+}
+
+void GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_MSG(locked, "Can't restore the state of a space while it's being stepped.");
+	ERR_FAIL_COND_MSG(p_state.size() < (int64_t)sizeof(SpaceStateHeader2D), "Invalid physics space state.");
+
+	const SpaceStateHeader2D expected_header;
+	SpaceStateHeader2D header;
+	const uint8_t *r = p_state.ptr();
+	memcpy(&header, r, sizeof(SpaceStateHeader2D));
+	r += sizeof(SpaceStateHeader2D);
+
+	ERR_FAIL_COND_MSG(header.magic != expected_header.magic || header.body_state_size != expected_header.body_state_size || header.pair_state_size != expected_header.pair_state_size, "Physics space state was saved by a different physics engine or build.");
+	ERR_FAIL_COND_MSG((uint64_t)p_state.size() != sizeof(SpaceStateHeader2D) + (uint64_t)header.body_count * sizeof(GodotBody2D::State) + (uint64_t)header.pair_count * sizeof(GodotBodyPair2D::State), "Invalid physics space state.");
+
+	HashMap<uint64_t, GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.insert(object->get_self().get_id(), static_cast<GodotBody2D *>(object));
+		}
+	}
+
+	// Bodies created after the state was saved are left as they are.
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		GodotBody2D::State body_state;
+		memcpy(&body_state, r, sizeof(GodotBody2D::State));
+		r += sizeof(GodotBody2D::State);
+
+		GodotBody2D **body = bodies.getptr(body_state.rid);
+		if (body) {
+			(*body)->restore_state(body_state);
+		}
+	}
+
+	// Create the pairs of the restored positions now, so their contacts can be restored too.
+	broadphase->update();
+
+	for (const KeyValue<uint64_t, GodotBody2D *> &KV : bodies) {
+		for (const Pair<GodotConstraint2D *, int> &E : KV.value->get_constraint_list()) {
+			if (E.second == 0 && E.first->is_body_pair()) {
+				static_cast<GodotBodyPair2D *>(E.first)->clear_state();
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		GodotBodyPair2D::State pair_state;
+		memcpy(&pair_state, r, sizeof(GodotBodyPair2D::State));
+		r += sizeof(GodotBodyPair2D::State);
+
+		GodotBody2D **body = bodies.getptr(pair_state.body_A);
+		if (!body) {
+			continue;
+		}
+		for (const Pair<GodotConstraint2D *, int> &E : (*body)->get_constraint_list()) {
+			if (E.second == 0 && E.first->is_body_pair()) {
+				GodotBodyPair2D *pair = static_cast<GodotBodyPair2D *>(E.first);
+				if (pair->matches_state(pair_state)) {
+					pair->restore_state(pair_state);
+					break;
+				}
+			}
+		}
+	}
+}
+
 GodotSpace2D::GodotSpace2D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/2d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/2d/solver/solver_iterations");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
 	contact_recycle_radius = GLOBAL_GET("physics/2d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/2d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
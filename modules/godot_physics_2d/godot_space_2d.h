@@ -41,6 +41,44 @@
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	// Batched queries run in chunks on the WorkerThreadPool, each chunk culling into its own buffers.
+	static constexpr int QUERY_BATCH_CHUNK_SIZE = 32;
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector2 *from = nullptr;
+		const Vector2 *to = nullptr;
+		int count = 0;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct PointBatch {
+		const PointParameters *parameters = nullptr;
+		const Vector2 *points = nullptr;
+		int count = 0;
+		ShapeResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct MotionBatch {
+		GodotShape2D *shape = nullptr;
+		const ShapeParameters *parameters = nullptr;
+		const Vector2 *origins = nullptr;
+		const Vector2 *motions = nullptr;
+		int count = 0;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	int _intersect_point(const PointParameters &p_parameters, const Vector2 &p_position, ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const;
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const;
+	void _cast_motion(GodotShape2D *p_shape, const ShapeParameters &p_parameters, const Transform2D &p_transform, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const;
+
+	void _intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch);
+	void _intersect_points_chunk(uint32_t p_chunk, PointBatch *p_batch);
+	void _cast_motions_chunk(uint32_t p_chunk, MotionBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
@@ -51,6 +89,10 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector2 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState2D() {}
 };
 
@@ -93,6 +135,7 @@ private:
 	GodotArea2D *area = nullptr;
 
 	int solver_iterations = 0;
+	bool deterministic = false;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -155,6 +198,7 @@ public:
 	const HashSet<GodotCollisionObject2D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
@@ -186,6 +230,11 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	uint64_t get_state_hash() const;
+
+	Vector<uint8_t> save_state() const;
+	void restore_state(const Vector<uint8_t> &p_state);
+
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
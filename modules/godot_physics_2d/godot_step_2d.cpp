@@ -39,6 +39,8 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+// Below this many active bodies, integration is cheaper than dispatching it to the thread pool.
+#define INTEGRATE_THREADED_MIN_BODIES 64
 
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -73,6 +75,26 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 	}
 }
 
+void GodotStep2D::_gather_active_bodies(const SelfList<GodotBody2D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+	if (deterministic) {
+		active_bodies.sort_custom<GodotCollisionObject2D::SelfComparator>();
+	}
+}
+
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -135,6 +157,9 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	// Bodies are visited in RID order instead of activation order, and constraints are sorted
+	// within each island, so results only depend on the order objects were created in.
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
@@ -143,13 +168,22 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(body_list);
+	int active_count = active_bodies.size();
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task;
+	if (active_bodies.size() >= INTEGRATE_THREADED_MIN_BODIES) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateForces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < active_bodies.size(); i++) {
+			_integrate_forces(i);
+		}
+	}
+
+	// The broadphase isn't thread-safe, update it in gathered order so pairs are always found in the same order.
+	for (GodotBody2D *body : active_bodies) {
+		body->finish_integrate_forces();
 	}
 
 	p_space->set_active_objects(active_count);
@@ -176,30 +210,37 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 				continue;
 			}
 			constraint->set_island_step(_step);
+			area_constraints.push_back(constraint);
+		}
+		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
+	}
 
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
+	if (deterministic) {
+		area_constraints.sort_custom<GodotConstraint2D::SortComparator>();
+	}
 
-			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
+	for (GodotConstraint2D *constraint : area_constraints) {
+		// Each constraint can be on a separate island for areas as there's no solving phase.
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
 		}
-		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
+		LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+
+		all_constraints.push_back(constraint);
+		constraint_island.push_back(constraint);
 	}
+	area_constraints.clear();
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	// Bodies may have been woken up by new pairs.
+	_gather_active_bodies(body_list);
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
-
+	for (GodotBody2D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -225,9 +266,10 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				constraint_island.sort_custom<GodotConstraint2D::SortComparator>();
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -241,7 +283,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -272,11 +314,20 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	_gather_active_bodies(body_list);
+
+	if (active_bodies.size() >= INTEGRATE_THREADED_MIN_BODIES) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateVelocities"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < active_bodies.size(); i++) {
+			_integrate_velocities(i);
+		}
+	}
+
+	// Bodies can deactivate here, which removes them from the active list.
+	for (GodotBody2D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
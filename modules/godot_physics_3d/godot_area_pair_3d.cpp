@@ -92,6 +92,10 @@ void GodotAreaPair3D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint3D::SortKey GodotAreaPair3D::get_sort_key() const {
+	return make_sort_key(body->get_self(), body_shape, area->get_self(), area_shape);
+}
+
 GodotAreaPair3D::GodotAreaPair3D(GodotBody3D *p_body, int p_body_shape, GodotArea3D *p_area, int p_area_shape) {
 	body = p_body;
 	area = p_area;
@@ -175,6 +179,10 @@ void GodotArea2Pair3D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint3D::SortKey GodotArea2Pair3D::get_sort_key() const {
+	return make_sort_key(area_a->get_self(), shape_a, area_b->get_self(), shape_b);
+}
+
 GodotArea2Pair3D::GodotArea2Pair3D(GodotArea3D *p_area_a, int p_shape_a, GodotArea3D *p_area_b, int p_shape_b) {
 	area_a = p_area_a;
 	area_b = p_area_b;
@@ -270,6 +278,10 @@ void GodotAreaSoftBodyPair3D::solve(real_t p_step) {
 	// Nothing to do.
 }
 
+GodotConstraint3D::SortKey GodotAreaSoftBodyPair3D::get_sort_key() const {
+	return make_sort_key(soft_body->get_self(), soft_body_shape, area->get_self(), area_shape);
+}
+
 GodotAreaSoftBodyPair3D::GodotAreaSoftBodyPair3D(GodotSoftBody3D *p_soft_body, int p_soft_body_shape, GodotArea3D *p_area, int p_area_shape) {
 	soft_body = p_soft_body;
 	area = p_area;
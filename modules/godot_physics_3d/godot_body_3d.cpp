@@ -172,6 +172,9 @@ void GodotBody3D::reset_mass_properties() {
 }
 
 void GodotBody3D::set_active(bool p_active) {
+	// Only rigid bodies stay put while inactive, kinematic ones can still be moved every frame.
+	_set_sleeping(!p_active && mode >= PhysicsServer3D::BODY_MODE_RIGID);
+
 	if (active == p_active) {
 		return;
 	}
@@ -438,6 +441,41 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody3D::save_state(State &r_state) const {
+	r_state.rid = get_self().get_id();
+	r_state.transform = get_transform();
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::restore_state(const State &p_state) {
+	// Unlike setting BODY_STATE_TRANSFORM, this neither wakes up neighbors nor starts a kinematic motion.
+	_set_transform(p_state.transform);
+	_set_inv_transform(get_transform().affine_inverse());
+	_update_transform_dependent();
+	new_transform = get_transform();
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+
+	set_active(p_state.active);
+}
+
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		if (mass_properties_update_list.in_list()) {
@@ -665,12 +703,20 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		integration_moved_shapes = true;
 	}
 
 	contact_count = 0;
 }
 
+void GodotBody3D::finish_integrate_forces() {
+	if (integration_moved_shapes) {
+		integration_moved_shapes = false;
+		_update_shapes_broadphase();
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
@@ -678,10 +724,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -702,7 +744,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			integration_stopped = true; //stopped moving, deactivate
 		}
 
 		return;
@@ -731,12 +773,34 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
+	_update_shapes(false);
+	integration_moved_shapes = true;
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::finish_integrate_velocities() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC || !get_space()) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (integration_moved_shapes) {
+		integration_moved_shapes = false;
+		_update_shapes_broadphase();
+	}
+
+	if (integration_stopped) {
+		integration_stopped = false;
+		set_active(false);
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -104,6 +104,10 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool omit_force_integration = false;
 	bool active = true;
 
+	// Space updates left by integrate_forces() and integrate_velocities() for the finish_* methods.
+	bool integration_moved_shapes = false;
+	bool integration_stopped = false;
+
 	bool continuous_cd = false;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
@@ -299,6 +303,25 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
+	// Everything the simulation changes between steps, copied as is by GodotSpace3D::save_state().
+	struct State {
+		uint64_t rid = 0;
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		Vector3 constant_force;
+		Vector3 constant_torque;
+		real_t still_time = 0.0;
+		uint32_t active = 0;
+	};
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
 
@@ -316,8 +339,12 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// Integration only touches this body, so different bodies can be integrated on different threads. The space is
+	// updated afterwards by calling the matching finish_* method on the physics thread, in a deterministic order.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -595,6 +595,43 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint3D::SortKey GodotBodyPair3D::get_sort_key() const {
+	return make_sort_key(A->get_self(), shape_A, B->get_self(), shape_B);
+}
+
+void GodotBodyPair3D::save_state(State &r_state) const {
+	r_state.body_A = A->get_self().get_id();
+	r_state.body_B = B->get_self().get_id();
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+	r_state.sep_axis = sep_axis;
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		r_state.contacts[i] = contacts[i];
+	}
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+}
+
+bool GodotBodyPair3D::matches_state(const State &p_state) const {
+	// Contacts are stored relative to A, so the pair must not have been recreated the other way around.
+	return p_state.body_A == A->get_self().get_id() && p_state.body_B == B->get_self().get_id() && p_state.shape_A == shape_A && p_state.shape_B == shape_B;
+}
+
+void GodotBodyPair3D::restore_state(const State &p_state) {
+	sep_axis = p_state.sep_axis;
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	contact_count = CLAMP(p_state.contact_count, 0, (int32_t)MAX_CONTACTS);
+	collided = p_state.collided;
+}
+
+void GodotBodyPair3D::clear_state() {
+	sep_axis = Vector3();
+	contact_count = 0;
+	collided = false;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -972,6 +1009,10 @@ void GodotBodySoftBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint3D::SortKey GodotBodySoftBodyPair3D::get_sort_key() const {
+	return make_sort_key(body->get_self(), body_shape, soft_body->get_self(), 0);
+}
+
 GodotBodySoftBodyPair3D::GodotBodySoftBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotSoftBody3D *p_B) :
 		GodotBodyContact3D(&body, 1) {
 	body = p_A;
@@ -109,6 +109,27 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual SortKey get_sort_key() const override;
+
+	// Contacts kept between steps to warm start the solver, copied as is by GodotSpace3D::save_state().
+	struct State {
+		uint64_t body_A = 0;
+		uint64_t body_B = 0;
+		int32_t shape_A = 0;
+		int32_t shape_B = 0;
+		Vector3 sep_axis;
+		Contact contacts[MAX_CONTACTS];
+		int32_t contact_count = 0;
+		uint32_t collided = 0;
+	};
+
+	virtual bool is_body_pair() const override { return true; }
+
+	void save_state(State &r_state) const;
+	bool matches_state(const State &p_state) const;
+	void restore_state(const State &p_state);
+	void clear_state();
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
@@ -137,6 +158,8 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual SortKey get_sort_key() const override;
+
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const override { return soft_body; }
 	virtual int get_soft_body_count() const override { return 1; }
 
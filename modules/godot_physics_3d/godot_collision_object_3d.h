@@ -76,13 +76,16 @@ private:
 	Transform3D transform;
 	Transform3D inv_transform;
 	bool _static = true;
+	bool _sleeping = false;
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
-	void _update_shapes_with_motion(const Vector3 &p_motion);
+	// Without p_update_broadphase, only the cached shape AABBs are updated, which is safe to do on any thread.
+	// _update_shapes_broadphase() then moves the shapes to them.
+	void _update_shapes(bool p_update_broadphase = true);
+	void _update_shapes_with_motion(const Vector3 &p_motion, bool p_update_broadphase = true);
+	void _update_shapes_broadphase();
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -98,6 +101,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform3D &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(GodotSpace3D *p_space);
@@ -110,6 +114,11 @@ public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
+	// RIDs increase as objects are created, so this orders objects by creation.
+	struct SelfComparator {
+		_FORCE_INLINE_ bool operator()(const GodotCollisionObject3D *p_a, const GodotCollisionObject3D *p_b) const { return p_a->get_self() < p_b->get_self(); }
+	};
+
 	_FORCE_INLINE_ void set_instance_id(const ObjectID &p_instance_id) { instance_id = p_instance_id; }
 	_FORCE_INLINE_ ObjectID get_instance_id() const { return instance_id; }
 
@@ -29,6 +29,7 @@
 /**************************************************************************/
 
 #include "godot_collision_solver_3d_sat.h"
+#include "godot_collision_solver_3d_sat_simd.h"
 
 #include "gjk_epa.h"
 
@@ -626,30 +627,13 @@ class SeparatorAxisTest {
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
 
-public:
-	Vector3 best_axis;
-
-	_FORCE_INLINE_ bool test_previous_axis() {
-		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
-			return test_axis(*callback->prev_axis);
-		} else {
-			return true;
-		}
-	}
-
-	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
-		Vector3 axis = p_axis;
-
-		if (axis.is_zero_approx()) {
-			// strange case, try an upwards separator
-			axis = Vector3(0.0, 1.0, 0.0);
-		}
-
-		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
-
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
+#ifdef SAT_SIMD
+	static constexpr bool VECTORIZED = SATProjector<ShapeA>::VECTORIZED && SATProjector<ShapeB>::VECTORIZED;
+	Vector3 queued_axes[4];
+	int queued_axis_count = 0;
+#endif
 
+	_FORCE_INLINE_ bool _test_range(const Vector3 &p_axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -664,7 +648,7 @@ public:
 		max_B -= (min_A + max_A) * 0.5;
 
 		if (min_B > 0.0 || max_B < 0.0) {
-			separator_axis = axis;
+			separator_axis = p_axis;
 			return false; // doesn't contain 0
 		}
 
@@ -677,15 +661,105 @@ public:
 		if (max_B < min_B) {
 			if (max_B < best_depth) {
 				best_depth = max_B;
-				best_axis = axis;
+				best_axis = p_axis;
 			}
 		} else {
 			if (min_B < best_depth) {
 				best_depth = min_B;
-				best_axis = -axis; // keep it as A axis
+				best_axis = -p_axis; // keep it as A axis
+			}
+		}
+
+		return true;
+	}
+
+public:
+	Vector3 best_axis;
+
+	_FORCE_INLINE_ bool test_previous_axis() {
+		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
+			return test_axis(*callback->prev_axis);
+		} else {
+			return true;
+		}
+	}
+
+	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
+		Vector3 axis = p_axis;
+
+		if (axis.is_zero_approx()) {
+			// strange case, try an upwards separator
+			axis = Vector3(0.0, 1.0, 0.0);
+		}
+
+		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
+
+		// The shape types are known here, qualified calls skip the virtual dispatch.
+		shape_A->ShapeA::project_range(axis, *transform_A, min_A, max_A);
+		shape_B->ShapeB::project_range(axis, *transform_B, min_B, max_B);
+
+		return _test_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Like test_axis(), but axes are tested four at a time when both shapes have vectorized
+	// projections. A separating axis may only be reported by a later call or by flush_axes(),
+	// which must be called before generate_contacts().
+	_FORCE_INLINE_ bool queue_axis(const Vector3 &p_axis) {
+#ifdef SAT_SIMD
+		if constexpr (VECTORIZED) {
+			Vector3 axis = p_axis;
+
+			if (axis.is_zero_approx()) {
+				// strange case, try an upwards separator
+				axis = Vector3(0.0, 1.0, 0.0);
 			}
+
+			queued_axes[queued_axis_count++] = axis;
+			if (queued_axis_count < 4) {
+				return true;
+			}
+			return flush_axes();
 		}
+#endif
+		return test_axis(p_axis);
+	}
+
+	_FORCE_INLINE_ bool flush_axes() {
+#ifdef SAT_SIMD
+		if constexpr (VECTORIZED) {
+			int count = queued_axis_count;
+			if (count == 0) {
+				return true;
+			}
+			queued_axis_count = 0;
+
+			// Unused lanes repeat the last axis.
+			for (int i = count; i < 4; i++) {
+				queued_axes[i] = queued_axes[count - 1];
+			}
+
+			Float4 x = f4_set(queued_axes[0].x, queued_axes[1].x, queued_axes[2].x, queued_axes[3].x);
+			Float4 y = f4_set(queued_axes[0].y, queued_axes[1].y, queued_axes[2].y, queued_axes[3].y);
+			Float4 z = f4_set(queued_axes[0].z, queued_axes[1].z, queued_axes[2].z, queued_axes[3].z);
+
+			Float4 min_A4, max_A4, min_B4, max_B4;
+			SATProjector<ShapeA>::project_range(shape_A, *transform_A, x, y, z, min_A4, max_A4);
+			SATProjector<ShapeB>::project_range(shape_B, *transform_B, x, y, z, min_B4, max_B4);
+
+			float min_A[4], max_A[4], min_B[4], max_B[4];
+			f4_store(min_A, min_A4);
+			f4_store(max_A, max_A4);
+			f4_store(min_B, min_B4);
+			f4_store(max_B, max_B4);
 
+			// Lanes are resolved in queue order so ties pick the same axis as test_axis() would.
+			for (int i = 0; i < count; i++) {
+				if (!_test_range(queued_axes[i], min_A[i], max_A[i], min_B[i], max_B[i])) {
+					return false;
+				}
+			}
+		}
+#endif
 		return true;
 	}
 
@@ -720,7 +794,7 @@ public:
 		Vector3 supports_A[max_supports];
 		int support_count_A;
 		GodotShape3D::FeatureType support_type_A;
-		shape_A->get_supports(transform_A->basis.xform_inv(-best_axis).normalized(), max_supports, supports_A, support_count_A, support_type_A);
+		shape_A->ShapeA::get_supports(transform_A->basis.xform_inv(-best_axis).normalized(), max_supports, supports_A, support_count_A, support_type_A);
 		for (int i = 0; i < support_count_A; i++) {
 			supports_A[i] = transform_A->xform(supports_A[i]);
 		}
@@ -734,7 +808,7 @@ public:
 		Vector3 supports_B[max_supports];
 		int support_count_B;
 		GodotShape3D::FeatureType support_type_B;
-		shape_B->get_supports(transform_B->basis.xform_inv(best_axis).normalized(), max_supports, supports_B, support_count_B, support_type_B);
+		shape_B->ShapeB::get_supports(transform_B->basis.xform_inv(best_axis).normalized(), max_supports, supports_B, support_count_B, support_type_B);
 		for (int i = 0; i < support_count_B; i++) {
 			supports_B[i] = transform_B->xform(supports_B[i]);
 		}
@@ -979,7 +1053,7 @@ static void _collision_sphere_convex_polygon(const GodotShape3D *p_a, const Tran
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -995,7 +1069,7 @@ static void _collision_sphere_convex_polygon(const GodotShape3D *p_a, const Tran
 
 		Vector3 axis = n1.cross(n2).cross(n1).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1007,11 +1081,15 @@ static void _collision_sphere_convex_polygon(const GodotShape3D *p_a, const Tran
 
 		Vector3 axis = (v2 - v1).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1087,7 +1165,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1097,7 +1175,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1112,7 +1190,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1143,7 +1221,7 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 
 		Vector3 axis_ab = (support_a - support_b);
 
-		if (!separator.test_axis(axis_ab.normalized())) {
+		if (!separator.queue_axis(axis_ab.normalized())) {
 			return;
 		}
 
@@ -1153,19 +1231,23 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			//a ->b
 			Vector3 axis_a = p_transform_a.basis.get_column(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+			if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 				return;
 			}
 
 			//b ->a
 			Vector3 axis_b = p_transform_b.basis.get_column(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
+			if (!separator.queue_axis(axis_ab.cross(axis_b).cross(axis_b).normalized())) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1184,7 +1266,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1201,7 +1283,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 			continue;
 		}
 
-		if (!separator.test_axis(axis.normalized())) {
+		if (!separator.queue_axis(axis.normalized())) {
 			return;
 		}
 	}
@@ -1224,7 +1306,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
 				Vector3 axis = Plane(cyl_axis).project(point).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
@@ -1249,7 +1331,7 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		// use point to test axis
 		Vector3 point_axis = (sphere_pos - cpoint).normalized();
 
-		if (!separator.test_axis(point_axis)) {
+		if (!separator.queue_axis(point_axis)) {
 			return;
 		}
 
@@ -1258,12 +1340,16 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		for (int j = 0; j < 3; j++) {
 			Vector3 axis = point_axis.cross(p_transform_a.basis.get_column(j)).cross(p_transform_a.basis.get_column(j)).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1404,7 +1490,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < 3; i++) {
 		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1416,7 +1502,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1430,7 +1516,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -1452,7 +1538,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis_ab = support_a - vtxb;
 
-			if (!separator.test_axis(axis_ab.normalized())) {
+			if (!separator.queue_axis(axis_ab.normalized())) {
 				return;
 			}
 
@@ -1462,7 +1548,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 				//a ->b
 				Vector3 axis_a = p_transform_a.basis.get_column(i);
 
-				if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
+				if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized())) {
 					return;
 				}
 			}
@@ -1486,7 +1572,7 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 						Vector3 p2 = p_transform_b.xform(vertices[edges[e].vertex_b]);
 						Vector3 n = (p2 - p1);
 
-						if (!separator.test_axis((point - p2).cross(n).cross(n).normalized())) {
+						if (!separator.queue_axis((point - p2).cross(n).cross(n).normalized())) {
 							return;
 						}
 					}
@@ -1495,6 +1581,10 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -1715,7 +1805,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1727,7 +1817,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 		Vector3 edge_axis = p_transform_b.basis.xform(vertices[edges[i].vertex_a]) - p_transform_b.basis.xform(vertices[edges[i].vertex_b]);
 		Vector3 axis = edge_axis.cross(p_transform_a.basis.get_column(1)).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1747,12 +1837,16 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 
 			Vector3 axis = n1.cross(n2).cross(n2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -2074,7 +2168,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_A; i++) {
 		Vector3 axis = a_xform_normal.xform(faces_A[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -2086,7 +2180,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_B; i++) {
 		Vector3 axis = b_xform_normal.xform(faces_B[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -2110,7 +2204,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
 				Vector3 axis = e1.cross(e2).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
@@ -2123,7 +2217,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			Vector3 va = p_transform_a.xform(vertices_A[i]);
 
 			for (int j = 0; j < vertex_count_B; j++) {
-				if (!separator.test_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
+				if (!separator.queue_axis((va - p_transform_b.xform(vertices_B[j])).normalized())) {
 					return;
 				}
 			}
@@ -2138,7 +2232,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			for (int j = 0; j < vertex_count_B; j++) {
 				Vector3 e3 = p_transform_b.xform(vertices_B[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
 				}
 			}
@@ -2152,13 +2246,17 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			for (int j = 0; j < vertex_count_A; j++) {
 				Vector3 e3 = p_transform_a.xform(vertices_A[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized())) {
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized())) {
 					return;
 				}
 			}
 		}
 	}
 
+	if (!separator.flush_axes()) {
+		return;
+	}
+
 	separator.generate_contacts();
 }
 
@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  godot_collision_solver_3d_sat_simd.h                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_COLLISION_SOLVER_3D_SAT_SIMD_H
+#define GODOT_COLLISION_SOLVER_3D_SAT_SIMD_H
+
+#include "godot_shape_3d.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SAT_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SAT_SIMD_NEON
+#endif
+#endif
+
+// Boxes, spheres, capsules and convex polygons are projected on four axes at a time, with the
+// axes given as x, y and z lanes in world space. The results match each shape's project_range().
+
+#if defined(SAT_SIMD_SSE2) || defined(SAT_SIMD_NEON)
+#define SAT_SIMD
+
+#if defined(SAT_SIMD_SSE2)
+typedef __m128 Float4;
+static _FORCE_INLINE_ Float4 f4_splat(float p_value) { return _mm_set1_ps(p_value); }
+static _FORCE_INLINE_ Float4 f4_set(float p_x, float p_y, float p_z, float p_w) { return _mm_set_ps(p_w, p_z, p_y, p_x); }
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_sub(Float4 p_a, Float4 p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return _mm_max_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_abs(Float4 p_a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), p_a); }
+static _FORCE_INLINE_ Float4 f4_sqrt(Float4 p_a) { return _mm_sqrt_ps(p_a); }
+static _FORCE_INLINE_ void f4_store(float *r_ptr, Float4 p_v) { _mm_storeu_ps(r_ptr, p_v); }
+#else
+typedef float32x4_t Float4;
+static _FORCE_INLINE_ Float4 f4_splat(float p_value) { return vdupq_n_f32(p_value); }
+static _FORCE_INLINE_ Float4 f4_set(float p_x, float p_y, float p_z, float p_w) {
+	const float values[4] = { p_x, p_y, p_z, p_w };
+	return vld1q_f32(values);
+}
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_sub(Float4 p_a, Float4 p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return vmaxq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_abs(Float4 p_a) { return vabsq_f32(p_a); }
+static _FORCE_INLINE_ Float4 f4_sqrt(Float4 p_a) { return vsqrtq_f32(p_a); }
+static _FORCE_INLINE_ void f4_store(float *r_ptr, Float4 p_v) { vst1q_f32(r_ptr, p_v); }
+#endif
+
+static _FORCE_INLINE_ Float4 f4_dot(const Vector3 &p_v, Float4 p_x, Float4 p_y, Float4 p_z) {
+	return f4_add(f4_add(f4_mul(f4_splat(p_v.x), p_x), f4_mul(f4_splat(p_v.y), p_y)), f4_mul(f4_splat(p_v.z), p_z));
+}
+
+// Axes in the shape's local space, the same as Basis::xform_inv() for each lane.
+static _FORCE_INLINE_ void f4_xform_inv(const Basis &p_basis, Float4 p_x, Float4 p_y, Float4 p_z, Float4 &r_x, Float4 &r_y, Float4 &r_z) {
+	r_x = f4_dot(p_basis.get_column(0), p_x, p_y, p_z);
+	r_y = f4_dot(p_basis.get_column(1), p_x, p_y, p_z);
+	r_z = f4_dot(p_basis.get_column(2), p_x, p_y, p_z);
+}
+
+template <typename ShapeT>
+struct SATProjector {
+	static constexpr bool VECTORIZED = false;
+};
+
+template <>
+struct SATProjector<GodotSphereShape3D> {
+	static constexpr bool VECTORIZED = true;
+
+	static _FORCE_INLINE_ void project_range(const GodotSphereShape3D *p_shape, const Transform3D &p_transform, Float4 p_x, Float4 p_y, Float4 p_z, Float4 &r_min, Float4 &r_max) {
+		Float4 lx, ly, lz;
+		f4_xform_inv(p_transform.basis, p_x, p_y, p_z, lx, ly, lz);
+
+		Float4 scale = f4_sqrt(f4_add(f4_add(f4_mul(lx, lx), f4_mul(ly, ly)), f4_mul(lz, lz)));
+		Float4 length = f4_mul(f4_splat(p_shape->get_radius()), scale);
+		Float4 distance = f4_dot(p_transform.origin, p_x, p_y, p_z);
+
+		r_min = f4_sub(distance, length);
+		r_max = f4_add(distance, length);
+	}
+};
+
+template <>
+struct SATProjector<GodotBoxShape3D> {
+	static constexpr bool VECTORIZED = true;
+
+	static _FORCE_INLINE_ void project_range(const GodotBoxShape3D *p_shape, const Transform3D &p_transform, Float4 p_x, Float4 p_y, Float4 p_z, Float4 &r_min, Float4 &r_max) {
+		Float4 lx, ly, lz;
+		f4_xform_inv(p_transform.basis, p_x, p_y, p_z, lx, ly, lz);
+
+		const Vector3 half_extents = p_shape->get_half_extents();
+		Float4 length = f4_add(f4_add(f4_mul(f4_abs(lx), f4_splat(half_extents.x)), f4_mul(f4_abs(ly), f4_splat(half_extents.y))), f4_mul(f4_abs(lz), f4_splat(half_extents.z)));
+		Float4 distance = f4_dot(p_transform.origin, p_x, p_y, p_z);
+
+		r_min = f4_sub(distance, length);
+		r_max = f4_add(distance, length);
+	}
+};
+
+template <>
+struct SATProjector<GodotCapsuleShape3D> {
+	static constexpr bool VECTORIZED = true;
+
+	static _FORCE_INLINE_ void project_range(const GodotCapsuleShape3D *p_shape, const Transform3D &p_transform, Float4 p_x, Float4 p_y, Float4 p_z, Float4 &r_min, Float4 &r_max) {
+		Float4 lx, ly, lz;
+		f4_xform_inv(p_transform.basis, p_x, p_y, p_z, lx, ly, lz);
+
+		// The rounded part scales with the local axis length, the segment only along local Y.
+		const real_t radius = p_shape->get_radius();
+		const real_t h = p_shape->get_height() * 0.5 - radius;
+		Float4 scale = f4_sqrt(f4_add(f4_add(f4_mul(lx, lx), f4_mul(ly, ly)), f4_mul(lz, lz)));
+		Float4 length = f4_add(f4_mul(f4_splat(radius), scale), f4_mul(f4_splat(h), f4_abs(ly)));
+		Float4 distance = f4_dot(p_transform.origin, p_x, p_y, p_z);
+
+		r_min = f4_sub(distance, length);
+		r_max = f4_add(distance, length);
+	}
+};
+
+template <>
+struct SATProjector<GodotConvexPolygonShape3D> {
+	static constexpr bool VECTORIZED = true;
+
+	static _FORCE_INLINE_ void project_range(const GodotConvexPolygonShape3D *p_shape, const Transform3D &p_transform, Float4 p_x, Float4 p_y, Float4 p_z, Float4 &r_min, Float4 &r_max) {
+		const Geometry3D::MeshData &mesh = p_shape->get_mesh();
+		uint32_t vertex_count = mesh.vertices.size();
+		if (vertex_count == 0) {
+			r_min = f4_splat(0.0);
+			r_max = f4_splat(0.0);
+			return;
+		}
+
+		if (vertex_count > 3 * p_shape->extreme_vertices.size()) {
+			// Large meshes are projected through get_support(), which only pays off one axis at a time.
+			float x[4], y[4], z[4], mins[4], maxs[4];
+			f4_store(x, p_x);
+			f4_store(y, p_y);
+			f4_store(z, p_z);
+			for (int i = 0; i < 4; i++) {
+				p_shape->GodotConvexPolygonShape3D::project_range(Vector3(x[i], y[i], z[i]), p_transform, mins[i], maxs[i]);
+			}
+			r_min = f4_set(mins[0], mins[1], mins[2], mins[3]);
+			r_max = f4_set(maxs[0], maxs[1], maxs[2], maxs[3]);
+			return;
+		}
+
+		Float4 lx, ly, lz;
+		f4_xform_inv(p_transform.basis, p_x, p_y, p_z, lx, ly, lz);
+
+		const Vector3 *vertices = mesh.vertices.ptr();
+		Float4 min_d = f4_dot(vertices[0], lx, ly, lz);
+		Float4 max_d = min_d;
+		for (uint32_t i = 1; i < vertex_count; i++) {
+			Float4 d = f4_dot(vertices[i], lx, ly, lz);
+			min_d = f4_min(min_d, d);
+			max_d = f4_max(max_d, d);
+		}
+
+		Float4 distance = f4_dot(p_transform.origin, p_x, p_y, p_z);
+		r_min = f4_add(min_d, distance);
+		r_max = f4_add(max_d, distance);
+	}
+};
+
+#endif // SAT_SIMD_SSE2 || SAT_SIMD_NEON
+
+#endif // GODOT_COLLISION_SOLVER_3D_SAT_SIMD_H
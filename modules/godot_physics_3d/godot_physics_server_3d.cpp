@@ -39,6 +39,7 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -214,6 +215,24 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+uint64_t GodotPhysicsServer3D::space_get_state_hash(RID p_space) const {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+	return space->get_state_hash();
+}
+
+PackedByteArray GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	return space->save_state();
+}
+
+void GodotPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -920,6 +939,83 @@ bool GodotPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &
 	return body->get_space()->test_body_motion(body, p_parameters, r_result);
 }
 
+struct _SlideTestMotionData {
+	GodotBody3D *body = nullptr;
+	GodotCollisionObject3D **cull_results = nullptr;
+	int *cull_subindices = nullptr;
+};
+
+static bool _slide_test_motion(RID p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, void *p_userdata) {
+	_SlideTestMotionData *data = static_cast<_SlideTestMotionData *>(p_userdata);
+	return data->body->get_space()->test_body_motion(data->body, p_parameters, r_result, data->cull_results, data->cull_subindices);
+}
+
+void GodotPhysicsServer3D::_move_and_slide_chunk(uint32_t p_chunk, SlideBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	_SlideTestMotionData data;
+	data.cull_results = cull_results.ptr();
+	data.cull_subindices = cull_subindices.ptr();
+
+	int from = p_chunk * SLIDE_BATCH_CHUNK_SIZE;
+	int to = MIN(from + SLIDE_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		data.body = p_batch->bodies[i];
+		if (data.body) {
+			_body_slide(p_batch->body_rids[i], data.body->get_transform(), p_batch->motions[i], *p_batch->parameters, _slide_test_motion, &data, p_batch->results[i]);
+		}
+	}
+}
+
+void GodotPhysicsServer3D::body_move_and_slide_batch(const RID *p_bodies, const Vector3 *p_motions, int p_count, const SlideParameters &p_parameters, SlideResult *r_results) {
+	// Resolve the bodies up front, the worker threads only run motion tests against the current state of the spaces.
+	LocalVector<GodotBody3D *> bodies;
+	bodies.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		r_results[i] = SlideResult();
+
+		GodotBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		bodies[i] = nullptr;
+		ERR_CONTINUE(!body);
+		ERR_CONTINUE(!body->get_space());
+		ERR_CONTINUE(body->get_space()->is_locked());
+		bodies[i] = body;
+		r_results[i].transform = body->get_transform();
+	}
+
+	_update_shapes();
+
+	SlideBatch batch;
+	batch.bodies = bodies.ptr();
+	batch.body_rids = p_bodies;
+	batch.motions = p_motions;
+	batch.count = p_count;
+	batch.parameters = &p_parameters;
+	batch.results = r_results;
+
+	uint32_t chunk_count = (p_count + SLIDE_BATCH_CHUNK_SIZE - 1) / SLIDE_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_move_and_slide_chunk(i, &batch);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_move_and_slide_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DMoveAndSlide"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	// All bodies were tested against the same state, now move them.
+	if (p_parameters.update_transforms) {
+		for (int i = 0; i < p_count; i++) {
+			if (bodies[i]) {
+				body_set_state(p_bodies[i], BODY_STATE_TRANSFORM, r_results[i].transform);
+			}
+		}
+	}
+}
+
 PhysicsDirectBodyState3D *GodotPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -68,6 +68,20 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	SelfList<GodotCollisionObject3D>::List pending_shape_update_list;
 	void _update_shapes();
 
+	// Batched slides run in chunks on the WorkerThreadPool, each chunk culling into its own buffers.
+	static constexpr int SLIDE_BATCH_CHUNK_SIZE = 8;
+
+	struct SlideBatch {
+		GodotBody3D *const *bodies = nullptr;
+		const RID *body_rids = nullptr;
+		const Vector3 *motions = nullptr;
+		int count = 0;
+		const SlideParameters *parameters = nullptr;
+		SlideResult *results = nullptr;
+	};
+
+	void _move_and_slide_chunk(uint32_t p_chunk, SlideBatch *p_batch);
+
 	static GodotPhysicsServer3D *godot_singleton;
 
 public:
@@ -116,6 +130,9 @@ public:
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
+	virtual uint64_t space_get_state_hash(RID p_space) const override;
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) override;
 
 	/* AREA API */
 
@@ -251,6 +268,7 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) override;
+	virtual void body_move_and_slide_batch(const RID *p_bodies, const Vector3 *p_motions, int p_count, const SlideParameters &p_parameters, SlideResult *r_results) override;
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
@@ -1346,41 +1346,62 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+void GodotConcavePolygonShape3D::_quantize(const Vector3 &p_point, bool p_round_up, uint16_t *r_quantized) const {
+	for (int i = 0; i < 3; i++) {
+		real_t q = (p_point[i] - bvh_origin[i]) * bvh_quantize_scale[i];
+		q = p_round_up ? Math::ceil(q) : Math::floor(q);
+		r_quantized[i] = (uint16_t)CLAMP(q, (real_t)0.0, (real_t)UINT16_MAX);
 	}
+}
+
+AABB GodotConcavePolygonShape3D::_dequantize(const BVH &p_node) const {
+	Vector3 min(p_node.min[0], p_node.min[1], p_node.min[2]);
+	Vector3 max(p_node.max[0], p_node.max[1], p_node.max[2]);
+	return AABB(bvh_origin + min * bvh_dequantize_scale, (max - min) * bvh_dequantize_scale);
+}
+
+void GodotConcavePolygonShape3D::_cull_segment(_SegmentCullParams *p_params) const {
+	int stack[BVH_MAX_DEPTH];
+	int stack_size = 0;
+	int idx = 0;
+
+	while (true) {
+		const BVH &node = p_params->bvh[idx];
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
+		if (_dequantize(node).intersects_segment(p_params->from, p_params->to)) {
+			if (!node.is_leaf()) {
+				// Visit the left child next, and the right one once done with it.
+				stack[stack_size++] = node.data;
+				idx++;
+				continue;
+			}
+
+			int face_index = node.get_face_index();
+			const Face *f = &p_params->faces[face_index];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+
+			Vector3 res;
+			Vector3 normal;
+			if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
+				real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
+				if ((d > 0) && (d < p_params->min_d)) {
+					p_params->min_d = d;
+					p_params->result = res;
+					p_params->normal = normal;
+					p_params->face_index = face_index;
+					p_params->collisions++;
+				}
 			}
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
+
+		if (stack_size == 0) {
+			break;
 		}
+		idx = stack[--stack_size];
 	}
 }
 
@@ -1409,7 +1430,7 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	params.face = &face;
 
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1429,35 +1450,36 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+bool GodotConcavePolygonShape3D::_cull(_CullParams *p_params) const {
+	int stack[BVH_MAX_DEPTH];
+	int stack_size = 0;
+	int idx = 0;
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
+	while (true) {
+		const BVH &node = p_params->bvh[idx];
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
+		if (node.overlaps(p_params->aabb_min, p_params->aabb_max)) {
+			if (!node.is_leaf()) {
+				stack[stack_size++] = node.data;
+				idx++;
+				continue;
 			}
-		}
 
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
+			const Face *f = &p_params->faces[node.get_face_index()];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+			if (p_params->callback(p_params->userdata, face)) {
 				return true;
 			}
 		}
+
+		if (stack_size == 0) {
+			break;
+		}
+		idx = stack[--stack_size];
 	}
 
 	return false;
@@ -1469,7 +1491,10 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	// Quantizing clamps to the shape's bounds, so make sure there is an overlap to begin with.
+	if (!get_aabb().intersects(p_local_aabb)) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
@@ -1481,7 +1506,8 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	face.invert_backface_collision = p_invert_backface_collision;
 
 	_CullParams params;
-	params.aabb = local_aabb;
+	_quantize(p_local_aabb.position, false, params.aabb_min);
+	_quantize(p_local_aabb.position + p_local_aabb.size, true, params.aabb_max);
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
@@ -1490,7 +1516,7 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1587,24 +1613,18 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
 	int idx = p_idx;
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
-
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	_quantize(p_bvh_tree->aabb.position, false, p_bvh_array[idx].min);
+	_quantize(p_bvh_tree->aabb.position + p_bvh_tree->aabb.size, true, p_bvh_array[idx].max);
 
+	if (p_bvh_tree->face_index >= 0) {
+		p_bvh_array[idx].data = -1 - p_bvh_tree->face_index;
 	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
+		// Branches always have both children, the left one is stored right after.
+		++p_idx;
+		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
+		p_bvh_array[idx].data = ++p_idx;
 		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
 	}
 
 	memdelete(p_bvh_tree);
@@ -1658,6 +1678,12 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	int count = 0;
 	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
 
+	bvh_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		bvh_quantize_scale[i] = _aabb.size[i] > 0.0 ? UINT16_MAX / _aabb.size[i] : 0.0;
+		bvh_dequantize_scale[i] = _aabb.size[i] / UINT16_MAX;
+	}
+
 	bvh.resize(count + 1);
 
 	BVH *bvh_arrayw2 = bvh.ptrw();
@@ -1770,41 +1796,6 @@ _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_
 	return false;
 }
 
-_FORCE_INLINE_ bool _heightmap_chunk_cull_segment(_HeightmapSegmentCullParams &p_params, const _HeightmapGridCullState &p_state) {
-	const GodotHeightMapShape3D::Range &chunk = p_params.heightmap->_get_bounds_chunk(p_state.x, p_state.z);
-
-	Vector3 enter_pos;
-	Vector3 exit_pos;
-
-	if (p_state.length_flat > CMP_EPSILON) {
-		real_t flat_to_3d = p_state.length / p_state.length_flat;
-		real_t enter_param = p_state.prev_dist * flat_to_3d;
-		real_t exit_param = p_state.dist * flat_to_3d;
-		enter_pos = p_params.from + p_params.dir * enter_param;
-		exit_pos = p_params.from + p_params.dir * exit_param;
-	} else {
-		// Consider the ray vertical.
-		// (though we shouldn't reach this often because there is an early check up-front)
-		enter_pos = p_params.from;
-		exit_pos = p_params.to;
-	}
-
-	// Transform positions to heightmap space.
-	enter_pos *= GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE;
-	exit_pos *= GodotHeightMapShape3D::BOUNDS_CHUNK_SIZE;
-
-	// We did enter the flat projection of the AABB,
-	// but we have to check if we intersect it on the vertical axis.
-	if ((enter_pos.y > chunk.max) && (exit_pos.y > chunk.max)) {
-		return false;
-	}
-	if ((enter_pos.y < chunk.min) && (exit_pos.y < chunk.min)) {
-		return false;
-	}
-
-	return p_params.heightmap->_intersect_grid_segment(_heightmap_cell_cull_segment, enter_pos, exit_pos, p_params.heightmap->width, p_params.heightmap->depth, p_params.heightmap->local_origin, p_params.result, p_params.normal);
-}
-
 template <typename ProcessFunction>
 bool GodotHeightMapShape3D::_intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const {
 	Vector3 delta = (p_end - p_begin);
@@ -1946,6 +1937,65 @@ bool GodotHeightMapShape3D::_intersect_grid_segment(ProcessFunction &p_process,
 	return false;
 }
 
+bool GodotHeightMapShape3D::_intersect_bounds_segment(int p_level, int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+	const BoundsLevel &level = bounds_levels[p_level];
+	if ((p_x >= level.width) || (p_z >= level.depth)) {
+		return false;
+	}
+
+	const Range &range = level.ranges[(p_z * level.width) + p_x];
+
+	// Box of the cells covered by this node, in shape space.
+	const int node_cells = BOUNDS_CHUNK_SIZE << p_level;
+	const Vector3 node_min = Vector3(p_x * node_cells, range.min, p_z * node_cells) - local_origin;
+	const Vector3 node_max = node_min + Vector3(MIN(node_cells, width - 1 - p_x * node_cells), range.max - range.min, MIN(node_cells, depth - 1 - p_z * node_cells));
+
+	// Clip the segment to the box.
+	const Vector3 delta = p_end - p_begin;
+	real_t t_min = 0.0;
+	real_t t_max = 1.0;
+	for (int i = 0; i < 3; i++) {
+		if (Math::abs(delta[i]) < CMP_EPSILON) {
+			if ((p_begin[i] < node_min[i]) || (p_begin[i] > node_max[i])) {
+				return false;
+			}
+			continue;
+		}
+
+		real_t t0 = (node_min[i] - p_begin[i]) / delta[i];
+		real_t t1 = (node_max[i] - p_begin[i]) / delta[i];
+		if (t0 > t1) {
+			SWAP(t0, t1);
+		}
+		t_min = MAX(t_min, t0);
+		t_max = MIN(t_max, t1);
+		if (t_min > t_max) {
+			return false;
+		}
+	}
+
+	if (p_level == 0) {
+		// Overlap neighboring chunks slightly, so that hits right on their border aren't missed.
+		t_min = MAX(t_min - CMP_EPSILON, (real_t)0.0);
+		t_max = MIN(t_max + CMP_EPSILON, (real_t)1.0);
+		return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin + delta * t_min, p_begin + delta * t_max, width, depth, local_origin, r_point, r_normal);
+	}
+
+	// Visit the children in the order the ray goes through them, so the first hit is the closest.
+	// The ray can't go through both children that are only near on one axis, so their order doesn't matter.
+	const int x_flip = (delta.x < 0.0) ? 1 : 0;
+	const int z_flip = (delta.z < 0.0) ? 1 : 0;
+	for (int j = 0; j < 2; j++) {
+		for (int i = 0; i < 2; i++) {
+			if (_intersect_bounds_segment(p_level - 1, p_x * 2 + (i ^ x_flip), p_z * 2 + (j ^ z_flip), p_begin, p_end, r_point, r_normal)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
 	if (heights.is_empty()) {
 		return false;
@@ -1982,7 +2032,7 @@ bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vect
 			r_normal = params.normal;
 			return true;
 		}
-	} else if (bounds_grid.is_empty()) {
+	} else if (bounds_levels.is_empty()) {
 		// Process all cells intersecting the flat projection of the ray.
 		return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin, p_end, width, depth, local_origin, r_point, r_normal);
 	} else {
@@ -1992,15 +2042,8 @@ bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vect
 			// Don't use chunks, the ray is too short in the plane.
 			return _intersect_grid_segment(_heightmap_cell_cull_segment, p_begin, p_end, width, depth, local_origin, r_point, r_normal);
 		} else {
-			// The ray is long, run raycast on a higher-level grid.
-			Vector3 bounds_from = p_begin / BOUNDS_CHUNK_SIZE;
-			Vector3 bounds_to = p_end / BOUNDS_CHUNK_SIZE;
-			Vector3 bounds_offset = local_origin / BOUNDS_CHUNK_SIZE;
-			// Plus 1 here to width and depth of the chunk because _intersect_grid_segment() is used by cell level as well,
-			// and in _intersect_grid_segment() the loop will exit 1 early because for cell point triangle lookup, it dose x + 1, z + 1 etc for the vertex.
-			int bounds_width = bounds_grid_width + 1;
-			int bounds_depth = bounds_grid_depth + 1;
-			return _intersect_grid_segment(_heightmap_chunk_cull_segment, bounds_from, bounds_to, bounds_width, bounds_depth, bounds_offset, r_point, r_normal);
+			// The ray is long, descend the min/max pyramid to skip the areas it passes above or below.
+			return _intersect_bounds_segment(bounds_levels.size() - 1, 0, 0, p_begin, p_end, r_point, r_normal);
 		}
 	}
 
@@ -2058,8 +2101,28 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
+	const real_t aabb_min_y = local_aabb.position.y;
+	const real_t aabb_max_y = local_aabb.position.y + local_aabb.size.y;
+
 	for (int z = start_z; z < end_z; z++) {
 		for (int x = start_x; x < end_x; x++) {
+			if (!bounds_levels.is_empty() && (x % BOUNDS_CHUNK_SIZE == 0 || x == start_x)) {
+				// Skip the rest of the chunk at once if it's all above or below.
+				const Range &chunk = _get_bounds_chunk(x / BOUNDS_CHUNK_SIZE, z / BOUNDS_CHUNK_SIZE);
+				if ((chunk.min > aabb_max_y) || (chunk.max < aabb_min_y)) {
+					x = MIN(end_x, (x / BOUNDS_CHUNK_SIZE + 1) * BOUNDS_CHUNK_SIZE) - 1;
+					continue;
+				}
+			}
+
+			const real_t h00 = _get_height(x, z);
+			const real_t h10 = _get_height(x + 1, z);
+			const real_t h01 = _get_height(x, z + 1);
+			const real_t h11 = _get_height(x + 1, z + 1);
+			if ((MIN(MIN(h00, h10), MIN(h01, h11)) > aabb_max_y) || (MAX(MAX(h00, h10), MAX(h01, h11)) < aabb_min_y)) {
+				continue;
+			}
+
 			// First triangle.
 			_get_point(x, z, face.vertex[0]);
 			_get_point(x + 1, z, face.vertex[1]);
@@ -2091,10 +2154,10 @@ Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
 }
 
 void GodotHeightMapShape3D::_build_accelerator() {
-	bounds_grid.clear();
+	bounds_levels.clear();
 
-	bounds_grid_width = width / BOUNDS_CHUNK_SIZE;
-	bounds_grid_depth = depth / BOUNDS_CHUNK_SIZE;
+	int bounds_grid_width = width / BOUNDS_CHUNK_SIZE;
+	int bounds_grid_depth = depth / BOUNDS_CHUNK_SIZE;
 
 	if (width % BOUNDS_CHUNK_SIZE > 0) {
 		++bounds_grid_width; // In case terrain size isn't dividable by chunk size.
@@ -2104,20 +2167,48 @@ void GodotHeightMapShape3D::_build_accelerator() {
 		++bounds_grid_depth;
 	}
 
-	uint32_t bound_grid_size = (uint32_t)(bounds_grid_width * bounds_grid_depth);
-
-	if (bound_grid_size < 2) {
+	if (bounds_grid_width * bounds_grid_depth < 2) {
 		// Grid is empty or just one chunk.
 		return;
 	}
 
-	bounds_grid.resize(bound_grid_size);
+	int level_width = bounds_grid_width;
+	int level_depth = bounds_grid_depth;
+	while (true) {
+		bounds_levels.resize(bounds_levels.size() + 1);
+		BoundsLevel &level = bounds_levels[bounds_levels.size() - 1];
+		level.width = level_width;
+		level.depth = level_depth;
+		level.ranges.resize(level_width * level_depth);
+
+		if ((level_width == 1) && (level_depth == 1)) {
+			break;
+		}
 
-	// Compute min and max height for all chunks.
-	for (int cz = 0; cz < bounds_grid_depth; ++cz) {
+		level_width = (level_width + 1) / 2;
+		level_depth = (level_depth + 1) / 2;
+	}
+
+	// Compute min and max height for each chunk.
+	// Each chunk includes one extra cell to account for neighbors.
+	// Here is why:
+	// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
+	//
+	//   Left        Right
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	// |   |   |   |   |   |
+	// 0---0---0---1---1---1
+	//           x
+	//
+	// If the AABB for the Left chunk did not share vertices with the Right,
+	// then we would fail collision tests at x due to a gap.
+	BoundsLevel &chunks = bounds_levels[0];
+	for (int cz = 0; cz < chunks.depth; ++cz) {
 		int z0 = cz * BOUNDS_CHUNK_SIZE;
 
-		for (int cx = 0; cx < bounds_grid_width; ++cx) {
+		for (int cx = 0; cx < chunks.width; ++cx) {
 			int x0 = cx * BOUNDS_CHUNK_SIZE;
 
 			Range r;
@@ -2125,22 +2216,6 @@ void GodotHeightMapShape3D::_build_accelerator() {
 			r.min = _get_height(x0, z0);
 			r.max = r.min;
 
-			// Compute min and max height for this chunk.
-			// We have to include one extra cell to account for neighbors.
-			// Here is why:
-			// Say we have a flat terrain, and a plateau that fits a chunk perfectly.
-			//
-			//   Left        Right
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			// |   |   |   |   |   |
-			// 0---0---0---1---1---1
-			//           x
-			//
-			// If the AABB for the Left chunk did not share vertices with the Right,
-			// then we would fail collision tests at x due to a gap.
-			//
 			int z_max = MIN(z0 + BOUNDS_CHUNK_SIZE + 1, depth);
 			int x_max = MIN(x0 + BOUNDS_CHUNK_SIZE + 1, width);
 			for (int z = z0; z < z_max; ++z) {
@@ -2154,7 +2229,29 @@ void GodotHeightMapShape3D::_build_accelerator() {
 				}
 			}
 
-			bounds_grid[cx + cz * bounds_grid_width] = r;
+			chunks.ranges[cx + cz * chunks.width] = r;
+		}
+	}
+
+	// Merge the ranges up the pyramid.
+	for (uint32_t i = 1; i < bounds_levels.size(); ++i) {
+		const BoundsLevel &below = bounds_levels[i - 1];
+		BoundsLevel &level = bounds_levels[i];
+
+		for (int cz = 0; cz < level.depth; ++cz) {
+			for (int cx = 0; cx < level.width; ++cx) {
+				Range r = below.ranges[(cz * 2) * below.width + (cx * 2)];
+
+				for (int z = cz * 2; z < MIN(cz * 2 + 2, below.depth); ++z) {
+					for (int x = cx * 2; x < MIN(cx * 2 + 2, below.width); ++x) {
+						const Range &child = below.ranges[z * below.width + x];
+						r.min = MIN(r.min, child.min);
+						r.max = MAX(r.max, child.max);
+					}
+				}
+
+				level.ranges[cx + cz * level.width] = r;
+			}
 		}
 	}
 }
@@ -2226,6 +2323,8 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 #endif
 	}
 
+	ERR_FAIL_COND(heights_buffer.size() != (width_new * depth_new));
+
 	// Compute min and max heights or use precomputed values.
 	real_t min_height = 0.0;
 	real_t max_height = 0.0;
@@ -2233,9 +2332,10 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 		min_height = d["min_height"];
 		max_height = d["max_height"];
 	} else {
-		int heights_size = heights.size();
+		int heights_size = heights_buffer.size();
+		const real_t *r = heights_buffer.ptr();
 		for (int i = 0; i < heights_size; ++i) {
-			real_t h = heights[i];
+			real_t h = r[i];
 			if (h < min_height) {
 				min_height = h;
 			} else if (h > max_height) {
@@ -2246,8 +2346,6 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 
 	ERR_FAIL_COND(min_height > max_height);
 
-	ERR_FAIL_COND(heights_buffer.size() != (width_new * depth_new));
-
 	// If specified, min and max height will be used as precomputed values.
 	_setup(heights_buffer, width_new, depth_new, min_height, max_height);
 }
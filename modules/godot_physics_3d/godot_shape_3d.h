@@ -316,18 +316,38 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Nodes are stored depth-first, so the left child of a branch always follows it.
+	// Bounds are quantized to 16 bits per axis within the shape's AABB, rounded outwards.
 	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Index of the right child for branches, `-1 - face_index` for leaves.
+		int32_t data = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data < 0; }
+		_FORCE_INLINE_ int get_face_index() const { return -1 - data; }
+
+		_FORCE_INLINE_ bool overlaps(const uint16_t *p_min, const uint16_t *p_max) const {
+			return min[0] <= p_max[0] && max[0] >= p_min[0] &&
+					min[1] <= p_max[1] && max[1] >= p_min[1] &&
+					min[2] <= p_max[2] && max[2] >= p_min[2];
+		}
 	};
 
+	// Median splits keep the tree balanced, so this is plenty for any face count that fits in memory.
+	static const int BVH_MAX_DEPTH = 64;
+
 	Vector<BVH> bvh;
+	Vector3 bvh_origin;
+	Vector3 bvh_quantize_scale;
+	Vector3 bvh_dequantize_scale;
+
+	void _quantize(const Vector3 &p_point, bool p_round_up, uint16_t *r_quantized) const;
+	AABB _dequantize(const BVH &p_node) const;
 
 	struct _CullParams {
-		AABB aabb;
+		uint16_t aabb_min[3] = {};
+		uint16_t aabb_max[3] = {};
 		QueryCallback callback = nullptr;
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
@@ -354,8 +374,8 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	bool _cull(_CullParams *p_params) const;
 
 	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
 
@@ -394,14 +414,20 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 		real_t min = 0.0;
 		real_t max = 0.0;
 	};
-	LocalVector<Range> bounds_grid;
-	int bounds_grid_width = 0;
-	int bounds_grid_depth = 0;
+	// Min/max pyramid. The first level holds the height range of each chunk of cells,
+	// and each level above merges 2x2 ranges of the one below, up to a single range.
+	struct BoundsLevel {
+		LocalVector<Range> ranges;
+		int width = 0;
+		int depth = 0;
+	};
+	LocalVector<BoundsLevel> bounds_levels;
 
 	static const int BOUNDS_CHUNK_SIZE = 16;
 
 	_FORCE_INLINE_ const Range &_get_bounds_chunk(int p_x, int p_z) const {
-		return bounds_grid[(p_z * bounds_grid_width) + p_x];
+		const BoundsLevel &chunks = bounds_levels[0];
+		return chunks.ranges[(p_z * chunks.width) + p_x];
 	}
 
 	_FORCE_INLINE_ real_t _get_height(int p_x, int p_z) const {
@@ -418,6 +444,8 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 
 	void _build_accelerator();
 
+	bool _intersect_bounds_segment(int p_level, int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const;
+
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
 
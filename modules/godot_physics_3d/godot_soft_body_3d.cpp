@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering_server.h"
 
 // Based on Bullet soft body.
@@ -53,6 +54,12 @@ subject to the following restrictions:
 */
 ///btSoftBody implementation by Nathanael Presson
 
+// Soft bodies with at least this many links solve each link batch on the worker thread pool.
+#define SOFT_BODY_PARALLEL_LINK_COUNT 4096
+#define SOFT_BODY_LINK_CHUNK_SIZE 512
+// Must fit in the 64-bit node color masks.
+#define SOFT_BODY_LINK_COLOR_MAX 64
+
 GodotSoftBody3D::GodotSoftBody3D() :
 		GodotCollisionObject3D(TYPE_SOFT_BODY),
 		active_list(this) {
@@ -191,14 +198,19 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 }
 
 void GodotSoftBody3D::update_bounds() {
+	compute_bounds();
+	update_bounds_shape();
+}
+
+void GodotSoftBody3D::compute_bounds() {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
 	bounds = AABB();
+	bounds_moved = false;
 
 	const uint32_t nodes_count = nodes.size();
 	if (nodes_count == 0) {
-		deinitialize_shape();
 		return;
 	}
 
@@ -217,8 +229,17 @@ void GodotSoftBody3D::update_bounds() {
 		}
 	}
 
+	bounds_moved = moved;
+}
+
+void GodotSoftBody3D::update_bounds_shape() {
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+		return;
+	}
+
 	if (get_space()) {
-		initialize_shape(moved);
+		initialize_shape(bounds_moved);
 	}
 }
 
@@ -581,6 +602,7 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 
 	generate_bending_constraints(2);
 	reoptimize_link_order();
+	build_link_batches();
 
 	update_constants();
 	update_normals_and_centroids();
@@ -825,6 +847,68 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	memdelete_arr(link_buffer);
 }
 
+void GodotSoftBody3D::build_link_batches() {
+	link_batches.clear();
+
+	// Smaller soft bodies are solved serially, keep their dependency-optimized link order.
+	const uint32_t link_count = links.size();
+	if (link_count < SOFT_BODY_PARALLEL_LINK_COUNT) {
+		return;
+	}
+
+	// Greedy graph coloring: links of the same color never share a node, so each color can be
+	// solved in parallel. Links that can't get one of the first colors go to a serial overflow batch.
+	const uint32_t overflow_color = SOFT_BODY_LINK_COLOR_MAX;
+
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(nodes.size());
+	memset(node_colors.ptr(), 0, sizeof(uint64_t) * node_colors.size());
+
+	LocalVector<uint32_t> link_colors;
+	link_colors.resize(link_count);
+
+	uint32_t color_offsets[SOFT_BODY_LINK_COLOR_MAX + 2] = {};
+
+	const Node *node0 = nodes.ptr();
+	for (uint32_t link_index = 0; link_index < link_count; ++link_index) {
+		const Link &link = links[link_index];
+		uint64_t &colors_a = node_colors[link.n[0] - node0];
+		uint64_t &colors_b = node_colors[link.n[1] - node0];
+		const uint64_t used_colors = colors_a | colors_b;
+
+		uint32_t color = 0;
+		while (color < overflow_color && (used_colors & (uint64_t(1) << color))) {
+			color++;
+		}
+		if (color < overflow_color) {
+			colors_a |= uint64_t(1) << color;
+			colors_b |= uint64_t(1) << color;
+		}
+
+		link_colors[link_index] = color;
+		color_offsets[color + 1]++;
+	}
+
+	for (uint32_t color = 0; color <= overflow_color; ++color) {
+		if (color_offsets[color + 1] > 0) {
+			LinkBatch batch;
+			batch.begin = color_offsets[color];
+			batch.end = batch.begin + color_offsets[color + 1];
+			batch.independent = color != overflow_color;
+			link_batches.push_back(batch);
+		}
+		color_offsets[color + 1] += color_offsets[color];
+	}
+
+	// Stable sort by color, keeping the dependency-optimized order within each batch.
+	LocalVector<Link> sorted_links;
+	sorted_links.resize(link_count);
+	for (uint32_t link_index = 0; link_index < link_count; ++link_index) {
+		sorted_links[color_offsets[link_colors[link_index]]++] = links[link_index];
+	}
+	links = sorted_links;
+}
+
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 	if (p_node1 == p_node2) {
 		return;
@@ -1044,8 +1128,8 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
+	// Bounds and tree update, the collision shape is updated in finish_predict_motion().
+	compute_bounds();
 
 	// Node tree update.
 	for (const Node &node : nodes) {
@@ -1066,7 +1150,15 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
+void GodotSoftBody3D::finish_predict_motion() {
+	update_bounds_shape();
+}
+
+bool GodotSoftBody3D::has_parallel_links() const {
+	return links.size() >= SOFT_BODY_PARALLEL_LINK_COUNT;
+}
+
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_parallel_links) {
 	const real_t inv_delta = 1.0 / p_delta;
 
 	for (Link &link : links) {
@@ -1082,7 +1174,7 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
 		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		solve_links(1.0, ti, p_parallel_links);
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
 	for (Node &node : nodes) {
@@ -1097,15 +1189,16 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
+void GodotSoftBody3D::_solve_link_range(Link *p_links, uint32_t p_begin, uint32_t p_end, real_t p_kst) {
+	for (uint32_t link_index = p_begin; link_index < p_end; ++link_index) {
+		const Link &link = p_links[link_index];
 		if (link.c0 > 0) {
 			Node &node_a = *link.n[0];
 			Node &node_b = *link.n[1];
 			const Vector3 del = node_b.x - node_a.x;
 			const real_t len = del.length_squared();
 			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
+				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * p_kst;
 				node_a.x -= del * (k * node_a.im);
 				node_b.x += del * (k * node_b.im);
 			}
@@ -1113,6 +1206,34 @@ void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
 	}
 }
 
+void GodotSoftBody3D::solve_links(real_t kst, real_t ti, bool p_parallel) {
+	if (!p_parallel || link_batches.is_empty()) {
+		// Batches are stored back to back, so solving them in order gives the same result.
+		_solve_link_range(links.ptr(), 0, links.size(), kst);
+		return;
+	}
+
+	link_solve_kst = kst;
+	for (const LinkBatch &batch : link_batches) {
+		const uint32_t chunk_count = (batch.end - batch.begin + SOFT_BODY_LINK_CHUNK_SIZE - 1) / SOFT_BODY_LINK_CHUNK_SIZE;
+		if (!batch.independent || chunk_count < 2) {
+			_solve_link_range(links.ptr(), batch.begin, batch.end, kst);
+			continue;
+		}
+
+		link_solve_batch = &batch;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotSoftBody3D::_solve_link_chunk, nullptr, chunk_count, -1, true, SNAME("Physics3DSoftBodyLinks"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+	link_solve_batch = nullptr;
+}
+
+void GodotSoftBody3D::_solve_link_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	const uint32_t begin = link_solve_batch->begin + p_chunk_index * SOFT_BODY_LINK_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + SOFT_BODY_LINK_CHUNK_SIZE, link_solve_batch->end);
+	_solve_link_range(links.ptr(), begin, end, link_solve_kst);
+}
+
 struct AABBQueryResult {
 	const GodotSoftBody3D *soft_body = nullptr;
 	void *userdata = nullptr;
@@ -1220,6 +1341,7 @@ void GodotSoftBody3D::destroy() {
 
 	nodes.clear();
 	links.clear();
+	link_batches.clear();
 	faces.clear();
 
 	bounds = AABB();
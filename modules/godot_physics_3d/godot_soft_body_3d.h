@@ -78,10 +78,21 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 		uint32_t index = 0;
 	};
 
+	// Range of links that share no nodes with each other, so they can be solved in any order.
+	struct LinkBatch {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		bool independent = true; // False for the overflow batch, which must be solved in order.
+	};
+
 	LocalVector<Node> nodes;
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	LocalVector<LinkBatch> link_batches; // Empty when the links are too few to be solved in parallel.
+	real_t link_solve_kst = 1.0;
+	const LinkBatch *link_solve_batch = nullptr;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -111,6 +122,8 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	bool bounds_moved = false;
+
 	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
 
 public:
@@ -201,8 +214,13 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// Only touches this soft body, so it can run for several soft bodies at once.
+	// finish_predict_motion() updates the broadphase and must be called serially afterwards.
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	void finish_predict_motion();
+	void solve_constraints(real_t p_delta, bool p_parallel_links = false);
+
+	bool has_parallel_links() const;
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -220,6 +238,8 @@ protected:
 private:
 	void update_normals_and_centroids();
 	void update_bounds();
+	void compute_bounds();
+	void update_bounds_shape();
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
@@ -234,10 +254,13 @@ private:
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
 	void reoptimize_link_order();
+	void build_link_batches();
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void solve_links(real_t kst, real_t ti, bool p_parallel = false);
+	static void _solve_link_range(Link *p_links, uint32_t p_begin, uint32_t p_end, real_t p_kst);
+	void _solve_link_chunk(uint32_t p_chunk_index, void *p_userdata = nullptr);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
@@ -60,9 +61,8 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V(space->locked, false);
-	int amount = space->broadphase->cull_point(p_parameters.position, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+int GodotPhysicsDirectSpaceState3D::_intersect_point(const PointParameters &p_parameters, const Vector3 &p_position, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const {
+	int amount = space->broadphase->cull_point(p_position, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
@@ -72,23 +72,23 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		Transform3D inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		inv_xform.affine_invert();
 
-		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_parameters.position))) {
+		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_position))) {
 			continue;
 		}
 
@@ -107,16 +107,19 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_point(p_parameters, p_parameters.position, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
 
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -128,21 +131,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_cull_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,6 +210,11 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -262,22 +270,19 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
-
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+void GodotPhysicsDirectSpaceState3D::_cast_motion(GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
 	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
+	mshape.shape = p_shape;
 	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
 
 	bool best_first = true;
@@ -287,30 +292,30 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -325,7 +330,7 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -377,7 +382,13 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 
 	p_closest_safe = best_safe;
 	p_closest_unsafe = best_unsafe;
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
 
+	_cast_motion(shape, p_parameters, p_parameters.transform, p_closest_safe, p_closest_unsafe, r_info, space->intersection_query_results, space->intersection_query_subindex_results);
 	return true;
 }
 
@@ -611,34 +622,155 @@ Vector3 GodotPhysicsDirectSpaceState3D::get_closest_point_to_object_volume(RID p
 	}
 }
 
+void GodotPhysicsDirectSpaceState3D::_intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	int from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		p_batch->hits[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], p_batch->results[i], cull_results.ptr(), cull_subindices.ptr());
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_points_chunk(uint32_t p_chunk, PointBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	int from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		p_batch->hits[i] = _intersect_point(*p_batch->parameters, p_batch->points[i], &p_batch->results[i], 1, cull_results.ptr(), cull_subindices.ptr()) > 0;
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motions_chunk(uint32_t p_chunk, MotionBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	ShapeParameters parameters = *p_batch->parameters;
+
+	int from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = from; i < to; i++) {
+		Transform3D transform = parameters.transform;
+		transform.origin = p_batch->origins[i];
+		parameters.motion = p_batch->motions[i];
+		_cast_motion(p_batch->shape, parameters, transform, p_batch->closest_safe[i], p_batch->closest_unsafe[i], nullptr, cull_results.ptr(), cull_subindices.ptr());
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_intersect_rays_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_rays_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_points(const PointParameters &p_parameters, const Vector3 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	PointBatch batch;
+	batch.parameters = &p_parameters;
+	batch.points = p_points;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_intersect_points_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_points_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectPoints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	ERR_FAIL_COND(space->locked);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	MotionBatch batch;
+	batch.shape = shape;
+	batch.parameters = &p_parameters;
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.count = p_count;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_cast_motions_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motions_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DCastMotions"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 GodotPhysicsDirectSpaceState3D::GodotPhysicsDirectSpaceState3D() {
 	space = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) {
+	int amount = broadphase->cull_aabb(p_aabb, r_cull_results, INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
 
-		if (intersection_query_results[i] == p_body) {
+		if (r_cull_results[i] == p_body) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
+		} else if (r_cull_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		} else if (r_cull_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
 			keep = false;
-		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(intersection_query_results[i]))) {
+		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(r_cull_results[i]))) {
 			keep = false;
-		} else if (static_cast<GodotBody3D *>(intersection_query_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(intersection_query_results[i]->get_self())) {
+		} else if (static_cast<GodotBody3D *>(r_cull_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(r_cull_results[i]->get_self())) {
 			keep = false;
 		}
 
 		if (!keep) {
 			if (i < amount - 1) {
-				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
-				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+				SWAP(r_cull_results[i], r_cull_results[amount - 1]);
+				SWAP(r_cull_subindices[i], r_cull_subindices[amount - 1]);
 			}
 
 			amount--;
@@ -649,7 +781,7 @@ int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
 	return amount;
 }
 
-bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) {
 	//give me back regular physics engine logic
 	//this is madness
 	//and most people using this function will think
@@ -659,6 +791,11 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 	ERR_FAIL_COND_V(p_parameters.max_collisions < 0 || p_parameters.max_collisions > PhysicsServer3D::MotionResult::MAX_COLLISIONS, false);
 
+	if (!r_cull_results) {
+		r_cull_results = intersection_query_results;
+		r_cull_subindices = intersection_query_subindex_results;
+	}
+
 	if (r_result) {
 		*r_result = PhysicsServer3D::MotionResult();
 	}
@@ -722,7 +859,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(p_body, body_aabb, r_cull_results, r_cull_subindices);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_disabled(j)) {
@@ -733,7 +870,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				GodotShape3D *body_shape = p_body->get_shape(j);
 
 				for (int i = 0; i < amount; i++) {
-					const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+					const GodotCollisionObject3D *col_obj = r_cull_results[i];
 					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 						continue;
 					}
@@ -741,7 +878,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 						continue;
 					}
 
-					int shape_idx = intersection_query_subindex_results[i];
+					int shape_idx = r_cull_subindices[i];
 
 					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin)) {
 						collided = cbk.amount > 0;
@@ -806,7 +943,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		motion_aabb.position += p_parameters.motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		int amount = _cull_aabb_for_body(p_body, motion_aabb, r_cull_results, r_cull_subindices);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_disabled(j)) {
@@ -837,7 +974,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = r_cull_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -845,7 +982,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = r_cull_subindices[i];
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
@@ -946,7 +1083,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
 
 		body_aabb.position += p_parameters.motion * unsafe;
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		int amount = _cull_aabb_for_body(p_body, body_aabb, r_cull_results, r_cull_subindices);
 
 		int from_shape = best_shape != -1 ? best_shape : 0;
 		int to_shape = best_shape != -1 ? best_shape + 1 : p_body->get_shape_count();
@@ -960,7 +1097,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			GodotShape3D *body_shape = p_body->get_shape(j);
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = r_cull_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -968,7 +1105,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = r_cull_subindices[i];
 
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
@@ -1256,11 +1393,179 @@ GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
 
+static _FORCE_INLINE_ uint64_t _hash_real(real_t p_value, uint64_t p_hash) {
+	return hash64_murmur3_64(hash_make_uint64_t(p_value), p_hash);
+}
+
+static _FORCE_INLINE_ uint64_t _hash_vector3(const Vector3 &p_value, uint64_t p_hash) {
+	p_hash = _hash_real(p_value.x, p_hash);
+	p_hash = _hash_real(p_value.y, p_hash);
+	return _hash_real(p_value.z, p_hash);
+}
+
+uint64_t GodotSpace3D::get_state_hash() const {
+	LocalVector<const GodotCollisionObject3D *> sorted_objects;
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY || object->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+			sorted_objects.push_back(object);
+		}
+	}
+	sorted_objects.sort_custom<GodotCollisionObject3D::SelfComparator>();
+
+	// Only the order of the RIDs is used, their values differ between processes.
+	uint64_t hash = HASH_MURMUR3_SEED;
+	for (const GodotCollisionObject3D *object : sorted_objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+			const Transform3D &transform = body->get_transform();
+			hash = _hash_vector3(transform.basis.rows[0], hash);
+			hash = _hash_vector3(transform.basis.rows[1], hash);
+			hash = _hash_vector3(transform.basis.rows[2], hash);
+			hash = _hash_vector3(transform.origin, hash);
+			hash = _hash_vector3(body->get_linear_velocity(), hash);
+			hash = _hash_vector3(body->get_angular_velocity(), hash);
+			hash = hash64_murmur3_64(body->is_active(), hash);
+		} else {
+			const GodotSoftBody3D *soft_body = static_cast<const GodotSoftBody3D *>(object);
+			uint32_t node_count = soft_body->get_node_count();
+			hash = hash64_murmur3_64(node_count, hash);
+			for (uint32_t i = 0; i < node_count; i++) {
+				hash = _hash_vector3(soft_body->get_node_position(i), hash);
+				hash = _hash_vector3(soft_body->get_node_velocity(i), hash);
+			}
+		}
+	}
+
+	return hash;
+}
+
+// Saved states are a header followed by body and pair records, each copied as is from memory.
+// They can only be restored by the same build in the same process, since bodies are found by RID.
+struct SpaceStateHeader3D {
+	uint32_t magic = 0x33535047; // "GPS3"
+	uint32_t body_state_size = sizeof(GodotBody3D::State);
+	uint32_t pair_state_size = sizeof(GodotBodyPair3D::State);
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Can't save the state of a space while it's being stepped.");
+
+	LocalVector<const GodotBody3D *> bodies;
+	LocalVector<const GodotBodyPair3D *> pairs;
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+		bodies.push_back(body);
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			// Pairs are listed by both bodies, only save them once from A.
+			if (E.value == 0 && E.key->is_body_pair()) {
+				pairs.push_back(static_cast<const GodotBodyPair3D *>(E.key));
+			}
+		}
+	}
+
+	SpaceStateHeader3D header;
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(SpaceStateHeader3D) + bodies.size() * sizeof(GodotBody3D::State) + pairs.size() * sizeof(GodotBodyPair3D::State));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(SpaceStateHeader3D));
+	w += sizeof(SpaceStateHeader3D);
+
+	for (const GodotBody3D *body : bodies) {
+		GodotBody3D::State body_state;
+		body->save_state(body_state);
+		memcpy(w, &body_state, sizeof(GodotBody3D::State));
+		w += sizeof(GodotBody3D::State);
+	}
+
+	for (const GodotBodyPair3D *pair : pairs) {
+		GodotBodyPair3D::State pair_state;
+		pair->save_state(pair_state);
+		memcpy(w, &pair_state, sizeof(GodotBodyPair3D::State));
+		w += sizeof(GodotBodyPair3D::State);
+	}
+
+	return state;
+}
+
+void GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_MSG(locked, "Can't restore the state of a space while it's being stepped.");
+	ERR_FAIL_COND_MSG(p_state.size() < (int64_t)sizeof(SpaceStateHeader3D), "Invalid physics space state.");
+
+	const SpaceStateHeader3D expected_header;
+	SpaceStateHeader3D header;
+	const uint8_t *r = p_state.ptr();
+	memcpy(&header, r, sizeof(SpaceStateHeader3D));
+	r += sizeof(SpaceStateHeader3D);
+
+	ERR_FAIL_COND_MSG(header.magic != expected_header.magic || header.body_state_size != expected_header.body_state_size || header.pair_state_size != expected_header.pair_state_size, "Physics space state was saved by a different physics engine or build.");
+	ERR_FAIL_COND_MSG((uint64_t)p_state.size() != sizeof(SpaceStateHeader3D) + (uint64_t)header.body_count * sizeof(GodotBody3D::State) + (uint64_t)header.pair_count * sizeof(GodotBodyPair3D::State), "Invalid physics space state.");
+
+	HashMap<uint64_t, GodotBody3D *> bodies;
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies.insert(object->get_self().get_id(), static_cast<GodotBody3D *>(object));
+		}
+	}
+
+	// Bodies created after the state was saved are left as they are.
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		GodotBody3D::State body_state;
+		memcpy(&body_state, r, sizeof(GodotBody3D::State));
+		r += sizeof(GodotBody3D::State);
+
+		GodotBody3D **body = bodies.getptr(body_state.rid);
+		if (body) {
+			(*body)->restore_state(body_state);
+		}
+	}
+
+	// Create the pairs of the restored positions now, so their contacts can be restored too.
+	broadphase->update();
+
+	for (const KeyValue<uint64_t, GodotBody3D *> &KV : bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : KV.value->get_constraint_map()) {
+			if (E.value == 0 && E.key->is_body_pair()) {
+				static_cast<GodotBodyPair3D *>(E.key)->clear_state();
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		GodotBodyPair3D::State pair_state;
+		memcpy(&pair_state, r, sizeof(GodotBodyPair3D::State));
+		r += sizeof(GodotBodyPair3D::State);
+
+		GodotBody3D **body = bodies.getptr(pair_state.body_A);
+		if (!body) {
+			continue;
+		}
+		for (const KeyValue<GodotConstraint3D *, int> &E : (*body)->get_constraint_map()) {
+			if (E.value == 0 && E.key->is_body_pair()) {
+				GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(E.key);
+				if (pair->matches_state(pair_state)) {
+					pair->restore_state(pair_state);
+					break;
+				}
+			}
+		}
+	}
+}
+
 GodotSpace3D::GodotSpace3D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/3d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/3d/solver/solver_iterations");
+	deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
 	contact_recycle_radius = GLOBAL_GET("physics/3d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
@@ -42,6 +42,44 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Batched queries run in chunks on the WorkerThreadPool, each chunk culling into its own buffers.
+	static constexpr int QUERY_BATCH_CHUNK_SIZE = 32;
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		int count = 0;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct PointBatch {
+		const PointParameters *parameters = nullptr;
+		const Vector3 *points = nullptr;
+		int count = 0;
+		ShapeResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct MotionBatch {
+		GodotShape3D *shape = nullptr;
+		const ShapeParameters *parameters = nullptr;
+		const Vector3 *origins = nullptr;
+		const Vector3 *motions = nullptr;
+		int count = 0;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	int _intersect_point(const PointParameters &p_parameters, const Vector3 &p_position, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const;
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const;
+	void _cast_motion(GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const;
+
+	void _intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch);
+	void _intersect_points_chunk(uint32_t p_chunk, PointBatch *p_batch);
+	void _cast_motions_chunk(uint32_t p_chunk, MotionBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -53,6 +91,10 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector3 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -90,6 +132,7 @@ private:
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
+	bool deterministic = false;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -121,8 +164,9 @@ private:
 	int contact_debug_count = 0;
 
 	friend class GodotPhysicsDirectSpaceState3D;
+	friend class GodotPhysicsServer3D;
 
-	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices);
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
@@ -157,6 +201,7 @@ public:
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
@@ -187,6 +232,11 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	uint64_t get_state_hash() const;
+
+	Vector<uint8_t> save_state() const;
+	void restore_state(const Vector<uint8_t> &p_state);
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -205,7 +255,9 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
-	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
+	// Motion tests cull into the space's own buffers unless buffers of INTERSECTION_QUERY_MAX entries are given,
+	// which lets several tests run at once.
+	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, GodotCollisionObject3D **r_cull_results = nullptr, int *r_cull_subindices = nullptr);
 
 	GodotSpace3D();
 	~GodotSpace3D();
@@ -40,6 +40,8 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+// Below this many active bodies, integration is cheaper than dispatching it to the thread pool.
+#define INTEGRATE_THREADED_MIN_BODIES 64
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +114,46 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_gather_active_bodies(const SelfList<GodotBody3D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+	if (deterministic) {
+		active_bodies.sort_custom<GodotCollisionObject3D::SelfComparator>();
+	}
+}
+
+void GodotStep3D::_gather_active_soft_bodies(const SelfList<GodotSoftBody3D>::List *p_soft_body_list) {
+	active_soft_bodies.clear();
+	const SelfList<GodotSoftBody3D> *sb = p_soft_body_list->first();
+	while (sb) {
+		active_soft_bodies.push_back(sb->self());
+		sb = sb->next();
+	}
+	if (deterministic) {
+		active_soft_bodies.sort_custom<GodotCollisionObject3D::SelfComparator>();
+	}
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -191,6 +233,9 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	// Objects are visited in RID order instead of activation order, and constraints are sorted
+	// within each island, so results only depend on the order objects were created in.
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
 
@@ -201,22 +246,35 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(body_list);
+	int active_count = active_bodies.size();
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task;
+	if (active_bodies.size() >= INTEGRATE_THREADED_MIN_BODIES) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < active_bodies.size(); i++) {
+			_integrate_forces(i);
+		}
+	}
+
+	// The broadphase isn't thread-safe, update it in gathered order so pairs are always found in the same order.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_forces();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
-	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->predict_motion(p_delta);
-		sb = sb->next();
-		active_count++;
+	_gather_active_soft_bodies(soft_body_list);
+	active_count += active_soft_bodies.size();
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DPredictSoftBodyMotion"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Collision shape updates touch the broadphase, so they are done serially.
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		soft_body->finish_predict_motion();
 	}
 
 	p_space->set_active_objects(active_count);
@@ -243,30 +301,37 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				continue;
 			}
 			constraint->set_island_step(_step);
+			area_constraints.push_back(constraint);
+		}
+		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
+	}
 
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
+	if (deterministic) {
+		area_constraints.sort_custom<GodotConstraint3D::SortComparator>();
+	}
 
-			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
+	for (GodotConstraint3D *constraint : area_constraints) {
+		// Each constraint can be on a separate island for areas as there's no solving phase.
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
 		}
-		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
+		LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+
+		all_constraints.push_back(constraint);
+		constraint_island.push_back(constraint);
 	}
+	area_constraints.clear();
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	// Bodies may have been woken up by new pairs.
+	_gather_active_bodies(body_list);
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody3D *body = b->self();
-
+	for (GodotBody3D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -292,17 +357,16 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				constraint_island.sort_custom<GodotConstraint3D::SortComparator>();
 			}
 		}
-		b = b->next();
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
+	_gather_active_soft_bodies(soft_body_list);
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
 		if (soft_body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -328,9 +392,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				constraint_island.sort_custom<GodotConstraint3D::SortComparator>();
 			}
 		}
-		sb = sb->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -344,7 +409,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -375,11 +440,20 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	_gather_active_bodies(body_list);
+
+	if (active_bodies.size() >= INTEGRATE_THREADED_MIN_BODIES) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < active_bodies.size(); i++) {
+			_integrate_velocities(i);
+		}
+	}
+
+	// Bodies can deactivate here, which removes them from the active list.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -390,11 +464,27 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	_gather_active_soft_bodies(soft_body_list);
+
+	// Large soft bodies spread their links over the thread pool from here, the others get one task each.
+	large_soft_bodies.clear();
+	uint32_t small_soft_body_count = 0;
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		if (soft_body->has_parallel_links()) {
+			large_soft_bodies.push_back(soft_body);
+		} else {
+			active_soft_bodies[small_soft_body_count++] = soft_body;
+		}
 	}
+	active_soft_bodies.resize(small_soft_body_count);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSolveSoftBodyConstraints"));
+
+	for (GodotSoftBody3D *soft_body : large_soft_bodies) {
+		soft_body->solve_constraints(p_delta, true);
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
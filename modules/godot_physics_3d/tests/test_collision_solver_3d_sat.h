@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*  test_collision_solver_3d_sat.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COLLISION_SOLVER_3D_SAT_H
+#define TEST_COLLISION_SOLVER_3D_SAT_H
+
+#include "../godot_collision_solver_3d_sat_simd.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/test_macros.h"
+
+namespace TestCollisionSolver3DSAT {
+
+#ifdef SAT_SIMD
+
+// Projects both shapes of a pair on up to four axes the way SeparatorAxisTest::flush_axes() does,
+// and compares every lane with the scalar project_range() of each shape.
+template <typename ShapeA, typename ShapeB>
+static void check_pair_projections(const ShapeA *p_shape_A, const Transform3D &p_transform_A, const ShapeB *p_shape_B, const Transform3D &p_transform_B, const Vector3 *p_axes, int p_count) {
+	Vector3 axes[4];
+	for (int i = 0; i < 4; i++) {
+		// Unused lanes repeat the last axis.
+		axes[i] = p_axes[MIN(i, p_count - 1)];
+	}
+
+	Float4 x = f4_set(axes[0].x, axes[1].x, axes[2].x, axes[3].x);
+	Float4 y = f4_set(axes[0].y, axes[1].y, axes[2].y, axes[3].y);
+	Float4 z = f4_set(axes[0].z, axes[1].z, axes[2].z, axes[3].z);
+
+	Float4 min_A4, max_A4, min_B4, max_B4;
+	SATProjector<ShapeA>::project_range(p_shape_A, p_transform_A, x, y, z, min_A4, max_A4);
+	SATProjector<ShapeB>::project_range(p_shape_B, p_transform_B, x, y, z, min_B4, max_B4);
+
+	float min_A[4], max_A[4], min_B[4], max_B[4];
+	f4_store(min_A, min_A4);
+	f4_store(max_A, max_A4);
+	f4_store(min_B, min_B4);
+	f4_store(max_B, max_B4);
+
+	for (int i = 0; i < p_count; i++) {
+		real_t scalar_min_A, scalar_max_A, scalar_min_B, scalar_max_B;
+		p_shape_A->ShapeA::project_range(axes[i], p_transform_A, scalar_min_A, scalar_max_A);
+		p_shape_B->ShapeB::project_range(axes[i], p_transform_B, scalar_min_B, scalar_max_B);
+
+		CHECK(min_A[i] == doctest::Approx(scalar_min_A).epsilon(1e-4));
+		CHECK(max_A[i] == doctest::Approx(scalar_max_A).epsilon(1e-4));
+		CHECK(min_B[i] == doctest::Approx(scalar_min_B).epsilon(1e-4));
+		CHECK(max_B[i] == doctest::Approx(scalar_max_B).epsilon(1e-4));
+	}
+}
+
+static Transform3D random_transform(RandomPCG &p_rng) {
+	Vector3 rotation_axis = Vector3(p_rng.random(-1.0, 1.0), p_rng.random(-1.0, 1.0), p_rng.random(-1.0, 1.0)).normalized();
+	Basis basis = Basis(rotation_axis, p_rng.random(-Math_PI, Math_PI));
+	basis.scale(Vector3(p_rng.random(0.5, 2.0), p_rng.random(0.5, 2.0), p_rng.random(0.5, 2.0)));
+	return Transform3D(basis, Vector3(p_rng.random(-5.0, 5.0), p_rng.random(-5.0, 5.0), p_rng.random(-5.0, 5.0)));
+}
+
+template <typename ShapeA, typename ShapeB>
+static void check_pair(const ShapeA *p_shape_A, const ShapeB *p_shape_B) {
+	RandomPCG rng(12345);
+	for (int iteration = 0; iteration < 16; iteration++) {
+		const Transform3D transform_A = random_transform(rng);
+		const Transform3D transform_B = random_transform(rng);
+
+		Vector3 axes[4];
+		for (int i = 0; i < 4; i++) {
+			axes[i] = Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), rng.random(-1.0, 1.0)).normalized();
+		}
+		// Axis aligned directions are common separating axes, with zero lanes.
+		axes[iteration % 4] = iteration % 2 ? Vector3(1, 0, 0) : Vector3(0, 0, -1);
+
+		// Full batches, and partial ones as flushed at the end of a test.
+		check_pair_projections(p_shape_A, transform_A, p_shape_B, transform_B, axes, 4);
+		check_pair_projections(p_shape_A, transform_A, p_shape_B, transform_B, axes, 1 + iteration % 3);
+	}
+}
+
+template <typename ShapeA>
+static void check_pairs_with(const ShapeA *p_shape_A, const GodotSphereShape3D *p_sphere, const GodotBoxShape3D *p_box, const GodotCapsuleShape3D *p_capsule, const GodotConvexPolygonShape3D *p_small_convex, const GodotConvexPolygonShape3D *p_large_convex) {
+	check_pair(p_shape_A, p_sphere);
+	check_pair(p_shape_A, p_box);
+	check_pair(p_shape_A, p_capsule);
+	check_pair(p_shape_A, p_small_convex);
+	check_pair(p_shape_A, p_large_convex);
+}
+
+TEST_CASE("[Physics][SAT] Vectorized projections match the scalar ones") {
+	GodotSphereShape3D sphere;
+	sphere.set_data(0.75);
+
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 1.0, 2.0));
+
+	GodotCapsuleShape3D capsule;
+	Dictionary capsule_data;
+	capsule_data["height"] = 3.0;
+	capsule_data["radius"] = 0.5;
+	capsule.set_data(capsule_data);
+
+	// A tetrahedron is projected through its vertices.
+	GodotConvexPolygonShape3D small_convex;
+	small_convex.set_data(PackedVector3Array({ Vector3(0, 1, 0), Vector3(1, -1, 0.5), Vector3(-1, -1, 0.5), Vector3(0, -1, -1) }));
+
+	// A dense sphere is projected through get_support() instead.
+	GodotConvexPolygonShape3D large_convex;
+	PackedVector3Array sphere_points;
+	for (int i = 0; i < 12; i++) {
+		for (int j = 0; j < 24; j++) {
+			const real_t theta = Math_PI * (i + 0.5) / 12;
+			const real_t phi = Math_TAU * j / 24;
+			sphere_points.push_back(Vector3(Math::sin(theta) * Math::cos(phi), Math::cos(theta), Math::sin(theta) * Math::sin(phi)));
+		}
+	}
+	large_convex.set_data(sphere_points);
+	REQUIRE(large_convex.get_mesh().vertices.size() > 3 * large_convex.extreme_vertices.size());
+	REQUIRE(small_convex.get_mesh().vertices.size() <= 3 * small_convex.extreme_vertices.size());
+
+	check_pairs_with(&sphere, &sphere, &box, &capsule, &small_convex, &large_convex);
+	check_pairs_with(&box, &sphere, &box, &capsule, &small_convex, &large_convex);
+	check_pairs_with(&capsule, &sphere, &box, &capsule, &small_convex, &large_convex);
+	check_pairs_with(&small_convex, &sphere, &box, &capsule, &small_convex, &large_convex);
+	check_pairs_with(&large_convex, &sphere, &box, &capsule, &small_convex, &large_convex);
+}
+
+#endif // SAT_SIMD
+
+} // namespace TestCollisionSolver3DSAT
+
+#endif // TEST_COLLISION_SOLVER_3D_SAT_H
@@ -0,0 +1,321 @@
+/**************************************************************************/
+/*  test_concave_shape_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CONCAVE_SHAPE_3D_H
+#define TEST_CONCAVE_SHAPE_3D_H
+
+#include "../godot_shape_3d.h"
+
+#include "core/math/geometry_3d.h"
+#include "core/math/random_pcg.h"
+#include "tests/test_macros.h"
+
+namespace TestConcaveShape3D {
+
+struct CulledFaces {
+	LocalVector<Face3> faces;
+};
+
+static bool collect_face(void *p_userdata, GodotShape3D *p_convex) {
+	const GodotFaceShape3D *face = static_cast<GodotFaceShape3D *>(p_convex);
+	static_cast<CulledFaces *>(p_userdata)->faces.push_back(Face3(face->vertex[0], face->vertex[1], face->vertex[2]));
+	return false;
+}
+
+static int find_face(const PackedVector3Array &p_faces, const Face3 &p_face) {
+	for (int i = 0; i < p_faces.size() / 3; i++) {
+		if (p_faces[i * 3 + 0] == p_face.vertex[0] && p_faces[i * 3 + 1] == p_face.vertex[1] && p_faces[i * 3 + 2] == p_face.vertex[2]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Closest hit along the segment over all the given triangles, the way the shapes report it.
+static bool brute_force_segment(const LocalVector<Face3> &p_faces, const Vector3 &p_begin, const Vector3 &p_end, bool p_hit_back_faces, Vector3 &r_point, int &r_face_index) {
+	const Vector3 dir = (p_end - p_begin).normalized();
+	real_t min_d = 1e20;
+	r_face_index = -1;
+	for (uint32_t i = 0; i < p_faces.size(); i++) {
+		const Face3 &face = p_faces[i];
+		Vector3 point;
+		if (!Geometry3D::segment_intersects_triangle(p_begin, p_end, face.vertex[0], face.vertex[1], face.vertex[2], &point)) {
+			continue;
+		}
+		if (!p_hit_back_faces && face.get_plane().normal.dot(p_end - p_begin) > 0) {
+			continue;
+		}
+		const real_t d = dir.dot(point - p_begin);
+		if (d > 0 && d < min_d) {
+			min_d = d;
+			r_point = point;
+			r_face_index = i;
+		}
+	}
+	return r_face_index >= 0;
+}
+
+TEST_CASE("[Physics] Concave polygon BVH queries match brute force") {
+	RandomPCG rng(1234);
+
+	// Small triangles scattered in a box.
+	const int face_count = 400;
+	PackedVector3Array face_points;
+	LocalVector<Face3> faces;
+	for (int i = 0; i < face_count; i++) {
+		const Vector3 center(rng.random(-10.0, 10.0), rng.random(-10.0, 10.0), rng.random(-10.0, 10.0));
+		Face3 face;
+		for (int j = 0; j < 3; j++) {
+			face.vertex[j] = center + Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), rng.random(-1.0, 1.0));
+			face_points.push_back(face.vertex[j]);
+		}
+		faces.push_back(face);
+	}
+
+	SUBCASE("Culls report every overlapping face once, and only faces near the box") {
+		GodotConcavePolygonShape3D shape;
+		Dictionary data;
+		data["faces"] = face_points;
+		data["backface_collision"] = false;
+		shape.set_data(data);
+
+		// The quantized bounds are rounded outwards by at most one step.
+		const Vector3 step = shape.get_aabb().size / UINT16_MAX;
+
+		int reported = 0;
+		for (int i = 0; i < 200; i++) {
+			const Vector3 position(rng.random(-12.0, 10.0), rng.random(-12.0, 10.0), rng.random(-12.0, 10.0));
+			const AABB query(position, Vector3(rng.random(0.1, 4.0), rng.random(0.1, 4.0), rng.random(0.1, 4.0)));
+
+			CulledFaces culled;
+			shape.cull(query, collect_face, &culled, false);
+			reported += culled.faces.size();
+
+			LocalVector<int> counts;
+			counts.resize(face_count);
+			for (int &count : counts) {
+				count = 0;
+			}
+			for (const Face3 &face : culled.faces) {
+				const int index = find_face(face_points, face);
+				REQUIRE(index >= 0);
+				counts[index]++;
+				CHECK(face.get_aabb().intersects(query.grow(2.0 * step.length())));
+			}
+			int missed = 0;
+			int duplicated = 0;
+			for (int j = 0; j < face_count; j++) {
+				if (counts[j] > 1) {
+					duplicated++;
+				} else if (counts[j] == 0 && faces[j].get_aabb().intersects(query)) {
+					missed++;
+				}
+			}
+			CHECK(missed == 0);
+			CHECK(duplicated == 0);
+		}
+		CHECK(reported > 0);
+	}
+
+	SUBCASE("Segments hit the closest face") {
+		for (int backface_collision = 0; backface_collision < 2; backface_collision++) {
+			GodotConcavePolygonShape3D shape;
+			Dictionary data;
+			data["faces"] = face_points;
+			data["backface_collision"] = backface_collision == 1;
+			shape.set_data(data);
+
+			int hits = 0;
+			for (int i = 0; i < 300; i++) {
+				const Vector3 begin(rng.random(-12.0, 12.0), rng.random(-12.0, 12.0), rng.random(-12.0, 12.0));
+				Vector3 end(rng.random(-12.0, 12.0), rng.random(-12.0, 12.0), rng.random(-12.0, 12.0));
+				if (i % 10 == 0) {
+					// Axis aligned segments have a flat direction on the other axes.
+					end = Vector3(begin.x, begin.y, end.z);
+				}
+
+				Vector3 expected_point;
+				int expected_face = -1;
+				const bool expected_hit = brute_force_segment(faces, begin, end, backface_collision == 1, expected_point, expected_face);
+
+				Vector3 point;
+				Vector3 normal;
+				int face_index = -1;
+				const bool hit = shape.intersect_segment(begin, end, point, normal, face_index, true);
+
+				CHECK(hit == expected_hit);
+				if (hit && expected_hit) {
+					hits++;
+					CHECK(face_index == expected_face);
+					CHECK(point.is_equal_approx(expected_point));
+					CHECK(normal.dot(end - begin) <= 0);
+				}
+			}
+			CHECK(hits > 0);
+		}
+	}
+}
+
+struct HeightMap {
+	int width = 0;
+	int depth = 0;
+	Vector<real_t> heights;
+
+	Vector3 get_point(int p_x, int p_z) const {
+		return Vector3(p_x - 0.5 * (width - 1), heights[p_z * width + p_x], p_z - 0.5 * (depth - 1));
+	}
+
+	// Same split as the shape: the first triangle of a cell holds its (x, z) corner.
+	Face3 get_face(int p_x, int p_z, int p_triangle) const {
+		if (p_triangle == 0) {
+			return Face3(get_point(p_x, p_z), get_point(p_x + 1, p_z), get_point(p_x, p_z + 1));
+		}
+		return Face3(get_point(p_x + 1, p_z), get_point(p_x + 1, p_z + 1), get_point(p_x, p_z + 1));
+	}
+
+	int get_face_key(const Face3 &p_face) const {
+		const Vector3 center = (p_face.vertex[0] + p_face.vertex[1] + p_face.vertex[2]) / 3.0 + Vector3(0.5 * (width - 1), 0.0, 0.5 * (depth - 1));
+		const int x = Math::floor(center.x);
+		const int z = Math::floor(center.z);
+		const int triangle = (center.x - x) + (center.z - z) < 1.0 ? 0 : 1;
+		return (z * (width - 1) + x) * 2 + triangle;
+	}
+};
+
+TEST_CASE("[Physics] Heightmap min/max pyramid queries match brute force") {
+	RandomPCG rng(4321);
+
+	// Not a multiple of the chunk size, so the last chunks and pyramid nodes are partial.
+	HeightMap map;
+	map.width = 77;
+	map.depth = 61;
+	map.heights.resize(map.width * map.depth);
+	for (int z = 0; z < map.depth; z++) {
+		for (int x = 0; x < map.width; x++) {
+			// Hills with some noise, so that chunks have different ranges.
+			map.heights.write[z * map.width + x] = 3.0 * Math::sin(x * 0.15) * Math::cos(z * 0.2) + rng.random(-0.5, 0.5);
+		}
+	}
+
+	GodotHeightMapShape3D shape;
+	Dictionary data;
+	data["width"] = map.width;
+	data["depth"] = map.depth;
+	data["heights"] = map.heights;
+	shape.set_data(data);
+	REQUIRE(shape.bounds_levels.size() > 2);
+
+	LocalVector<Face3> faces;
+	for (int z = 0; z < map.depth - 1; z++) {
+		for (int x = 0; x < map.width - 1; x++) {
+			faces.push_back(map.get_face(x, z, 0));
+			faces.push_back(map.get_face(x, z, 1));
+		}
+	}
+
+	SUBCASE("Culls report every overlapping face once, and skip cells above or below the box") {
+		int reported = 0;
+		for (int i = 0; i < 300; i++) {
+			const Vector3 position(rng.random(-40.0, 36.0), rng.random(-5.0, 4.0), rng.random(-32.0, 28.0));
+			const AABB query(position, Vector3(rng.random(0.5, 6.0), rng.random(0.2, 2.0), rng.random(0.5, 6.0)));
+
+			CulledFaces culled;
+			shape.cull(query, collect_face, &culled, false);
+			reported += culled.faces.size();
+
+			LocalVector<int> counts;
+			counts.resize(faces.size());
+			for (int &count : counts) {
+				count = 0;
+			}
+			for (const Face3 &face : culled.faces) {
+				const int key = map.get_face_key(face);
+				REQUIRE(key >= 0);
+				REQUIRE(key < (int)faces.size());
+				counts[key]++;
+				CHECK(face.get_aabb().is_equal_approx(faces[key].get_aabb()));
+
+				// Both triangles of a cell are skipped unless its heights reach the box.
+				const int cell = key / 2;
+				const AABB cell_aabb = faces[cell * 2].get_aabb().merge(faces[cell * 2 + 1].get_aabb());
+				CHECK(cell_aabb.position.y <= query.position.y + query.size.y);
+				CHECK(cell_aabb.position.y + cell_aabb.size.y >= query.position.y);
+			}
+			int missed = 0;
+			int duplicated = 0;
+			for (uint32_t j = 0; j < faces.size(); j++) {
+				if (counts[j] > 1) {
+					duplicated++;
+				} else if (counts[j] == 0 && faces[j].get_aabb().intersects(query)) {
+					missed++;
+				}
+			}
+			CHECK(missed == 0);
+			CHECK(duplicated == 0);
+		}
+		CHECK(reported > 0);
+	}
+
+	SUBCASE("Segments hit the closest face") {
+		int hits = 0;
+		int misses = 0;
+		for (int i = 0; i < 300; i++) {
+			const Vector3 begin(rng.random(-38.0, 38.0), rng.random(4.0, 6.0), rng.random(-30.0, 30.0));
+			// Long rays go through the pyramid, short ones through the grid or a single cell.
+			const real_t length = (i % 3 == 0) ? rng.random(0.1, 8.0) : rng.random(20.0, 80.0);
+			const real_t angle = rng.random(0.0, Math_TAU);
+			const Vector3 end = begin + Vector3(Math::cos(angle) * length, rng.random(-12.0, -1.0), Math::sin(angle) * length);
+
+			Vector3 expected_point;
+			int expected_face = -1;
+			const bool expected_hit = brute_force_segment(faces, begin, end, false, expected_point, expected_face);
+
+			Vector3 point;
+			Vector3 normal;
+			int face_index = -1;
+			const bool hit = shape.intersect_segment(begin, end, point, normal, face_index, false);
+
+			CHECK(hit == expected_hit);
+			if (hit && expected_hit) {
+				hits++;
+				// Long rays are clipped to the chunks before testing faces, which moves the hit slightly.
+				CHECK(point.distance_to(expected_point) < 1e-3);
+			} else if (!expected_hit) {
+				misses++;
+			}
+		}
+		CHECK(hits > 0);
+		CHECK(misses > 0);
+	}
+}
+
+} // namespace TestConcaveShape3D
+
+#endif // TEST_CONCAVE_SHAPE_3D_H
@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  test_soft_body_3d.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SOFT_BODY_3D_H
+#define TEST_SOFT_BODY_3D_H
+
+#include "../godot_soft_body_3d.h"
+
+#include "servers/rendering_server.h"
+#include "tests/test_macros.h"
+
+namespace TestSoftBody3D {
+
+// A flat square cloth of p_size by p_size vertices.
+static RID create_cloth_mesh(int p_size) {
+	PackedVector3Array vertices;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			vertices.push_back(Vector3(x * 0.1, 0.0, z * 0.1));
+		}
+	}
+
+	PackedInt32Array indices;
+	for (int z = 0; z < p_size - 1; z++) {
+		for (int x = 0; x < p_size - 1; x++) {
+			const int i = z * p_size + x;
+			indices.append_array({ i, i + 1, i + p_size, i + 1, i + p_size + 1, i + p_size });
+		}
+	}
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_INDEX] = indices;
+
+	RID mesh = RS::get_singleton()->mesh_create();
+	RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+	return mesh;
+}
+
+// Pushes every node in a different direction, so that the links have to pull them back together.
+static void shake(GodotSoftBody3D &p_soft_body) {
+	for (uint32_t i = 0; i < p_soft_body.get_node_count(); i++) {
+		const Vector3 velocity = Vector3(Math::sin(i * 1.0), Math::cos(i * 0.7), Math::sin(i * 1.3)) * 0.5;
+		p_soft_body.apply_node_impulse(i, velocity / p_soft_body.get_node_inv_mass(i));
+	}
+}
+
+static void check_parallel_matches_serial(int p_size, bool p_parallel_links) {
+	RID mesh = create_cloth_mesh(p_size);
+
+	GodotSoftBody3D serial_soft_body;
+	GodotSoftBody3D parallel_soft_body;
+	serial_soft_body.set_mesh(mesh);
+	parallel_soft_body.set_mesh(mesh);
+	REQUIRE(serial_soft_body.get_node_count() == uint32_t(p_size * p_size));
+	CHECK(parallel_soft_body.has_parallel_links() == p_parallel_links);
+
+	shake(serial_soft_body);
+	shake(parallel_soft_body);
+
+	const real_t delta = 1.0 / 60.0;
+	for (int step = 0; step < 5; step++) {
+		serial_soft_body.solve_constraints(delta, false);
+		parallel_soft_body.solve_constraints(delta, true);
+	}
+
+	// Links of a batch share no nodes, so splitting batches over threads can't change the result.
+	int moved = 0;
+	int different = 0;
+	for (uint32_t i = 0; i < serial_soft_body.get_node_count(); i++) {
+		const Vector3 position = serial_soft_body.get_node_position(i);
+		if (position != Vector3((i % p_size) * 0.1, 0.0, (i / p_size) * 0.1)) {
+			moved++;
+		}
+		if (position != parallel_soft_body.get_node_position(i)) {
+			different++;
+		}
+	}
+	CHECK(moved > 0);
+	CHECK(different == 0);
+
+	RS::get_singleton()->free(mesh);
+}
+
+TEST_CASE("[SceneTree][Physics] Soft body links solve the same in parallel and serially") {
+	SUBCASE("Small soft body") {
+		// Too few links to be split, asking for a parallel solve falls back to the serial one.
+		check_parallel_matches_serial(8, false);
+	}
+
+	SUBCASE("Large soft body") {
+		check_parallel_matches_serial(40, true);
+	}
+}
+
+} // namespace TestSoftBody3D
+
+#endif // TEST_SOFT_BODY_3D_H
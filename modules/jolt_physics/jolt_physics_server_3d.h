@@ -162,6 +162,9 @@ public:
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual PackedVector3Array space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
+	virtual uint64_t space_get_state_hash(RID p_space) const override;
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) override;
 
 	virtual RID area_create() override;
 
@@ -37,8 +37,6 @@
 #include "core/os/os.h"
 #include "core/os/time.h"
 
-#include "Jolt/Physics/PhysicsSettings.h"
-
 void JoltJobSystem::Job::_execute(void *p_user_data) {
 	Job *job = static_cast<Job *>(p_user_data);
 
@@ -107,6 +105,139 @@ void JoltJobSystem::Job::queue() {
 	task_id = WorkerThreadPool::get_singleton()->add_native_task(&_execute, this, true, task_name);
 }
 
+void JoltJobSystem::Barrier::_add_job(JPH::JobSystem::Job *p_job, bool &r_executable) {
+	// This fails if the job has already finished, in which case there's nothing to wait for.
+	if (!p_job->SetBarrier(this)) {
+		return;
+	}
+
+	p_job->AddRef();
+
+	jobs_lock.lock();
+	jobs.push_back(p_job);
+	pending_job_count.fetch_add(1);
+	jobs_lock.unlock();
+
+	r_executable = r_executable || p_job->CanBeExecuted();
+}
+
+void JoltJobSystem::Barrier::_signal() {
+	jobs_lock.lock();
+	const bool was_waiting = waiting;
+	const WorkerThreadPool::TaskID task_id = waiting_task_id;
+	waiting = false;
+	jobs_lock.unlock();
+
+	if (!was_waiting) {
+		return;
+	}
+
+	if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+	} else {
+		semaphore.post();
+	}
+}
+
+void JoltJobSystem::Barrier::OnJobFinished(JPH::JobSystem::Job *p_job) {
+	_signal();
+
+	// This must be the last thing we touch, since the barrier can be reused as soon as this reaches zero.
+	pending_job_count.fetch_sub(1);
+}
+
+void JoltJobSystem::Barrier::AddJob(const JPH::JobHandle &p_job) {
+	bool executable = false;
+	_add_job(p_job.GetPtr(), executable);
+
+	// Let the waiting thread pick up the job rather than wait for a worker thread to do so.
+	if (executable) {
+		_signal();
+	}
+}
+
+void JoltJobSystem::Barrier::AddJobs(const JPH::JobHandle *p_jobs, JPH::uint p_job_count) {
+	bool executable = false;
+
+	for (JPH::uint i = 0; i < p_job_count; ++i) {
+		_add_job(p_jobs[i].GetPtr(), executable);
+	}
+
+	if (executable) {
+		_signal();
+	}
+}
+
+void JoltJobSystem::Barrier::wait() {
+	const WorkerThreadPool::TaskID caller_task_id = WorkerThreadPool::get_caller_task_id();
+
+	while (true) {
+		JPH::JobSystem::Job *job_to_execute = nullptr;
+		bool has_unfinished_jobs = false;
+
+		jobs_lock.lock();
+
+		while (first_unreleased_job < jobs.size() && jobs[first_unreleased_job]->IsDone()) {
+			jobs[first_unreleased_job++]->Release();
+		}
+
+		for (uint32_t i = first_unreleased_job; i < jobs.size(); ++i) {
+			JPH::JobSystem::Job *job = jobs[i];
+
+			if (job->IsDone()) {
+				continue;
+			}
+
+			has_unfinished_jobs = true;
+
+			if (job->CanBeExecuted()) {
+				job_to_execute = job;
+				break;
+			}
+		}
+
+		// Decided under the same lock as the checks above, so a job finishing right after them still wakes us up.
+		waiting = has_unfinished_jobs && job_to_execute == nullptr;
+		waiting_task_id = caller_task_id;
+
+		jobs_lock.unlock();
+
+		if (job_to_execute != nullptr) {
+			// This does nothing if a worker thread got to the job first.
+			job_to_execute->Execute();
+			continue;
+		}
+
+		if (!has_unfinished_jobs) {
+			if (pending_job_count.load() == 0) {
+				break;
+			}
+
+			// A job is done but is still signaling us, which takes no time at all.
+			continue;
+		}
+
+		if (caller_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->yield();
+
+			// Something else may have ended the yield, in which case no job has signaled us yet and none should.
+			jobs_lock.lock();
+			waiting = false;
+			jobs_lock.unlock();
+		} else {
+			semaphore.wait();
+		}
+	}
+
+	// Jobs that finished after the release loop above still hold the reference we added.
+	for (uint32_t i = first_unreleased_job; i < jobs.size(); ++i) {
+		jobs[i]->Release();
+	}
+
+	jobs.clear();
+	first_unreleased_job = 0;
+}
+
 int JoltJobSystem::GetMaxConcurrency() const {
 	return thread_count;
 }
@@ -153,6 +284,25 @@ void JoltJobSystem::FreeJob(JPH::JobSystem::Job *p_job) {
 	Job::push_completed(static_cast<Job *>(p_job));
 }
 
+JPH::JobSystem::Barrier *JoltJobSystem::CreateBarrier() {
+	for (Barrier &barrier : barriers) {
+		bool expected = false;
+		if (barrier.in_use.compare_exchange_strong(expected, true)) {
+			return &barrier;
+		}
+	}
+
+	ERR_FAIL_V_MSG(nullptr, "Jolt Physics job system exceeded the maximum number of barriers. This should not happen. Please report this.");
+}
+
+void JoltJobSystem::DestroyBarrier(JPH::JobSystem::Barrier *p_barrier) {
+	static_cast<Barrier *>(p_barrier)->in_use.store(false);
+}
+
+void JoltJobSystem::WaitForJobs(JPH::JobSystem::Barrier *p_barrier) {
+	static_cast<Barrier *>(p_barrier)->wait();
+}
+
 void JoltJobSystem::_reclaim_jobs() {
 	while (Job *job = Job::pop_completed()) {
 		jobs.DestructObject(job);
@@ -160,34 +310,73 @@ void JoltJobSystem::_reclaim_jobs() {
 }
 
 JoltJobSystem::JoltJobSystem() :
-		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers),
 		thread_count(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count())) {
 	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
 }
 
 void JoltJobSystem::pre_step() {
-	// Nothing to do.
+#ifdef DEBUG_ENABLED
+	step_start_time = Time::get_singleton()->get_ticks_usec();
+#endif
 }
 
 void JoltJobSystem::post_step() {
 	_reclaim_jobs();
+
+#ifdef DEBUG_ENABLED
+	step_time += Time::get_singleton()->get_ticks_usec() - step_start_time;
+#endif
 }
 
 #ifdef DEBUG_ENABLED
 
+JoltJobSystem::StepPhase JoltJobSystem::_get_job_phase(const char *p_job_name) {
+	if (strncmp(p_job_name, "UpdateBroadPhase", 16) == 0) {
+		return STEP_PHASE_BROAD_PHASE;
+	} else if (strcmp(p_job_name, "FindCollisions") == 0) {
+		return STEP_PHASE_NARROW_PHASE;
+	} else if (strcmp(p_job_name, "FindCCDContacts") == 0 || strcmp(p_job_name, "ResolveCCDContacts") == 0) {
+		return STEP_PHASE_CCD;
+	} else if (strncmp(p_job_name, "SoftBody", 8) == 0) {
+		return STEP_PHASE_SOFT_BODIES;
+	}
+
+	// Everything else is part of building, solving and integrating islands.
+	return STEP_PHASE_SOLVER;
+}
+
 void JoltJobSystem::flush_timings() {
 	static const StringName profiler_name("servers");
 
 	EngineDebugger *engine_debugger = EngineDebugger::get_singleton();
 
 	if (engine_debugger->is_profiling(profiler_name)) {
-		Array timings;
+		static const char *phase_names[STEP_PHASE_MAX] = {
+			"broad_phase",
+			"narrow_phase",
+			"solver",
+			"ccd",
+			"soft_bodies",
+		};
+
+		// These are the time spent in jobs of each phase summed over all threads, and so can add up to more than the step itself.
+		uint64_t phase_timings[STEP_PHASE_MAX] = {};
 
 		for (const KeyValue<const void *, uint64_t> &E : timings_by_job) {
-			timings.push_back(static_cast<const char *>(E.key));
-			timings.push_back(USEC_TO_SEC(E.value));
+			phase_timings[_get_job_phase(static_cast<const char *>(E.key))] += E.value;
 		}
 
+		Array timings;
+		timings.resize(STEP_PHASE_MAX * 2);
+
+		for (int i = 0; i < STEP_PHASE_MAX; i++) {
+			timings[i * 2 + 0] = phase_names[i];
+			timings[i * 2 + 1] = USEC_TO_SEC(phase_timings[i]);
+		}
+
+		timings.push_back("step");
+		timings.push_back(USEC_TO_SEC(step_time));
+
 		timings.push_front("physics_3d");
 
 		engine_debugger->profiler_add_frame_data(profiler_name, timings);
@@ -196,6 +385,8 @@ void JoltJobSystem::flush_timings() {
 	for (KeyValue<const void *, uint64_t> &E : timings_by_job) {
 		E.value = 0;
 	}
+
+	step_time = 0;
 }
 
 #endif
@@ -31,18 +31,22 @@
 #ifndef JOLT_JOB_SYSTEM_H
 #define JOLT_JOB_SYSTEM_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/semaphore.h"
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 #include "Jolt/Jolt.h"
 
 #include "Jolt/Core/FixedSizeFreeList.h"
-#include "Jolt/Core/JobSystemWithBarrier.h"
+#include "Jolt/Core/JobSystem.h"
+#include "Jolt/Physics/PhysicsSettings.h"
 
 #include <stdint.h>
 #include <atomic>
 
-class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+class JoltJobSystem final : public JPH::JobSystem {
 	class Job : public JPH::JobSystem::Job {
 		inline static std::atomic<Job *> completed_head = nullptr;
 
@@ -71,16 +75,57 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 		Job &operator=(Job &&p_other) = delete;
 	};
 
+	// Unlike the barrier in `JPH::JobSystemWithBarrier`, waiting on this from a worker thread yields to other tasks
+	// in the pool instead of blocking the thread, which matters when the space is stepped from within a task.
+	class Barrier final : public JPH::JobSystem::Barrier {
+		LocalVector<JPH::JobSystem::Job *> jobs;
+		uint32_t first_unreleased_job = 0;
+		SpinLock jobs_lock;
+
+		std::atomic<uint32_t> pending_job_count = 0;
+		// Both guarded by `jobs_lock`. Jobs only wake the waiting thread while it's about to block, and only once each
+		// time it does, so they don't leave a wakeup behind for a later `yield()` or semaphore wait.
+		WorkerThreadPool::TaskID waiting_task_id = WorkerThreadPool::INVALID_TASK_ID;
+		bool waiting = false;
+		Semaphore semaphore;
+
+		void _add_job(JPH::JobSystem::Job *p_job, bool &r_executable);
+		void _signal();
+
+		virtual void OnJobFinished(JPH::JobSystem::Job *p_job) override;
+
+	public:
+		std::atomic<bool> in_use = false;
+
+		virtual void AddJob(const JPH::JobHandle &p_job) override;
+		virtual void AddJobs(const JPH::JobHandle *p_jobs, JPH::uint p_job_count) override;
+
+		void wait();
+	};
+
 #ifdef DEBUG_ENABLED
+	enum StepPhase {
+		STEP_PHASE_BROAD_PHASE,
+		STEP_PHASE_NARROW_PHASE,
+		STEP_PHASE_SOLVER,
+		STEP_PHASE_CCD,
+		STEP_PHASE_SOFT_BODIES,
+		STEP_PHASE_MAX,
+	};
+
 	// We use `const void*` here to avoid the cost of hashing the actual string, since the job names
 	// are always literals and as such will point to the same address every time.
 	inline static HashMap<const void *, uint64_t> timings_by_job;
 
 	// TODO: Check whether the usage of SpinLock is justified or if this should be a mutex instead.
 	inline static SpinLock timings_lock;
+
+	uint64_t step_start_time = 0;
+	uint64_t step_time = 0;
 #endif
 
 	JPH::FixedSizeFreeList<Job> jobs;
+	Barrier barriers[JPH::cMaxPhysicsBarriers];
 
 	int thread_count = 0;
 
@@ -91,8 +136,16 @@ class JoltJobSystem final : public JPH::JobSystemWithBarrier {
 	virtual void QueueJobs(JPH::JobSystem::Job **p_jobs, JPH::uint p_job_count) override;
 	virtual void FreeJob(JPH::JobSystem::Job *p_job) override;
 
+	virtual JPH::JobSystem::Barrier *CreateBarrier() override;
+	virtual void DestroyBarrier(JPH::JobSystem::Barrier *p_barrier) override;
+	virtual void WaitForJobs(JPH::JobSystem::Barrier *p_barrier) override;
+
 	void _reclaim_jobs();
 
+#ifdef DEBUG_ENABLED
+	static StepPhase _get_job_phase(const char *p_job_name);
+#endif
+
 public:
 	JoltJobSystem();
 
@@ -43,6 +43,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "Jolt/Geometry/GJKClosestPoint.h"
 #include "Jolt/Physics/Body/Body.h"
 #include "Jolt/Physics/Body/BodyFilter.h"
@@ -399,7 +401,7 @@ bool JoltPhysicsDirectSpaceState3D::_body_motion_collide(const JoltBody3D &p_bod
 	return count > 0;
 }
 
-int JoltPhysicsDirectSpaceState3D::_try_get_face_index(const JPH::Body &p_body, const JPH::SubShapeID &p_sub_shape_id) {
+int JoltPhysicsDirectSpaceState3D::_try_get_face_index(const JPH::Body &p_body, const JPH::SubShapeID &p_sub_shape_id) const {
 	if (!JoltProjectSettings::enable_ray_cast_face_index()) {
 		return -1;
 	}
@@ -468,15 +470,9 @@ JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_spac
 		space(p_space) {
 }
 
-bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
-
-	space->try_optimize();
-
-	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
-
-	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
-	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray_impl(const RayParameters &p_parameters, const JoltQueryFilter3D &p_query_filter, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result) const {
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
 	const JPH::Vec3 vector = JPH::Vec3(to - from);
 	const JPH::RRayCast ray(from, vector);
 
@@ -487,7 +483,7 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	settings.mBackFaceModeTriangles = back_face_mode;
 
 	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
-	space->get_narrow_phase_query().CastRay(ray, settings, collector, query_filter, query_filter, query_filter);
+	space->get_narrow_phase_query().CastRay(ray, settings, collector, p_query_filter, p_query_filter, p_query_filter);
 
 	if (!collector.had_hit()) {
 		return false;
@@ -532,18 +528,18 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
-int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
-
-	if (p_result_max == 0) {
-		return 0;
-	}
+bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
 
 	space->try_optimize();
 
-	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+	return _intersect_ray_impl(p_parameters, query_filter, p_parameters.from, p_parameters.to, r_result);
+}
+
+int JoltPhysicsDirectSpaceState3D::_intersect_point_impl(const JoltQueryFilter3D &p_query_filter, const Vector3 &p_position, ShapeResult *r_results, int p_result_max) const {
 	JoltQueryCollectorAnyMulti<JPH::CollidePointCollector, 32> collector(p_result_max);
-	space->get_narrow_phase_query().CollidePoint(to_jolt_r(p_parameters.position), collector, query_filter, query_filter, query_filter);
+	space->get_narrow_phase_query().CollidePoint(to_jolt_r(p_position), collector, p_query_filter, p_query_filter, p_query_filter);
 
 	const int hit_count = collector.get_hit_count();
 
@@ -572,6 +568,19 @@ int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_para
 	return hit_count;
 }
 
+int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
+
+	if (p_result_max == 0) {
+		return 0;
+	}
+
+	space->try_optimize();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+	return _intersect_point_impl(query_filter, p_parameters.position, r_results, p_result_max);
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
 
@@ -881,6 +890,150 @@ Vector3 JoltPhysicsDirectSpaceState3D::get_closest_point_to_object_volume(RID p_
 	}
 }
 
+void JoltPhysicsDirectSpaceState3D::_intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	const int from = (int)p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	const int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (int i = from; i < to; ++i) {
+		p_batch->hits[i] = _intersect_ray_impl(*p_batch->parameters, *p_batch->query_filter, p_batch->from[i], p_batch->to[i], p_batch->results[i]);
+	}
+}
+
+void JoltPhysicsDirectSpaceState3D::_intersect_points_chunk(uint32_t p_chunk, PointBatch *p_batch) {
+	const int from = (int)p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	const int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (int i = from; i < to; ++i) {
+		p_batch->hits[i] = _intersect_point_impl(*p_batch->query_filter, p_batch->points[i], &p_batch->results[i], 1) > 0;
+	}
+}
+
+void JoltPhysicsDirectSpaceState3D::_cast_motions_chunk(uint32_t p_chunk, MotionBatch *p_batch) {
+	const int from = (int)p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	const int to = MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	const bool use_edge_removal = JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries();
+
+	for (int i = from; i < to; ++i) {
+		Transform3D transform = p_batch->transform;
+		transform.origin = p_batch->origins[i];
+		const Transform3D transform_com = transform.translated_local(p_batch->com_scaled);
+
+		_cast_motion_impl(*p_batch->jolt_shape, transform_com, p_batch->scale, p_batch->motions[i], use_edge_removal, true, *p_batch->settings, *p_batch->query_filter, *p_batch->query_filter, *p_batch->query_filter, JPH::ShapeFilter(), p_batch->closest_safe[i], p_batch->closest_unsafe[i]);
+	}
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_rays must not be called while the physics space is being stepped.");
+
+	// Anything that mutates the space has to happen here, before the queries fan out.
+	space->try_optimize();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_intersect_rays_chunk(i, &batch);
+		}
+		return;
+	}
+
+	const WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_rays_chunk, &batch, chunk_count, -1, true, SNAME("JoltIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_points(const PointParameters &p_parameters, const Vector3 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_points must not be called while the physics space is being stepped.");
+
+	space->try_optimize();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	PointBatch batch;
+	batch.query_filter = &query_filter;
+	batch.points = p_points;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_intersect_points_chunk(i, &batch);
+		}
+		return;
+	}
+
+	const WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_points_chunk, &batch, chunk_count, -1, true, SNAME("JoltIntersectPoints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void JoltPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; ++i) {
+		r_closest_safe[i] = 1.0f;
+		r_closest_unsafe[i] = 1.0f;
+	}
+
+	ERR_FAIL_COND_MSG(space->is_stepping(), "cast_motions must not be called while the physics space is being stepped.");
+
+	space->try_optimize();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL(jolt_shape);
+
+	Transform3D transform = p_parameters.transform;
+	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "cast_motions was passed an invalid transform.");
+
+	Vector3 scale = transform.basis.get_scale();
+	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "cast_motions was passed an invalid transform.");
+
+	transform.basis.orthonormalize();
+
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = (float)p_parameters.margin;
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	MotionBatch batch;
+	batch.jolt_shape = jolt_shape;
+	batch.query_filter = &query_filter;
+	batch.settings = &settings;
+	batch.transform = transform;
+	batch.scale = scale;
+	batch.com_scaled = to_godot(jolt_shape->GetCenterOfMass());
+	batch.origins = p_origins;
+	batch.motions = p_motions;
+	batch.count = p_count;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+
+	if (chunk_count <= 1) {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_cast_motions_chunk(i, &batch);
+		}
+		return;
+	}
+
+	const WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_cast_motions_chunk, &batch, chunk_count, -1, true, SNAME("JoltCastMotions"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool JoltPhysicsDirectSpaceState3D::body_test_motion(const JoltBody3D &p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) const {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "body_test_motion (maybe from move_and_slide?) must not be called while the physics space is being stepped.");
 
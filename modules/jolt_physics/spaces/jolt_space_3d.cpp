@@ -49,6 +49,7 @@
 #include "core/variant/variant_utility.h"
 
 #include "Jolt/Physics/PhysicsScene.h"
+#include "Jolt/Physics/StateRecorder.h"
 
 namespace {
 
@@ -60,6 +61,42 @@ constexpr double DEFAULT_SLEEP_THRESHOLD_LINEAR = 0.1;
 constexpr double DEFAULT_SLEEP_THRESHOLD_ANGULAR = 8.0 * Math_PI / 180;
 constexpr double DEFAULT_SOLVER_ITERATIONS = 8;
 
+// Keeps the state in one flat buffer rather than the stringstream used by `JPH::StateRecorderImpl`.
+class JoltStateRecorder3D final : public JPH::StateRecorder {
+	LocalVector<uint8_t> data;
+	uint32_t read_offset = 0;
+	bool failed = false;
+
+public:
+	JoltStateRecorder3D() = default;
+
+	explicit JoltStateRecorder3D(const Vector<uint8_t> &p_data) {
+		data.resize(p_data.size());
+		memcpy(data.ptr(), p_data.ptr(), p_data.size());
+	}
+
+	virtual void WriteBytes(const void *p_data, size_t p_bytes) override {
+		const uint32_t offset = data.size();
+		data.resize(offset + (uint32_t)p_bytes);
+		memcpy(data.ptr() + offset, p_data, p_bytes);
+	}
+
+	virtual void ReadBytes(void *p_data, size_t p_bytes) override {
+		if (failed || read_offset + p_bytes > data.size()) {
+			failed = true;
+			memset(p_data, 0, p_bytes);
+			return;
+		}
+		memcpy(p_data, data.ptr() + read_offset, p_bytes);
+		read_offset += (uint32_t)p_bytes;
+	}
+
+	virtual bool IsEOF() const override { return read_offset >= data.size(); }
+	virtual bool IsFailed() const override { return failed; }
+
+	Vector<uint8_t> get_data() const { return data; }
+};
+
 } // namespace
 
 void JoltSpace3D::_pre_step(float p_step) {
@@ -330,6 +367,52 @@ JoltPhysicsDirectSpaceState3D *JoltSpace3D::get_direct_state() {
 	return direct_state;
 }
 
+Vector<uint8_t> JoltSpace3D::save_state() const {
+	ERR_FAIL_COND_V_MSG(stepping, Vector<uint8_t>(), "Can't save the state of a space while it's being stepped.");
+
+	JoltStateRecorder3D recorder;
+	physics_system->SaveState(recorder);
+	return recorder.get_data();
+}
+
+void JoltSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_MSG(stepping, "Can't restore the state of a space while it's being stepped.");
+
+	JoltStateRecorder3D recorder(p_state);
+	const bool restored = physics_system->RestoreState(recorder);
+	ERR_FAIL_COND_MSG(!restored || recorder.IsFailed(), "Failed to restore physics space state. Bodies and joints must be the same as when the state was saved.");
+}
+
+uint64_t JoltSpace3D::get_state_hash() const {
+	// Bodies come back ordered by index, which only depends on the order they were added and removed in.
+	JPH::BodyIDVector body_ids;
+	physics_system->GetBodies(body_ids);
+
+	const JPH::BodyInterface &body_iface = get_body_iface();
+
+	uint64_t hash = HASH_MURMUR3_SEED;
+	for (const JPH::BodyID &body_id : body_ids) {
+		const JPH::RVec3 position = body_iface.GetPosition(body_id);
+		const JPH::Quat rotation = body_iface.GetRotation(body_id);
+		const JPH::Vec3 linear_velocity = body_iface.GetLinearVelocity(body_id);
+		const JPH::Vec3 angular_velocity = body_iface.GetAngularVelocity(body_id);
+
+		const JPH::Real values[13] = {
+			position.GetX(), position.GetY(), position.GetZ(),
+			rotation.GetX(), rotation.GetY(), rotation.GetZ(), rotation.GetW(),
+			linear_velocity.GetX(), linear_velocity.GetY(), linear_velocity.GetZ(),
+			angular_velocity.GetX(), angular_velocity.GetY(), angular_velocity.GetZ()
+		};
+
+		for (const JPH::Real value : values) {
+			hash = hash64_murmur3_64(hash_make_uint64_t(value), hash);
+		}
+		hash = hash64_murmur3_64(body_iface.IsActive(body_id), hash);
+	}
+
+	return hash;
+}
+
 void JoltSpace3D::set_default_area(JoltArea3D *p_area) {
 	if (default_area == p_area) {
 		return;
@@ -131,6 +131,11 @@ public:
 
 	float get_last_step() const { return last_step; }
 
+	uint64_t get_state_hash() const;
+
+	Vector<uint8_t> save_state() const;
+	void restore_state(const Vector<uint8_t> &p_state);
+
 	JPH::BodyID add_rigid_body(const JoltObject3D &p_object, const JPH::BodyCreationSettings &p_settings, bool p_sleeping = false);
 	JPH::BodyID add_soft_body(const JoltObject3D &p_object, const JPH::SoftBodyCreationSettings &p_settings, bool p_sleeping = false);
 
@@ -53,6 +53,10 @@ void CanvasItemMaterial::finish_shaders() {
 }
 
 void CanvasItemMaterial::_update_shader() {
+	_update_shader_batched(nullptr);
+}
+
+void CanvasItemMaterial::_update_shader_batched(ShaderCodeBatch *r_batch) {
 	MaterialKey mk = _compute_key();
 	if (mk.key == current_key.key) {
 		return; //no update required in the end
@@ -140,7 +144,7 @@ void CanvasItemMaterial::_update_shader() {
 	shader_data.shader = RS::get_singleton()->shader_create();
 	shader_data.users = 1;
 
-	RS::get_singleton()->shader_set_code(shader_data.shader, code);
+	_set_shader_code(shader_data.shader, code, r_batch);
 
 	shader_map[mk] = shader_data;
 
@@ -150,10 +154,12 @@ void CanvasItemMaterial::_update_shader() {
 void CanvasItemMaterial::flush_changes() {
 	MutexLock lock(material_mutex);
 
+	ShaderCodeBatch batch;
 	while (dirty_materials.first()) {
-		dirty_materials.first()->self()->_update_shader();
+		dirty_materials.first()->self()->_update_shader_batched(&batch);
 		dirty_materials.first()->remove_from_list();
 	}
+	_flush_shader_code_batch(batch);
 }
 
 void CanvasItemMaterial::_queue_shader_change() {
@@ -102,6 +102,7 @@ private:
 	SelfList<CanvasItemMaterial> element;
 
 	void _update_shader();
+	void _update_shader_batched(ShaderCodeBatch *r_batch);
 	_FORCE_INLINE_ void _queue_shader_change();
 
 	BlendMode blend_mode = BLEND_MODE_MIX;
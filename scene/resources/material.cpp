@@ -114,6 +114,21 @@ void Material::_mark_initialized(const Callable &p_add_to_dirty_list, const Call
 	}
 }
 
+void Material::_set_shader_code(RID p_shader, const String &p_code, ShaderCodeBatch *r_batch) {
+	if (r_batch) {
+		r_batch->shaders.push_back(p_shader);
+		r_batch->codes.push_back(p_code);
+	} else {
+		RS::get_singleton()->shader_set_code(p_shader, p_code);
+	}
+}
+
+void Material::_flush_shader_code_batch(const ShaderCodeBatch &p_batch) {
+	if (!p_batch.shaders.is_empty()) {
+		RS::get_singleton()->shader_set_code_batch(p_batch.shaders, p_batch.codes);
+	}
+}
+
 void Material::inspect_native_shader_code() {
 	SceneTree *st = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
 	RID shader = get_shader_rid();
@@ -679,6 +694,10 @@ void BaseMaterial3D::finish_shaders() {
 }
 
 void BaseMaterial3D::_update_shader() {
+	_update_shader_batched(nullptr);
+}
+
+void BaseMaterial3D::_update_shader_batched(ShaderCodeBatch *r_batch) {
 	MaterialKey mk = _compute_key();
 	if (mk == current_key) {
 		return; //no update required in the end
@@ -1930,8 +1949,9 @@ void fragment() {)";
 	code += "}\n";
 
 	ShaderData shader_data;
-	shader_data.shader = RS::get_singleton()->shader_create_from_code(code);
+	shader_data.shader = RS::get_singleton()->shader_create();
 	shader_data.users = 1;
+	_set_shader_code(shader_data.shader, code, r_batch);
 	shader_map[mk] = shader_data;
 	shader_rid = shader_data.shader;
 
@@ -1961,10 +1981,12 @@ void BaseMaterial3D::_check_material_rid() {
 void BaseMaterial3D::flush_changes() {
 	MutexLock lock(material_mutex);
 
+	ShaderCodeBatch batch;
 	while (dirty_materials.first()) {
-		dirty_materials.first()->self()->_update_shader();
+		dirty_materials.first()->self()->_update_shader_batched(&batch);
 		dirty_materials.first()->remove_from_list();
 	}
+	_flush_shader_code_batch(batch);
 }
 
 void BaseMaterial3D::_queue_shader_change() {
@@ -67,6 +67,15 @@ protected:
 	void _mark_initialized(const Callable &p_add_to_dirty_list, const Callable &p_update_shader);
 	bool _is_initialized() { return init_state == INIT_STATE_READY; }
 
+	// Shader code generated while flushing dirty materials, set in one RenderingServer::shader_set_code_batch() call.
+	struct ShaderCodeBatch {
+		Vector<RID> shaders;
+		Vector<String> codes;
+	};
+
+	static void _set_shader_code(RID p_shader, const String &p_code, ShaderCodeBatch *r_batch);
+	static void _flush_shader_code_batch(const ShaderCodeBatch &p_batch);
+
 	GDVIRTUAL0RC_REQUIRED(RID, _get_shader_rid)
 	GDVIRTUAL0RC_REQUIRED(Shader::Mode, _get_shader_mode)
 	GDVIRTUAL0RC(bool, _can_do_next_pass)
@@ -474,6 +483,7 @@ private:
 	SelfList<BaseMaterial3D> element;
 
 	void _update_shader();
+	void _update_shader_batched(ShaderCodeBatch *r_batch);
 	_FORCE_INLINE_ void _queue_shader_change();
 	void _check_material_rid();
 	void _material_set_param(const StringName &p_name, const Variant &p_value);
@@ -147,6 +147,10 @@ void ParticleProcessMaterial::finish_shaders() {
 }
 
 void ParticleProcessMaterial::_update_shader() {
+	_update_shader_batched(nullptr);
+}
+
+void ParticleProcessMaterial::_update_shader_batched(ShaderCodeBatch *r_batch) {
 	MaterialKey mk = _compute_key();
 	if (mk == current_key) {
 		return; // No update required in the end.
@@ -1173,7 +1177,7 @@ void ParticleProcessMaterial::_update_shader() {
 	shader_data.shader = RS::get_singleton()->shader_create();
 	shader_data.users = 1;
 
-	RS::get_singleton()->shader_set_code(shader_data.shader, code);
+	_set_shader_code(shader_data.shader, code, r_batch);
 
 	shader_map[mk] = shader_data;
 
@@ -1183,10 +1187,12 @@ void ParticleProcessMaterial::_update_shader() {
 void ParticleProcessMaterial::flush_changes() {
 	MutexLock lock(material_mutex);
 
+	ShaderCodeBatch batch;
 	while (dirty_materials.first()) {
-		dirty_materials.first()->self()->_update_shader();
+		dirty_materials.first()->self()->_update_shader_batched(&batch);
 		dirty_materials.first()->remove_from_list();
 	}
+	_flush_shader_code_batch(batch);
 }
 
 void ParticleProcessMaterial::_queue_shader_change() {
@@ -295,6 +295,7 @@ private:
 	SelfList<ParticleProcessMaterial> element;
 
 	void _update_shader();
+	void _update_shader_batched(ShaderCodeBatch *r_batch);
 	_FORCE_INLINE_ void _queue_shader_change();
 
 	Vector3 direction;
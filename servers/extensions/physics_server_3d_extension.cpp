@@ -166,6 +166,9 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_set_debug_contacts, "space", "max_contacts");
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
+	GDVIRTUAL_BIND(_space_get_state_hash, "space");
+	GDVIRTUAL_BIND(_space_save_state, "space");
+	GDVIRTUAL_BIND(_space_restore_state, "space", "state");
 
 	/* AREA API */
 
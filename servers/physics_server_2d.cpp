@@ -448,6 +448,137 @@ Dictionary PhysicsDirectSpaceState2D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to) {
+	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), hits.ptr());
+
+	PackedVector2Array positions;
+	positions.resize(count);
+	PackedVector2Array normals;
+	normals.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+
+	Vector2 *positions_ptr = positions.ptrw();
+	Vector2 *normals_ptr = normals.ptrw();
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		if (hits[i]) {
+			const RayResult &result = results[i];
+			positions_ptr[i] = result.position;
+			normals_ptr[i] = result.normal;
+			collider_ids_ptr[i] = (int64_t)result.collider_id;
+			shapes_ptr[i] = result.shape;
+		} else {
+			positions_ptr[i] = Vector2();
+			normals_ptr[i] = Vector2();
+			collider_ids_ptr[i] = 0;
+			shapes_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["positions"] = positions;
+	d["normals"] = normals;
+	d["collider_ids"] = collider_ids;
+	d["shapes"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState2D::_intersect_points(const Ref<PhysicsPointQueryParameters2D> &p_point_query, const PackedVector2Array &p_points) {
+	ERR_FAIL_COND_V(p_point_query.is_null(), Dictionary());
+
+	int count = p_points.size();
+
+	Vector<ShapeResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+
+	intersect_points(p_point_query->get_parameters(), p_points.ptr(), count, results.ptrw(), hits.ptr());
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		collider_ids_ptr[i] = hits[i] ? (int64_t)results[i].collider_id : 0;
+		shapes_ptr[i] = hits[i] ? results[i].shape : -1;
+	}
+
+	Dictionary d;
+	d["collider_ids"] = collider_ids;
+	d["shapes"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState2D::_cast_motions(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), Dictionary());
+
+	int count = p_origins.size();
+
+	Vector<real_t> safe_fractions;
+	safe_fractions.resize(count);
+	Vector<real_t> unsafe_fractions;
+	unsafe_fractions.resize(count);
+
+	cast_motions(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, safe_fractions.ptrw(), unsafe_fractions.ptrw());
+
+	Dictionary d;
+	d["safe_fractions"] = safe_fractions;
+	d["unsafe_fractions"] = unsafe_fractions;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState2D::intersect_points(const PointParameters &p_parameters, const Vector2 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) {
+	PointParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.position = p_points[i];
+		r_hits[i] = intersect_point(parameters, &r_results[i], 1) > 0;
+	}
+}
+
+void PhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.set_origin(p_origins[i]);
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 }
 
@@ -458,6 +589,9 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState2D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_points", "parameters", "points"), &PhysicsDirectSpaceState2D::_intersect_points);
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState2D::_cast_motions);
 }
 
 ///////////////////////////////
@@ -637,6 +771,9 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_get_state_hash", "space"), &PhysicsServer2D::space_get_state_hash);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer2D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer2D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -904,6 +1041,7 @@ PhysicsServer2D::PhysicsServer2D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/sleep_threshold_angular", PROPERTY_HINT_RANGE, "0,90,0.1,radians_as_degrees"), Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater,suffix:s"), 0.5);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/2d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
+	GLOBAL_DEF("physics/2d/solver/deterministic", false);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), 1.0);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), 1.5);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.01,10,0.01,or_greater"), 0.3);
@@ -123,6 +123,9 @@ class PhysicsDirectSpaceState2D : public Object {
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 	TypedArray<Vector2> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to);
+	Dictionary _intersect_points(const Ref<PhysicsPointQueryParameters2D> &p_point_query, const PackedVector2Array &p_points);
+	Dictionary _cast_motions(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -198,6 +201,12 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
+	// Batched queries: the ray ends, point position or shape origin of `p_parameters` are replaced per query.
+	// The defaults loop over the single queries; servers can override them to run the batch in parallel.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector2 *p_points, int p_count, ShapeResult *r_results, bool *r_hits);
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState2D();
 };
 
@@ -276,6 +285,10 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual uint64_t space_get_state_hash(RID p_space) const = 0;
+	virtual PackedByteArray space_save_state(RID p_space) const = 0;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
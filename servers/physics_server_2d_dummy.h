@@ -158,6 +158,9 @@ public:
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override {}
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override { return Vector<Vector2>(); }
 	virtual int space_get_contact_count(RID p_space) const override { return 0; }
+	virtual uint64_t space_get_state_hash(RID p_space) const override { return 0; }
+	virtual PackedByteArray space_save_state(RID p_space) const override { return PackedByteArray(); }
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) override {}
 
 	/* AREA API */
 
@@ -121,6 +121,18 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	virtual uint64_t space_get_state_hash(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0);
+		return physics_server_2d->space_get_state_hash(p_space);
+	}
+
+	virtual PackedByteArray space_save_state(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), PackedByteArray());
+		return physics_server_2d->space_save_state(p_space);
+	}
+
+	FUNC2(space_restore_state, RID, const PackedByteArray &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
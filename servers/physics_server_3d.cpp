@@ -475,6 +475,137 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), hits.ptr());
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	PackedVector3Array normals;
+	normals.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+
+	Vector3 *positions_ptr = positions.ptrw();
+	Vector3 *normals_ptr = normals.ptrw();
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		if (hits[i]) {
+			const RayResult &result = results[i];
+			positions_ptr[i] = result.position;
+			normals_ptr[i] = result.normal;
+			collider_ids_ptr[i] = (int64_t)result.collider_id;
+			shapes_ptr[i] = result.shape;
+		} else {
+			positions_ptr[i] = Vector3();
+			normals_ptr[i] = Vector3();
+			collider_ids_ptr[i] = 0;
+			shapes_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["positions"] = positions;
+	d["normals"] = normals;
+	d["collider_ids"] = collider_ids;
+	d["shapes"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_points(const Ref<PhysicsPointQueryParameters3D> &p_point_query, const PackedVector3Array &p_points) {
+	ERR_FAIL_COND_V(p_point_query.is_null(), Dictionary());
+
+	int count = p_points.size();
+
+	Vector<ShapeResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+
+	intersect_points(p_point_query->get_parameters(), p_points.ptr(), count, results.ptrw(), hits.ptr());
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		collider_ids_ptr[i] = hits[i] ? (int64_t)results[i].collider_id : 0;
+		shapes_ptr[i] = hits[i] ? results[i].shape : -1;
+	}
+
+	Dictionary d;
+	d["collider_ids"] = collider_ids;
+	d["shapes"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_cast_motions(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), Dictionary());
+
+	int count = p_origins.size();
+
+	Vector<real_t> safe_fractions;
+	safe_fractions.resize(count);
+	Vector<real_t> unsafe_fractions;
+	unsafe_fractions.resize(count);
+
+	cast_motions(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, safe_fractions.ptrw(), unsafe_fractions.ptrw());
+
+	Dictionary d;
+	d["safe_fractions"] = safe_fractions;
+	d["unsafe_fractions"] = unsafe_fractions;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState3D::intersect_points(const PointParameters &p_parameters, const Vector3 *p_points, int p_count, ShapeResult *r_results, bool *r_hits) {
+	PointParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.position = p_points[i];
+		r_hits[i] = intersect_point(parameters, &r_results[i], 1) > 0;
+	}
+}
+
+void PhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -485,6 +616,9 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_points", "parameters", "points"), &PhysicsDirectSpaceState3D::_intersect_points);
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motions);
 }
 
 ///////////////////////////////
@@ -661,6 +795,148 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+Dictionary PhysicsServer3D::_body_move_and_slide_batch(const TypedArray<RID> &p_bodies, const PackedVector3Array &p_motions, int p_max_slides, const Vector3 &p_up_direction, real_t p_floor_max_angle, real_t p_margin, bool p_update_transforms) {
+	ERR_FAIL_COND_V(p_bodies.size() != p_motions.size(), Dictionary());
+	ERR_FAIL_COND_V(p_max_slides < 1, Dictionary());
+
+	int count = p_bodies.size();
+
+	LocalVector<RID> bodies;
+	bodies.resize(count);
+	for (int i = 0; i < count; i++) {
+		bodies[i] = p_bodies[i];
+	}
+
+	SlideParameters parameters;
+	parameters.margin = p_margin;
+	parameters.max_slides = p_max_slides;
+	parameters.up_direction = p_up_direction;
+	parameters.floor_max_angle = p_floor_max_angle;
+	parameters.update_transforms = p_update_transforms;
+
+	Vector<SlideResult> results;
+	results.resize(count);
+
+	body_move_and_slide_batch(bodies.ptr(), p_motions.ptr(), count, parameters, results.ptrw());
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	PackedVector3Array travels;
+	travels.resize(count);
+	PackedVector3Array remainders;
+	remainders.resize(count);
+	PackedVector3Array floor_normals;
+	floor_normals.resize(count);
+	PackedInt32Array collision_counts;
+	collision_counts.resize(count);
+	PackedByteArray on_floor;
+	on_floor.resize(count);
+	PackedByteArray on_wall;
+	on_wall.resize(count);
+	PackedByteArray on_ceiling;
+	on_ceiling.resize(count);
+
+	Vector3 *positions_ptr = positions.ptrw();
+	Vector3 *travels_ptr = travels.ptrw();
+	Vector3 *remainders_ptr = remainders.ptrw();
+	Vector3 *floor_normals_ptr = floor_normals.ptrw();
+	int32_t *collision_counts_ptr = collision_counts.ptrw();
+	uint8_t *on_floor_ptr = on_floor.ptrw();
+	uint8_t *on_wall_ptr = on_wall.ptrw();
+	uint8_t *on_ceiling_ptr = on_ceiling.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		const SlideResult &result = results[i];
+		positions_ptr[i] = result.transform.origin;
+		travels_ptr[i] = result.travel;
+		remainders_ptr[i] = result.remainder;
+		floor_normals_ptr[i] = result.floor_normal;
+		collision_counts_ptr[i] = result.collision_count;
+		on_floor_ptr[i] = result.on_floor;
+		on_wall_ptr[i] = result.on_wall;
+		on_ceiling_ptr[i] = result.on_ceiling;
+	}
+
+	Dictionary d;
+	d["positions"] = positions;
+	d["travels"] = travels;
+	d["remainders"] = remainders;
+	d["floor_normals"] = floor_normals;
+	d["collision_counts"] = collision_counts;
+	d["on_floor"] = on_floor;
+	d["on_wall"] = on_wall;
+	d["on_ceiling"] = on_ceiling;
+	return d;
+}
+
+void PhysicsServer3D::_body_slide(RID p_body, const Transform3D &p_from, const Vector3 &p_motion, const SlideParameters &p_parameters, SlideTestMotionCallback p_test_motion, void *p_userdata, SlideResult &r_result) {
+	// Same tolerance CharacterBody3D uses when classifying floors.
+	const real_t floor_angle_threshold = 0.01;
+
+	r_result = SlideResult();
+	r_result.transform = p_from;
+
+	// Room for two walls and a floor, each of which can report two contacts.
+	MotionParameters parameters(p_from, p_motion, p_parameters.margin);
+	parameters.max_collisions = 6;
+
+	MotionResult result;
+	for (int slide = 0; slide < p_parameters.max_slides; slide++) {
+		parameters.from = r_result.transform;
+
+		bool collided = p_test_motion(p_body, parameters, &result, p_userdata);
+
+		r_result.transform.origin += result.travel;
+		r_result.travel += result.travel;
+
+		if (!collided) {
+			parameters.motion = Vector3();
+			break;
+		}
+
+		r_result.collision_count++;
+
+		for (int i = 0; i < result.collision_count; i++) {
+			const MotionCollision &collision = result.collisions[i];
+			if (p_parameters.up_direction == Vector3()) {
+				r_result.on_wall = true;
+			} else if (collision.get_angle(p_parameters.up_direction) <= p_parameters.floor_max_angle + floor_angle_threshold) {
+				r_result.on_floor = true;
+				r_result.floor_normal = collision.normal;
+			} else if (collision.get_angle(-p_parameters.up_direction) <= p_parameters.floor_max_angle + floor_angle_threshold) {
+				r_result.on_ceiling = true;
+			} else {
+				r_result.on_wall = true;
+			}
+		}
+
+		parameters.motion = result.remainder.slide(result.collisions[0].normal);
+		if (parameters.motion.is_zero_approx()) {
+			parameters.motion = Vector3();
+			break;
+		}
+	}
+
+	r_result.remainder = parameters.motion;
+}
+
+static bool _body_test_motion_callback(RID p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, void *p_userdata) {
+	return static_cast<PhysicsServer3D *>(p_userdata)->body_test_motion(p_body, p_parameters, r_result);
+}
+
+void PhysicsServer3D::body_move_and_slide_batch(const RID *p_bodies, const Vector3 *p_motions, int p_count, const SlideParameters &p_parameters, SlideResult *r_results) {
+	for (int i = 0; i < p_count; i++) {
+		Transform3D from = body_get_state(p_bodies[i], BODY_STATE_TRANSFORM);
+		_body_slide(p_bodies[i], from, p_motions[i], p_parameters, _body_test_motion_callback, this, r_results[i]);
+	}
+
+	if (p_parameters.update_transforms) {
+		for (int i = 0; i < p_count; i++) {
+			body_set_state(p_bodies[i], BODY_STATE_TRANSFORM, r_results[i].transform);
+		}
+	}
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -715,6 +991,9 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_get_state_hash", "space"), &PhysicsServer3D::space_get_state_hash);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -835,6 +1114,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_ray_pickable", "body", "enable"), &PhysicsServer3D::body_set_ray_pickable);
 
 	ClassDB::bind_method(D_METHOD("body_test_motion", "body", "parameters", "result"), &PhysicsServer3D::_body_test_motion, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("body_move_and_slide_batch", "bodies", "motions", "max_slides", "up_direction", "floor_max_angle", "margin", "update_transforms"), &PhysicsServer3D::_body_move_and_slide_batch, DEFVAL(4), DEFVAL(Vector3(0, 1, 0)), DEFVAL(Math::deg_to_rad((real_t)45.0)), DEFVAL(0.001), DEFVAL(true));
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer3D::body_get_direct_state);
 
@@ -1134,6 +1414,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/sleep_threshold_angular", PROPERTY_HINT_RANGE, "0,90,0.1,radians_as_degrees"), Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 0.5);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
+	GLOBAL_DEF("physics/3d/solver/deterministic", false);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
@@ -127,6 +127,9 @@ private:
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	Dictionary _intersect_points(const Ref<PhysicsPointQueryParameters3D> &p_point_query, const PackedVector3Array &p_points);
+	Dictionary _cast_motions(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -205,6 +208,12 @@ public:
 
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
+	// Batched queries: the ray ends, point position or shape origin of `p_parameters` are replaced per query.
+	// The defaults loop over the single queries; servers can override them to run the batch in parallel.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector3 *p_points, int p_count, ShapeResult *r_results, bool *r_hits);
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState3D();
 };
 
@@ -234,6 +243,7 @@ class PhysicsServer3D : public Object {
 	static PhysicsServer3D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters3D> &p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
+	Dictionary _body_move_and_slide_batch(const TypedArray<RID> &p_bodies, const PackedVector3Array &p_motions, int p_max_slides = 4, const Vector3 &p_up_direction = Vector3(0, 1, 0), real_t p_floor_max_angle = Math::deg_to_rad((real_t)45.0), real_t p_margin = 0.001, bool p_update_transforms = true);
 
 protected:
 	static void _bind_methods();
@@ -306,6 +316,10 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual uint64_t space_get_state_hash(RID p_space) const = 0;
+	virtual PackedByteArray space_save_state(RID p_space) const = 0;
+	virtual void space_restore_state(RID p_space, const PackedByteArray &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -567,6 +581,29 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	struct SlideParameters {
+		real_t margin = 0.001;
+		int max_slides = 4;
+		Vector3 up_direction = Vector3(0, 1, 0);
+		real_t floor_max_angle = Math::deg_to_rad((real_t)45.0);
+		bool update_transforms = true;
+	};
+
+	struct SlideResult {
+		Transform3D transform;
+		Vector3 travel;
+		Vector3 remainder;
+		Vector3 floor_normal;
+		int collision_count = 0;
+		bool on_floor = false;
+		bool on_wall = false;
+		bool on_ceiling = false;
+	};
+
+	// Batched collide-and-slide: each body is moved by its motion, sliding along what it hits for up to `max_slides` motion tests.
+	// The default runs the bodies one after the other through body_test_motion(); servers can override it to move them in parallel.
+	virtual void body_move_and_slide_batch(const RID *p_bodies, const Vector3 *p_motions, int p_count, const SlideParameters &p_parameters, SlideResult *r_results);
+
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -812,6 +849,11 @@ public:
 
 	PhysicsServer3D();
 	~PhysicsServer3D();
+
+protected:
+	// Slides one body, running its motion tests through p_test_motion so servers can provide their own.
+	typedef bool (*SlideTestMotionCallback)(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result, void *p_userdata);
+	static void _body_slide(RID p_body, const Transform3D &p_from, const Vector3 &p_motion, const SlideParameters &p_parameters, SlideTestMotionCallback p_test_motion, void *p_userdata, SlideResult &r_result);
 };
 
 class PhysicsRayQueryParameters3D : public RefCounted {
@@ -41,7 +41,7 @@ void PhysicsServer3DWrapMT::_thread_exit() {
 
 void PhysicsServer3DWrapMT::_thread_loop() {
 	while (!exit) {
-		WorkerThreadPool::get_singleton()->yield();
+		command_queue.wait_for_pending();
 		command_queue.flush_all();
 	}
 }
@@ -77,6 +77,8 @@ void PhysicsServer3DWrapMT::init() {
 	if (create_thread) {
 		WorkerThreadPool::TaskID tid = WorkerThreadPool::get_singleton()->add_task(callable_mp(this, &PhysicsServer3DWrapMT::_thread_loop), true);
 		command_queue.set_pump_task_id(tid);
+		// The main thread issues most calls, let those skip the lock.
+		command_queue.set_producer_thread(Thread::get_caller_id());
 		command_queue.push(this, &PhysicsServer3DWrapMT::_assign_mt_ids, tid);
 		command_queue.push_and_sync(physics_server_3d, &PhysicsServer3D::init);
 		DEV_ASSERT(server_task_id == tid);
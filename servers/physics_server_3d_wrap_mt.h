@@ -128,6 +128,18 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	virtual uint64_t space_get_state_hash(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0);
+		return physics_server_3d->space_get_state_hash(p_space);
+	}
+
+	virtual PackedByteArray space_save_state(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), PackedByteArray());
+		return physics_server_3d->space_save_state(p_space);
+	}
+
+	FUNC2(space_restore_state, RID, const PackedByteArray &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -264,6 +276,11 @@ public:
 		return physics_server_3d->body_test_motion(p_body, p_parameters, r_result);
 	}
 
+	void body_move_and_slide_batch(const RID *p_bodies, const Vector3 *p_motions, int p_count, const SlideParameters &p_parameters, SlideResult *r_results) override {
+		ERR_FAIL_COND(!Thread::is_main_thread());
+		physics_server_3d->body_move_and_slide_batch(p_bodies, p_motions, p_count, p_parameters, r_results);
+	}
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
@@ -31,6 +31,7 @@
 #include "material_storage.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 using namespace RendererDummy;
 
@@ -158,13 +159,7 @@ void MaterialStorage::shader_free(RID p_rid) {
 	shader_owner.free(p_rid);
 }
 
-void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
-	DummyShader *shader = shader_owner.get_or_null(p_shader);
-	ERR_FAIL_NULL(shader);
-	if (p_code.is_empty()) {
-		return;
-	}
-
+Error MaterialStorage::_shader_compile(const String &p_code, HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> &r_uniforms) const {
 	String mode_string = ShaderLanguage::get_shader_type(p_code);
 
 	RS::ShaderMode new_mode;
@@ -179,15 +174,70 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	} else if (mode_string == "fog") {
 		new_mode = RS::SHADER_FOG;
 	} else {
-		new_mode = RS::SHADER_MAX;
-		ERR_FAIL_MSG("Shader type " + mode_string + " not supported in Dummy renderer.");
+		ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Shader type " + mode_string + " not supported in Dummy renderer.");
 	}
 	ShaderCompiler::IdentifierActions actions;
-	actions.uniforms = &shader->uniforms;
+	actions.uniforms = &r_uniforms;
 	ShaderCompiler::GeneratedCode gen_code;
 
-	Error err = MaterialStorage::get_singleton()->dummy_compiler.compile(new_mode, p_code, &actions, "", gen_code);
-	ERR_FAIL_COND_MSG(err != OK, "Shader compilation failed.");
+	Error err = dummy_compiler.compile(new_mode, p_code, &actions, "", gen_code);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Shader compilation failed.");
+	return OK;
+}
+
+void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
+	DummyShader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL(shader);
+	if (p_code.is_empty()) {
+		return;
+	}
+
+	_shader_compile(p_code, shader->uniforms);
+}
+
+void MaterialStorage::_shader_batch_compile_task(uint32_t p_index, ShaderBatchItem *p_items) {
+	ShaderBatchItem &item = p_items[p_index];
+	item.error = _shader_compile(item.code, item.uniforms);
+}
+
+void MaterialStorage::shader_set_code_batch(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+
+	// Resolve the RIDs up front, the owner is not safe to access from the pool.
+	LocalVector<ShaderBatchItem> items;
+	items.reserve(p_shaders.size());
+	for (int i = 0; i < p_shaders.size(); i++) {
+		DummyShader *shader = shader_owner.get_or_null(p_shaders[i]);
+		ERR_CONTINUE(!shader);
+		if (p_codes[i].is_empty()) {
+			continue;
+		}
+		ShaderBatchItem item;
+		item.shader = shader;
+		item.code = p_codes[i];
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	// Parsing and code generation are independent per shader, only the results are written back serially
+	// so that the same shader appearing twice in a batch behaves like two consecutive shader_set_code() calls.
+	if (items.size() >= SHADER_BATCH_THREADED_MIN && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MaterialStorage::_shader_batch_compile_task, items.ptr(), items.size(), -1, true, SNAME("DummyShaderBatchCompile"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < items.size(); i++) {
+			_shader_batch_compile_task(i, items.ptr());
+		}
+	}
+
+	for (ShaderBatchItem &item : items) {
+		if (item.error == OK) {
+			item.shader->uniforms = item.uniforms;
+		}
+	}
 }
 
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
@@ -52,6 +52,19 @@ private:
 
 	ShaderCompiler dummy_compiler;
 
+	// Below this many shaders, a batch is compiled on the calling thread.
+	static constexpr uint32_t SHADER_BATCH_THREADED_MIN = 2;
+
+	struct ShaderBatchItem {
+		DummyShader *shader = nullptr;
+		String code;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		Error error = OK;
+	};
+
+	Error _shader_compile(const String &p_code, HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> &r_uniforms) const;
+	void _shader_batch_compile_task(uint32_t p_index, ShaderBatchItem *p_items);
+
 	struct DummyMaterial {
 		RID shader;
 		RID next_pass;
@@ -92,6 +105,7 @@ public:
 	virtual void shader_free(RID p_rid) override;
 
 	virtual void shader_set_code(RID p_shader, const String &p_code) override;
+	virtual void shader_set_code_batch(const Vector<RID> &p_shaders, const Vector<String> &p_codes) override;
 	virtual void shader_set_path_hint(RID p_shader, const String &p_code) override {}
 
 	virtual String shader_get_code(RID p_shader) const override { return ""; }
@@ -30,8 +30,61 @@
 
 #include "mesh_storage.h"
 
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DUMMY_MESH_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define DUMMY_MESH_SIMD_NEON
+#endif
+
 using namespace RendererDummy;
 
+// Minimal 4-wide float helpers for the deformation kernel. Deformation data is always stored
+// as floats, so these are used regardless of real_t precision.
+// F4_MADD_LANE(acc, col, v, lane) returns acc + col * v[lane].
+#if defined(DUMMY_MESH_SIMD_SSE2)
+typedef __m128 Float4;
+static _FORCE_INLINE_ Float4 f4_load(const float *p_ptr) { return _mm_loadu_ps(p_ptr); }
+static _FORCE_INLINE_ Float4 f4_splat(float p_value) { return _mm_set1_ps(p_value); }
+static _FORCE_INLINE_ Float4 f4_set(float p_x, float p_y, float p_z, float p_w) { return _mm_set_ps(p_w, p_z, p_y, p_x); }
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return _mm_max_ps(p_a, p_b); }
+#define F4_MADD_LANE(m_acc, m_col, m_v, m_lane) _mm_add_ps(m_acc, _mm_mul_ps(m_col, _mm_shuffle_ps(m_v, m_v, _MM_SHUFFLE(m_lane, m_lane, m_lane, m_lane))))
+static _FORCE_INLINE_ void f4_store(float *r_ptr, Float4 p_v) { _mm_storeu_ps(r_ptr, p_v); }
+#elif defined(DUMMY_MESH_SIMD_NEON)
+typedef float32x4_t Float4;
+static _FORCE_INLINE_ Float4 f4_load(const float *p_ptr) { return vld1q_f32(p_ptr); }
+static _FORCE_INLINE_ Float4 f4_splat(float p_value) { return vdupq_n_f32(p_value); }
+static _FORCE_INLINE_ Float4 f4_set(float p_x, float p_y, float p_z, float p_w) {
+	const float values[4] = { p_x, p_y, p_z, p_w };
+	return vld1q_f32(values);
+}
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return vmaxq_f32(p_a, p_b); }
+#define F4_MADD_LANE(m_acc, m_col, m_v, m_lane) vmlaq_n_f32(m_acc, m_col, vgetq_lane_f32(m_v, m_lane))
+static _FORCE_INLINE_ void f4_store(float *r_ptr, Float4 p_v) { vst1q_f32(r_ptr, p_v); }
+#else
+struct Float4 {
+	float v[4];
+};
+static _FORCE_INLINE_ Float4 f4_load(const float *p_ptr) { return Float4{ { p_ptr[0], p_ptr[1], p_ptr[2], p_ptr[3] } }; }
+static _FORCE_INLINE_ Float4 f4_splat(float p_value) { return Float4{ { p_value, p_value, p_value, p_value } }; }
+static _FORCE_INLINE_ Float4 f4_set(float p_x, float p_y, float p_z, float p_w) { return Float4{ { p_x, p_y, p_z, p_w } }; }
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return Float4{ { p_a.v[0] + p_b.v[0], p_a.v[1] + p_b.v[1], p_a.v[2] + p_b.v[2], p_a.v[3] + p_b.v[3] } }; }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return Float4{ { p_a.v[0] * p_b.v[0], p_a.v[1] * p_b.v[1], p_a.v[2] * p_b.v[2], p_a.v[3] * p_b.v[3] } }; }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return Float4{ { MIN(p_a.v[0], p_b.v[0]), MIN(p_a.v[1], p_b.v[1]), MIN(p_a.v[2], p_b.v[2]), MIN(p_a.v[3], p_b.v[3]) } }; }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return Float4{ { MAX(p_a.v[0], p_b.v[0]), MAX(p_a.v[1], p_b.v[1]), MAX(p_a.v[2], p_b.v[2]), MAX(p_a.v[3], p_b.v[3]) } }; }
+#define F4_MADD_LANE(m_acc, m_col, m_v, m_lane) f4_add(m_acc, f4_mul(m_col, f4_splat((m_v).v[m_lane])))
+static _FORCE_INLINE_ void f4_store(float *r_ptr, Float4 p_v) { memcpy(r_ptr, p_v.v, sizeof(float) * 4); }
+#endif
+
 MeshStorage *MeshStorage::singleton = nullptr;
 
 MeshStorage::MeshStorage() {
@@ -54,14 +107,73 @@ void MeshStorage::mesh_free(RID p_rid) {
 	DummyMesh *mesh = mesh_owner.get_or_null(p_rid);
 	ERR_FAIL_NULL(mesh);
 	mesh->dependency.deleted_notify(p_rid);
+	if (mesh->instances.size()) {
+		ERR_PRINT("deleting mesh with active instances");
+		for (const RID &E : mesh->instances) {
+			mesh_instance_owner.get_or_null(E)->I = nullptr;
+		}
+	}
 	mesh_owner.free(p_rid);
 }
 
+void MeshStorage::mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL(m);
+	ERR_FAIL_COND(p_blend_shape_count < 0);
+	m->blend_shape_count = p_blend_shape_count;
+	m->version++;
+
+	for (const RID &E : m->instances) {
+		DummyMeshInstance *mi = mesh_instance_owner.get_or_null(E);
+		uint32_t old_count = mi->blend_weights.size();
+		mi->blend_weights.resize(p_blend_shape_count);
+		for (uint32_t i = old_count; i < mi->blend_weights.size(); i++) {
+			mi->blend_weights[i] = 0;
+		}
+		mi->weights_dirty = true;
+	}
+}
+
+int MeshStorage::mesh_get_blend_shape_count(RID p_mesh) const {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, 0);
+	return m->blend_shape_count;
+}
+
+void MeshStorage::mesh_set_blend_shape_mode(RID p_mesh, RS::BlendShapeMode p_mode) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL(m);
+	ERR_FAIL_INDEX((int)p_mode, 2);
+	m->blend_shape_mode = p_mode;
+	m->version++;
+}
+
+RS::BlendShapeMode MeshStorage::mesh_get_blend_shape_mode(RID p_mesh) const {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, RS::BLEND_SHAPE_MODE_NORMALIZED);
+	return m->blend_shape_mode;
+}
+
+bool MeshStorage::mesh_needs_instance(RID p_mesh, bool p_has_skeleton) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, false);
+	return p_has_skeleton || m->blend_shape_count > 0;
+}
+
+AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, AABB());
+	return m->aabb;
+}
+
 void MeshStorage::mesh_surface_remove(RID p_mesh, int p_surface) {
 	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_NULL(m);
+	ERR_FAIL_INDEX(p_surface, m->surfaces.size());
 	m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MESH);
 	m->surfaces.remove_at(p_surface);
+	m->deform_surfaces.remove_at(p_surface);
+	_update_mesh_aabb(m);
 }
 
 void MeshStorage::mesh_clear(RID p_mesh) {
@@ -69,6 +181,308 @@ void MeshStorage::mesh_clear(RID p_mesh) {
 	ERR_FAIL_NULL(m);
 
 	m->surfaces.clear();
+	m->deform_surfaces.clear();
+	_update_mesh_aabb(m);
+}
+
+void MeshStorage::_update_mesh_aabb(DummyMesh *p_mesh) {
+	p_mesh->aabb = AABB();
+	for (int i = 0; i < p_mesh->surfaces.size(); i++) {
+		if (i == 0) {
+			p_mesh->aabb = p_mesh->surfaces[i].aabb;
+		} else {
+			p_mesh->aabb.merge_with(p_mesh->surfaces[i].aabb);
+		}
+	}
+	p_mesh->version++;
+}
+
+void MeshStorage::_decode_deform_surface(const RS::SurfaceData &p_surface, DummyMesh::DeformSurface &r_deform) {
+	const uint64_t format = p_surface.format;
+	if (!(format & RS::ARRAY_FORMAT_VERTEX) || (format & RS::ARRAY_FLAG_USE_2D_VERTICES)) {
+		return; // 2D meshes are deformed by the canvas renderer.
+	}
+
+	const uint32_t vertex_count = p_surface.vertex_count;
+	uint32_t offsets[RS::ARRAY_MAX];
+	uint32_t vertex_elem_size;
+	uint32_t normal_elem_size;
+	uint32_t attrib_elem_size;
+	uint32_t skin_elem_size;
+	RS::get_singleton()->mesh_surface_make_offsets_from_format(format, vertex_count, p_surface.index_count, offsets, vertex_elem_size, normal_elem_size, attrib_elem_size, skin_elem_size);
+	ERR_FAIL_COND((uint64_t)p_surface.vertex_data.size() < (uint64_t)vertex_count * vertex_elem_size);
+
+	r_deform.vertex_count = vertex_count;
+	r_deform.positions.resize(vertex_count * 4);
+	const uint8_t *r = p_surface.vertex_data.ptr();
+	float *positions = r_deform.positions.ptr();
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		Vector3 position;
+		if (format & RS::ARRAY_FLAG_COMPRESS_ATTRIBUTES) {
+			const uint16_t *v = reinterpret_cast<const uint16_t *>(&r[i * vertex_elem_size + offsets[RS::ARRAY_VERTEX]]);
+			position = Vector3(float(v[0]) / 65535.0, float(v[1]) / 65535.0, float(v[2]) / 65535.0) * p_surface.aabb.size + p_surface.aabb.position;
+		} else {
+			const float *v = reinterpret_cast<const float *>(&r[i * vertex_elem_size + offsets[RS::ARRAY_VERTEX]]);
+			position = Vector3(v[0], v[1], v[2]);
+		}
+		positions[i * 4 + 0] = position.x;
+		positions[i * 4 + 1] = position.y;
+		positions[i * 4 + 2] = position.z;
+		positions[i * 4 + 3] = 1.0;
+	}
+
+	if ((format & RS::ARRAY_FORMAT_BONES) && (format & RS::ARRAY_FORMAT_WEIGHTS) && (uint64_t)p_surface.skin_data.size() >= (uint64_t)vertex_count * skin_elem_size) {
+		const uint32_t influences = (format & RS::ARRAY_FLAG_USE_8_BONE_WEIGHTS) ? 8 : 4;
+		r_deform.influences = influences;
+		r_deform.bones.resize(vertex_count * influences);
+		r_deform.weights.resize(vertex_count * influences);
+		const uint8_t *sr = p_surface.skin_data.ptr();
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			const uint16_t *bones = reinterpret_cast<const uint16_t *>(&sr[i * skin_elem_size + offsets[RS::ARRAY_BONES]]);
+			const uint16_t *weights = reinterpret_cast<const uint16_t *>(&sr[i * skin_elem_size + offsets[RS::ARRAY_WEIGHTS]]);
+			for (uint32_t j = 0; j < influences; j++) {
+				r_deform.bones[i * influences + j] = bones[j];
+				r_deform.weights[i * influences + j] = float(weights[j]) / 65535.0;
+			}
+		}
+	}
+
+	if (p_surface.blend_shape_data.size()) {
+		// Blend shapes are stored without compression, see RenderingServer::mesh_surface_get_blend_shape_arrays().
+		const uint64_t bs_format = format & RS::ARRAY_FORMAT_BLEND_SHAPE_MASK;
+		RS::get_singleton()->mesh_surface_make_offsets_from_format(bs_format, vertex_count, 0, offsets, vertex_elem_size, normal_elem_size, attrib_elem_size, skin_elem_size);
+		const uint32_t shape_size = (vertex_elem_size + normal_elem_size) * vertex_count;
+		ERR_FAIL_COND(shape_size == 0 || p_surface.blend_shape_data.size() % shape_size != 0);
+		const uint32_t shape_count = p_surface.blend_shape_data.size() / shape_size;
+
+		r_deform.blend_shapes.resize(shape_count * vertex_count * 4);
+		const uint8_t *br = p_surface.blend_shape_data.ptr();
+		float *shapes = r_deform.blend_shapes.ptr();
+		for (uint32_t i = 0; i < shape_count; i++) {
+			for (uint32_t j = 0; j < vertex_count; j++) {
+				const float *v = reinterpret_cast<const float *>(&br[i * shape_size + j * vertex_elem_size + offsets[RS::ARRAY_VERTEX]]);
+				float *w = &shapes[(i * vertex_count + j) * 4];
+				w[0] = v[0];
+				w[1] = v[1];
+				w[2] = v[2];
+				w[3] = 0.0;
+			}
+		}
+	}
+}
+
+/* MESH INSTANCE */
+
+RID MeshStorage::mesh_instance_create(RID p_base) {
+	DummyMesh *mesh = mesh_owner.get_or_null(p_base);
+	ERR_FAIL_NULL_V(mesh, RID());
+
+	DummyMeshInstance mi;
+	mi.mesh = p_base;
+	mi.blend_weights.resize(mesh->blend_shape_count);
+	for (float &weight : mi.blend_weights) {
+		weight = 0;
+	}
+	RID rid = mesh_instance_owner.make_rid(mi);
+	mesh_instance_owner.get_or_null(rid)->I = mesh->instances.push_back(rid);
+	return rid;
+}
+
+void MeshStorage::mesh_instance_free(RID p_rid) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_rid);
+	ERR_FAIL_NULL(mi);
+	if (mi->I) {
+		mesh_owner.get_or_null(mi->mesh)->instances.erase(mi->I);
+		mi->I = nullptr;
+	}
+	mesh_instance_owner.free(p_rid);
+}
+
+void MeshStorage::mesh_instance_set_skeleton(RID p_mesh_instance, RID p_skeleton) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
+	ERR_FAIL_NULL(mi);
+	mi->skeleton = p_skeleton;
+}
+
+void MeshStorage::mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int p_shape, float p_weight) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
+	ERR_FAIL_NULL(mi);
+	ERR_FAIL_INDEX(p_shape, (int)mi->blend_weights.size());
+	mi->blend_weights[p_shape] = p_weight;
+	mi->weights_dirty = true;
+}
+
+bool MeshStorage::_mesh_instance_needs_deform(const DummyMeshInstance *p_mi) const {
+	if (!p_mi->deformed_valid || p_mi->weights_dirty || p_mi->deformed_skeleton != p_mi->skeleton) {
+		return true;
+	}
+	const DummyMesh *mesh = mesh_owner.get_or_null(p_mi->mesh);
+	if (mesh && mesh->version != p_mi->mesh_version) {
+		return true;
+	}
+	const DummySkeleton *skeleton = skeleton_owner.get_or_null(p_mi->skeleton);
+	return skeleton && skeleton->version != p_mi->skeleton_version;
+}
+
+// Applies blend shapes and skinning to every surface of the mesh instance, in the same
+// way as the skeleton compute shader of the RD renderer, and computes the resulting AABB.
+void MeshStorage::_mesh_instance_deform(DummyMeshInstance *p_mi) const {
+	const DummyMesh *mesh = mesh_owner.get_or_null(p_mi->mesh);
+	const DummySkeleton *skeleton = skeleton_owner.get_or_null(p_mi->skeleton);
+
+	p_mi->deformed_valid = true;
+	p_mi->weights_dirty = false;
+	p_mi->deformed_skeleton = p_mi->skeleton;
+	p_mi->skeleton_version = skeleton ? skeleton->version : 0;
+	p_mi->mesh_version = mesh ? mesh->version : 0;
+	p_mi->deformed_surfaces.clear();
+	p_mi->deformed_aabb = AABB();
+	if (!mesh) {
+		return;
+	}
+
+	const float *bone_data = (skeleton && !skeleton->use_2d) ? skeleton->data.ptr() : nullptr;
+	const uint32_t bone_count = bone_data ? skeleton->size : 0;
+
+	// Shapes with a negligible weight are skipped, like the GPU path does.
+	LocalVector<Pair<uint32_t, float>> active_shapes;
+	float blend_total = 0.0;
+	for (uint32_t i = 0; i < p_mi->blend_weights.size(); i++) {
+		if (Math::abs(p_mi->blend_weights[i]) > 0.0001f) {
+			active_shapes.push_back(Pair<uint32_t, float>(i, p_mi->blend_weights[i]));
+			blend_total += p_mi->blend_weights[i];
+		}
+	}
+	const float base_scale = mesh->blend_shape_mode == RS::BLEND_SHAPE_MODE_NORMALIZED ? 1.0 - blend_total : 1.0;
+	const Float4 base_scale4 = f4_set(base_scale, base_scale, base_scale, 1.0);
+
+	bool first_surface = true;
+	p_mi->deformed_surfaces.resize(mesh->deform_surfaces.size());
+	for (uint32_t s = 0; s < mesh->deform_surfaces.size(); s++) {
+		const DummyMesh::DeformSurface &surface = mesh->deform_surfaces[s];
+		const uint32_t vertex_count = surface.vertex_count;
+		if (vertex_count == 0) {
+			continue;
+		}
+
+		const bool use_blend_shapes = !active_shapes.is_empty() && !surface.blend_shapes.is_empty();
+		const bool use_skin = bone_count > 0 && surface.influences > 0;
+		const uint32_t shape_count = surface.blend_shapes.size() / (vertex_count * 4);
+
+		Vector<Vector3> &deformed = p_mi->deformed_surfaces[s];
+		deformed.resize(vertex_count);
+		Vector3 *dst = deformed.ptrw();
+
+		Float4 aabb_min = f4_splat(FLT_MAX);
+		Float4 aabb_max = f4_splat(-FLT_MAX);
+
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			Float4 vertex = f4_load(&surface.positions[i * 4]);
+
+			if (use_blend_shapes) {
+				vertex = f4_mul(vertex, base_scale4);
+				for (const Pair<uint32_t, float> &shape : active_shapes) {
+					if (shape.first < shape_count) {
+						vertex = f4_add(vertex, f4_mul(f4_splat(shape.second), f4_load(&surface.blend_shapes[(shape.first * vertex_count + i) * 4])));
+					}
+				}
+			}
+
+			if (use_skin) {
+				// Blend the bone matrices by column, then transform the vertex with the result.
+				Float4 col0 = f4_splat(0.0);
+				Float4 col1 = col0;
+				Float4 col2 = col0;
+				Float4 col3 = col0;
+				const uint16_t *bones = &surface.bones[i * surface.influences];
+				const float *weights = &surface.weights[i * surface.influences];
+				for (uint32_t j = 0; j < surface.influences; j++) {
+					if (weights[j] == 0.0f || bones[j] >= bone_count) {
+						continue;
+					}
+					const float *m = &bone_data[bones[j] * 16];
+					const Float4 w = f4_splat(weights[j]);
+					col0 = f4_add(col0, f4_mul(f4_load(m + 0), w));
+					col1 = f4_add(col1, f4_mul(f4_load(m + 4), w));
+					col2 = f4_add(col2, f4_mul(f4_load(m + 8), w));
+					col3 = f4_add(col3, f4_mul(f4_load(m + 12), w));
+				}
+				Float4 skinned = col3;
+				skinned = F4_MADD_LANE(skinned, col0, vertex, 0);
+				skinned = F4_MADD_LANE(skinned, col1, vertex, 1);
+				skinned = F4_MADD_LANE(skinned, col2, vertex, 2);
+				vertex = skinned;
+			}
+
+			aabb_min = f4_min(aabb_min, vertex);
+			aabb_max = f4_max(aabb_max, vertex);
+
+			float out[4];
+			f4_store(out, vertex);
+			dst[i] = Vector3(out[0], out[1], out[2]);
+		}
+
+		float min_out[4];
+		float max_out[4];
+		f4_store(min_out, aabb_min);
+		f4_store(max_out, aabb_max);
+		const Vector3 min = Vector3(min_out[0], min_out[1], min_out[2]);
+		const AABB surface_aabb = AABB(min, Vector3(max_out[0], max_out[1], max_out[2]) - min);
+		if (first_surface) {
+			p_mi->deformed_aabb = surface_aabb;
+			first_surface = false;
+		} else {
+			p_mi->deformed_aabb.merge_with(surface_aabb);
+		}
+	}
+}
+
+void MeshStorage::_mesh_instance_deform_task(uint32_t p_index, DummyMeshInstance **p_instances) {
+	_mesh_instance_deform(p_instances[p_index]);
+}
+
+void MeshStorage::mesh_instances_update_deformed(const Vector<RID> &p_mesh_instances) {
+	LocalVector<DummyMeshInstance *> dirty;
+	for (const RID &rid : p_mesh_instances) {
+		DummyMeshInstance *mi = mesh_instance_owner.get_or_null(rid);
+		ERR_CONTINUE(!mi);
+		if (_mesh_instance_needs_deform(mi) && !mi->deform_queued) {
+			mi->deform_queued = true;
+			dirty.push_back(mi);
+		}
+	}
+
+	if (dirty.size() >= DEFORM_THREADED_MIN_INSTANCES && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MeshStorage::_mesh_instance_deform_task, dirty.ptr(), dirty.size(), -1, true, SNAME("DummyMeshDeform"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < dirty.size(); i++) {
+			_mesh_instance_deform(dirty[i]);
+		}
+	}
+
+	for (DummyMeshInstance *mi : dirty) {
+		mi->deform_queued = false;
+	}
+}
+
+AABB MeshStorage::mesh_instance_get_deformed_aabb(RID p_mesh_instance) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
+	ERR_FAIL_NULL_V(mi, AABB());
+	if (_mesh_instance_needs_deform(mi)) {
+		_mesh_instance_deform(mi);
+	}
+	return mi->deformed_aabb;
+}
+
+Vector<Vector3> MeshStorage::mesh_instance_get_deformed_surface_vertices(RID p_mesh_instance, int p_surface) {
+	DummyMeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
+	ERR_FAIL_NULL_V(mi, Vector<Vector3>());
+	if (_mesh_instance_needs_deform(mi)) {
+		_mesh_instance_deform(mi);
+	}
+	ERR_FAIL_INDEX_V(p_surface, (int)mi->deformed_surfaces.size(), Vector<Vector3>());
+	return mi->deformed_surfaces[p_surface];
 }
 
 RID MeshStorage::_multimesh_allocate() {
@@ -100,3 +514,136 @@ Vector<float> MeshStorage::_multimesh_get_buffer(RID p_multimesh) const {
 
 	return multimesh->buffer;
 }
+
+/* SKELETON API */
+
+RID MeshStorage::skeleton_allocate() {
+	return skeleton_owner.allocate_rid();
+}
+
+void MeshStorage::skeleton_initialize(RID p_rid) {
+	skeleton_owner.initialize_rid(p_rid, DummySkeleton());
+}
+
+void MeshStorage::skeleton_free(RID p_rid) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_rid);
+	ERR_FAIL_NULL(skeleton);
+	skeleton->dependency.deleted_notify(p_rid);
+	skeleton_owner.free(p_rid);
+}
+
+void MeshStorage::skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_COND(p_bones < 0);
+
+	skeleton->size = p_bones;
+	skeleton->use_2d = p_2d_skeleton;
+	skeleton->data.resize(p_bones * (p_2d_skeleton ? 8 : 16));
+	for (float &value : skeleton->data) {
+		value = 0;
+	}
+	if (!p_2d_skeleton) {
+		// Identity matrices, the last column holds the origin and a 1 in w.
+		for (int i = 0; i < p_bones; i++) {
+			float *m = &skeleton->data[i * 16];
+			m[0] = 1;
+			m[5] = 1;
+			m[10] = 1;
+			m[15] = 1;
+		}
+	}
+	skeleton->version++;
+	skeleton->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_SKELETON_DATA);
+}
+
+void MeshStorage::skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_COND(!skeleton->use_2d);
+	skeleton->base_transform_2d = p_base_transform;
+}
+
+int MeshStorage::skeleton_get_bone_count(RID p_skeleton) const {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL_V(skeleton, 0);
+	return skeleton->size;
+}
+
+void MeshStorage::skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_INDEX(p_bone, skeleton->size);
+	ERR_FAIL_COND(skeleton->use_2d);
+
+	float *m = &skeleton->data[p_bone * 16];
+	for (int i = 0; i < 3; i++) {
+		m[i * 4 + 0] = p_transform.basis.rows[0][i];
+		m[i * 4 + 1] = p_transform.basis.rows[1][i];
+		m[i * 4 + 2] = p_transform.basis.rows[2][i];
+		m[i * 4 + 3] = 0;
+	}
+	m[12] = p_transform.origin.x;
+	m[13] = p_transform.origin.y;
+	m[14] = p_transform.origin.z;
+	m[15] = 1;
+	skeleton->version++;
+}
+
+Transform3D MeshStorage::skeleton_bone_get_transform(RID p_skeleton, int p_bone) const {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL_V(skeleton, Transform3D());
+	ERR_FAIL_INDEX_V(p_bone, skeleton->size, Transform3D());
+	ERR_FAIL_COND_V(skeleton->use_2d, Transform3D());
+
+	const float *m = &skeleton->data[p_bone * 16];
+	Transform3D t;
+	for (int i = 0; i < 3; i++) {
+		t.basis.rows[0][i] = m[i * 4 + 0];
+		t.basis.rows[1][i] = m[i * 4 + 1];
+		t.basis.rows[2][i] = m[i * 4 + 2];
+	}
+	t.origin = Vector3(m[12], m[13], m[14]);
+	return t;
+}
+
+void MeshStorage::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	ERR_FAIL_INDEX(p_bone, skeleton->size);
+	ERR_FAIL_COND(!skeleton->use_2d);
+
+	float *dataptr = &skeleton->data[p_bone * 8];
+	dataptr[0] = p_transform.columns[0][0];
+	dataptr[1] = p_transform.columns[1][0];
+	dataptr[2] = 0;
+	dataptr[3] = p_transform.columns[2][0];
+	dataptr[4] = p_transform.columns[0][1];
+	dataptr[5] = p_transform.columns[1][1];
+	dataptr[6] = 0;
+	dataptr[7] = p_transform.columns[2][1];
+	skeleton->version++;
+}
+
+Transform2D MeshStorage::skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL_V(skeleton, Transform2D());
+	ERR_FAIL_INDEX_V(p_bone, skeleton->size, Transform2D());
+	ERR_FAIL_COND_V(!skeleton->use_2d, Transform2D());
+
+	const float *dataptr = &skeleton->data[p_bone * 8];
+	Transform2D t;
+	t.columns[0][0] = dataptr[0];
+	t.columns[1][0] = dataptr[1];
+	t.columns[2][0] = dataptr[3];
+	t.columns[0][1] = dataptr[4];
+	t.columns[1][1] = dataptr[5];
+	t.columns[2][1] = dataptr[7];
+	return t;
+}
+
+void MeshStorage::skeleton_update_dependency(RID p_skeleton, DependencyTracker *p_instance) {
+	DummySkeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+	ERR_FAIL_NULL(skeleton);
+	p_instance->update_dependency(&skeleton->dependency);
+}
@@ -37,11 +37,26 @@
 namespace RendererDummy {
 
 struct DummyMesh {
+	// CPU copy of the attributes needed to deform a surface, decoded once when the surface is added.
+	// Positions and blend shapes are stored as 4 floats per vertex so they can be loaded as SIMD vectors.
+	struct DeformSurface {
+		uint32_t vertex_count = 0;
+		uint32_t influences = 0; // 0, 4 or 8 bones per vertex.
+		LocalVector<float> positions; // xyz1
+		LocalVector<float> blend_shapes; // xyz0, vertex_count entries per blend shape.
+		LocalVector<uint16_t> bones;
+		LocalVector<float> weights;
+	};
+
 	Vector<RS::SurfaceData> surfaces;
-	int blend_shape_count;
-	RS::BlendShapeMode blend_shape_mode;
+	LocalVector<DeformSurface> deform_surfaces;
+	int blend_shape_count = 0;
+	RS::BlendShapeMode blend_shape_mode = RS::BLEND_SHAPE_MODE_NORMALIZED;
 	PackedFloat32Array blend_shape_values;
+	AABB aabb;
+	uint64_t version = 0;
 	Dependency dependency;
+	List<RID> instances;
 };
 
 class MeshStorage : public RendererMeshStorage {
@@ -56,6 +71,44 @@ private:
 
 	mutable RID_Owner<DummyMultiMesh> multimesh_owner;
 
+	struct DummySkeleton {
+		int size = 0;
+		bool use_2d = false;
+		LocalVector<float> data; // Column-major 4x4 matrices (16 floats per bone) in 3D, rows of Transform2D (8 floats per bone) in 2D.
+		Transform2D base_transform_2d;
+		uint64_t version = 1;
+		Dependency dependency;
+	};
+
+	mutable RID_Owner<DummySkeleton> skeleton_owner;
+
+	struct DummyMeshInstance {
+		RID mesh;
+		List<RID>::Element *I = nullptr;
+		RID skeleton;
+		LocalVector<float> blend_weights;
+		bool weights_dirty = true;
+
+		uint64_t mesh_version = 0;
+		uint64_t skeleton_version = 0;
+		RID deformed_skeleton;
+		bool deformed_valid = false;
+		bool deform_queued = false;
+		LocalVector<Vector<Vector3>> deformed_surfaces;
+		AABB deformed_aabb;
+	};
+
+	mutable RID_Owner<DummyMeshInstance> mesh_instance_owner;
+
+	// Below this many instances, CPU deformation runs on the calling thread.
+	static constexpr uint32_t DEFORM_THREADED_MIN_INSTANCES = 2;
+
+	static void _decode_deform_surface(const RS::SurfaceData &p_surface, DummyMesh::DeformSurface &r_deform);
+	void _update_mesh_aabb(DummyMesh *p_mesh);
+	bool _mesh_instance_needs_deform(const DummyMeshInstance *p_mi) const;
+	void _mesh_instance_deform(DummyMeshInstance *p_mi) const;
+	void _mesh_instance_deform_task(uint32_t p_index, DummyMeshInstance **p_instances);
+
 public:
 	static MeshStorage *get_singleton() { return singleton; }
 
@@ -70,8 +123,8 @@ public:
 	virtual void mesh_initialize(RID p_rid) override;
 	virtual void mesh_free(RID p_rid) override;
 
-	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) override {}
-	virtual bool mesh_needs_instance(RID p_mesh, bool p_has_skeleton) override { return false; }
+	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count) override;
+	virtual bool mesh_needs_instance(RID p_mesh, bool p_has_skeleton) override;
 
 	virtual void mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface) override {
 		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
@@ -93,13 +146,16 @@ public:
 		s->blend_shape_data = p_surface.blend_shape_data;
 		s->uv_scale = p_surface.uv_scale;
 		s->material = p_surface.material;
+		m->deform_surfaces.push_back(DummyMesh::DeformSurface());
+		_decode_deform_surface(p_surface, m->deform_surfaces[m->deform_surfaces.size() - 1]);
+		_update_mesh_aabb(m);
 		m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MESH);
 	}
 
-	virtual int mesh_get_blend_shape_count(RID p_mesh) const override { return 0; }
+	virtual int mesh_get_blend_shape_count(RID p_mesh) const override;
 
-	virtual void mesh_set_blend_shape_mode(RID p_mesh, RS::BlendShapeMode p_mode) override {}
-	virtual RS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const override { return RS::BLEND_SHAPE_MODE_NORMALIZED; }
+	virtual void mesh_set_blend_shape_mode(RID p_mesh, RS::BlendShapeMode p_mode) override;
+	virtual RS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const override;
 
 	virtual void mesh_surface_update_vertex_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
 	virtual void mesh_surface_update_attribute_region(RID p_mesh, int p_surface, int p_offset, const Vector<uint8_t> &p_data) override {}
@@ -124,7 +180,7 @@ public:
 
 	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {}
 	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override { return AABB(); }
-	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override { return AABB(); }
+	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override;
 
 	virtual void mesh_set_path(RID p_mesh, const String &p_path) override {}
 	virtual String mesh_get_path(RID p_mesh) const override { return String(); }
@@ -136,15 +192,20 @@ public:
 
 	/* MESH INSTANCE */
 
-	virtual RID mesh_instance_create(RID p_base) override { return RID(); }
-	virtual void mesh_instance_free(RID p_rid) override {}
+	virtual RID mesh_instance_create(RID p_base) override;
+	virtual void mesh_instance_free(RID p_rid) override;
 
-	virtual void mesh_instance_set_skeleton(RID p_mesh_instance, RID p_skeleton) override {}
-	virtual void mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int p_shape, float p_weight) override {}
+	virtual void mesh_instance_set_skeleton(RID p_mesh_instance, RID p_skeleton) override;
+	virtual void mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int p_shape, float p_weight) override;
 	virtual void mesh_instance_check_for_update(RID p_mesh_instance) override {}
 	virtual void mesh_instance_set_canvas_item_transform(RID p_mesh_instance, const Transform2D &p_transform) override {}
 	virtual void update_mesh_instances() override {}
 
+	// Deformation is computed lazily on the CPU, when queried.
+	virtual void mesh_instances_update_deformed(const Vector<RID> &p_mesh_instances) override;
+	virtual AABB mesh_instance_get_deformed_aabb(RID p_mesh_instance) override;
+	virtual Vector<Vector3> mesh_instance_get_deformed_surface_vertices(RID p_mesh_instance, int p_surface) override;
+
 	/* MULTIMESH API */
 
 	bool owns_multimesh(RID p_rid) { return multimesh_owner.owns(p_rid); }
@@ -184,18 +245,20 @@ public:
 
 	/* SKELETON API */
 
-	virtual RID skeleton_allocate() override { return RID(); }
-	virtual void skeleton_initialize(RID p_rid) override {}
-	virtual void skeleton_free(RID p_rid) override {}
-	virtual void skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton = false) override {}
-	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) override {}
-	virtual int skeleton_get_bone_count(RID p_skeleton) const override { return 0; }
-	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) override {}
-	virtual Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const override { return Transform3D(); }
-	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) override {}
-	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const override { return Transform2D(); }
-
-	virtual void skeleton_update_dependency(RID p_base, DependencyTracker *p_instance) override {}
+	bool owns_skeleton(RID p_rid) { return skeleton_owner.owns(p_rid); }
+
+	virtual RID skeleton_allocate() override;
+	virtual void skeleton_initialize(RID p_rid) override;
+	virtual void skeleton_free(RID p_rid) override;
+	virtual void skeleton_allocate_data(RID p_skeleton, int p_bones, bool p_2d_skeleton = false) override;
+	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) override;
+	virtual int skeleton_get_bone_count(RID p_skeleton) const override;
+	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform3D &p_transform) override;
+	virtual Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const override;
+	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) override;
+	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const override;
+
+	virtual void skeleton_update_dependency(RID p_base, DependencyTracker *p_instance) override;
 
 	/* OCCLUDER */
 
@@ -0,0 +1,688 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/config/engine.h"
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RASTER_OCCLUSION_SSE2
+#endif
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+// Triangles are clipped against the near plane and a guard band around the screen in clip space,
+// which keeps the screen-space coordinates small enough for the edge functions to stay accurate.
+static const float CLIP_GUARD_BAND = 2.0f;
+static const int CLIP_PLANE_COUNT = 5;
+static const int CLIP_MAX_VERTICES = 3 + CLIP_PLANE_COUNT;
+
+struct ClipVertex {
+	float x, y, z, w;
+	float view_depth;
+	uint32_t outcode;
+};
+
+static _FORCE_INLINE_ float _clip_plane_distance(const ClipVertex &p_vertex, int p_plane) {
+	switch (p_plane) {
+		case 0:
+			return p_vertex.z + p_vertex.w; // Near.
+		case 1:
+			return p_vertex.x + CLIP_GUARD_BAND * p_vertex.w; // Left.
+		case 2:
+			return CLIP_GUARD_BAND * p_vertex.w - p_vertex.x; // Right.
+		case 3:
+			return p_vertex.y + CLIP_GUARD_BAND * p_vertex.w; // Bottom.
+		default:
+			return CLIP_GUARD_BAND * p_vertex.w - p_vertex.y; // Top.
+	}
+}
+
+static _FORCE_INLINE_ uint32_t _clip_outcode(const ClipVertex &p_vertex) {
+	uint32_t outcode = 0;
+	for (int i = 0; i < CLIP_PLANE_COUNT; i++) {
+		if (_clip_plane_distance(p_vertex, i) < 0.0f) {
+			outcode |= 1 << i;
+		}
+	}
+	return outcode;
+}
+
+// Sutherland-Hodgman clipping of a convex polygon against the planes in p_outcodes.
+// Returns the new vertex count, or 0 if nothing is left.
+static int _clip_polygon(ClipVertex *r_polygon, int p_count, uint32_t p_outcodes) {
+	ClipVertex temp[CLIP_MAX_VERTICES];
+	ClipVertex *src = r_polygon;
+	ClipVertex *dst = temp;
+
+	for (int plane = 0; plane < CLIP_PLANE_COUNT; plane++) {
+		if (!(p_outcodes & (1 << plane))) {
+			continue;
+		}
+
+		int count = 0;
+		for (int i = 0; i < p_count; i++) {
+			const ClipVertex &a = src[i];
+			const ClipVertex &b = src[(i + 1) % p_count];
+			const float dist_a = _clip_plane_distance(a, plane);
+			const float dist_b = _clip_plane_distance(b, plane);
+
+			if (dist_a >= 0.0f) {
+				dst[count++] = a;
+			}
+			if ((dist_a >= 0.0f) != (dist_b >= 0.0f)) {
+				const float t = dist_a / (dist_a - dist_b);
+				ClipVertex &v = dst[count++];
+				v.x = a.x + (b.x - a.x) * t;
+				v.y = a.y + (b.y - a.y) * t;
+				v.z = a.z + (b.z - a.z) * t;
+				v.w = a.w + (b.w - a.w) * t;
+				v.view_depth = a.view_depth + (b.view_depth - a.view_depth) * t;
+			}
+		}
+
+		p_count = count;
+		SWAP(src, dst);
+		if (p_count < 3) {
+			return 0;
+		}
+	}
+
+	if (src != r_polygon) {
+		memcpy(r_polygon, src, sizeof(ClipVertex) * p_count);
+	}
+	return p_count;
+}
+
+static void _emit_triangle(const ClipVertex &p_a, const ClipVertex &p_b, const ClipVertex &p_c, const Size2i &p_screen_size, const Vector2 &p_jitter, bool p_orthogonal, LocalVector<RasterOcclusionCull::ScreenTriangle> &r_triangles) {
+	const ClipVertex *vertices[3] = { &p_a, &p_b, &p_c };
+	float x[3];
+	float y[3];
+	float d[3];
+	for (int i = 0; i < 3; i++) {
+		const float inv_w = 1.0f / vertices[i]->w;
+		x[i] = (vertices[i]->x * inv_w * 0.5f + 0.5f) * p_screen_size.x + p_jitter.x;
+		y[i] = (vertices[i]->y * inv_w * 0.5f + 0.5f) * p_screen_size.y + p_jitter.y;
+		d[i] = p_orthogonal ? vertices[i]->view_depth : inv_w;
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+	if (Math::abs(area) < 1e-6f) {
+		return;
+	}
+	if (area < 0.0f) {
+		// Occluders are double-sided, so only the winding is fixed here.
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(d[1], d[2]);
+		area = -area;
+	}
+
+	RasterOcclusionCull::ScreenTriangle tri;
+	// Pixels are sampled at their centers, like the rays of RaycastOcclusionCull.
+	tri.min_x = MAX(0, (int)Math::ceil(MIN(x[0], MIN(x[1], x[2])) - 0.5f));
+	tri.max_x = MIN(p_screen_size.x - 1, (int)Math::floor(MAX(x[0], MAX(x[1], x[2])) - 0.5f));
+	tri.min_y = MAX(0, (int)Math::ceil(MIN(y[0], MIN(y[1], y[2])) - 0.5f));
+	tri.max_y = MIN(p_screen_size.y - 1, (int)Math::floor(MAX(y[0], MAX(y[1], y[2])) - 0.5f));
+	if (tri.min_x > tri.max_x || tri.min_y > tri.max_y) {
+		return; // Does not cover any pixel center.
+	}
+
+	for (int i = 0; i < 3; i++) {
+		const int j = (i + 1) % 3;
+		tri.edges[i][0] = y[i] - y[j];
+		tri.edges[i][1] = x[j] - x[i];
+		tri.edges[i][2] = -(tri.edges[i][0] * x[i] + tri.edges[i][1] * y[i]);
+	}
+
+	// Each edge weights the vertex opposite to it.
+	const float inv_area = 1.0f / area;
+	for (int i = 0; i < 3; i++) {
+		tri.depth_plane[i] = (tri.edges[1][i] * d[0] + tri.edges[2][i] * d[1] + tri.edges[0][i] * d[2]) * inv_area;
+	}
+
+	r_triangles.push_back(tri);
+}
+
+static void _rasterize_triangle(const RasterOcclusionCull::ScreenTriangle &p_tri, float *p_depth, uint32_t p_stride, int p_tile_x, int p_tile_y, bool p_orthogonal) {
+	const int tile_size = RasterOcclusionCull::TILE_SIZE;
+	// Start on a multiple of 4 so every step stays inside the tile. Pixels outside the triangle are rejected by the edge tests.
+	const int from_x = MAX(p_tile_x, p_tri.min_x) & ~3;
+	const int to_x = MIN(p_tile_x + tile_size - 1, p_tri.max_x);
+	const int from_y = MAX(p_tile_y, p_tri.min_y);
+	const int to_y = MIN(p_tile_y + tile_size - 1, p_tri.max_y);
+
+	if (from_x > to_x || from_y > to_y) {
+		return;
+	}
+
+	const float(*e)[3] = p_tri.edges;
+	const float *dp = p_tri.depth_plane;
+
+#ifdef RASTER_OCCLUSION_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 pixel_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128 e0_a = _mm_set1_ps(e[0][0]);
+	const __m128 e1_a = _mm_set1_ps(e[1][0]);
+	const __m128 e2_a = _mm_set1_ps(e[2][0]);
+	const __m128 depth_a = _mm_set1_ps(dp[0]);
+
+	for (int y = from_y; y <= to_y; y++) {
+		const float cy = y + 0.5f;
+		const __m128 e0_row = _mm_set1_ps(e[0][1] * cy + e[0][2]);
+		const __m128 e1_row = _mm_set1_ps(e[1][1] * cy + e[1][2]);
+		const __m128 e2_row = _mm_set1_ps(e[2][1] * cy + e[2][2]);
+		const __m128 depth_row = _mm_set1_ps(dp[1] * cy + dp[2]);
+		float *row = p_depth + y * p_stride;
+
+		for (int x = from_x; x <= to_x; x += 4) {
+			const __m128 cx = _mm_add_ps(_mm_set1_ps((float)x), pixel_offsets);
+			const __m128 e0 = _mm_add_ps(_mm_mul_ps(e0_a, cx), e0_row);
+			const __m128 e1 = _mm_add_ps(_mm_mul_ps(e1_a, cx), e1_row);
+			const __m128 e2 = _mm_add_ps(_mm_mul_ps(e2_a, cx), e2_row);
+			const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+			if (_mm_movemask_ps(inside) == 0) {
+				continue;
+			}
+
+			__m128 depth = _mm_add_ps(_mm_mul_ps(depth_a, cx), depth_row);
+			if (!p_orthogonal) {
+				depth = _mm_div_ps(one, depth);
+			}
+
+			const __m128 current = _mm_loadu_ps(row + x);
+			const __m128 closest = _mm_min_ps(current, depth);
+			_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+		}
+	}
+#else
+	for (int y = from_y; y <= to_y; y++) {
+		const float cy = y + 0.5f;
+		float *row = p_depth + y * p_stride;
+
+		for (int x = from_x; x <= to_x; x++) {
+			const float cx = x + 0.5f;
+			if (e[0][0] * cx + e[0][1] * cy + e[0][2] < 0.0f || e[1][0] * cx + e[1][1] * cy + e[1][2] < 0.0f || e[2][0] * cx + e[2][1] * cy + e[2][2] < 0.0f) {
+				continue;
+			}
+
+			float depth = dp[0] * cx + dp[1] * cy + dp[2];
+			if (!p_orthogonal) {
+				depth = 1.0f / depth;
+			}
+			row[x] = MIN(row[x], depth);
+		}
+	}
+#endif
+}
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	raster_depth.clear();
+	tile_bins.clear();
+	instance_triangles.clear();
+	triangles.clear();
+	tile_grid_size = Size2i();
+	stride = 0;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	HZBuffer::resize(p_size);
+
+	if (is_empty()) {
+		return;
+	}
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	stride = tile_grid_size.x * TILE_SIZE;
+	raster_depth.resize(stride * tile_grid_size.y * TILE_SIZE);
+	tile_bins.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_bin_triangles() {
+	for (LocalVector<uint32_t> &bin : tile_bins) {
+		bin.clear();
+	}
+
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const ScreenTriangle &tri = triangles[i];
+		for (int tile_y = tri.min_y / TILE_SIZE; tile_y <= tri.max_y / TILE_SIZE; tile_y++) {
+			for (int tile_x = tri.min_x / TILE_SIZE; tile_x <= tri.max_x / TILE_SIZE; tile_x++) {
+				tile_bins[tile_y * tile_grid_size.x + tile_x].push_back(i);
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const RasterThreadData *p_data) {
+	const int tile_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	const int tile_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+
+	for (int y = tile_y; y < tile_y + TILE_SIZE; y++) {
+		float *row = raster_depth.ptr() + y * stride + tile_x;
+		for (int x = 0; x < TILE_SIZE; x++) {
+			row[x] = FLT_MAX;
+		}
+	}
+
+	for (const uint32_t &index : tile_bins[p_tile]) {
+		_rasterize_triangle(triangles[index], raster_depth.ptr(), stride, tile_x, tile_y, p_data->camera_orthogonal);
+	}
+
+	// The HZBuffer holds distances from the camera, like the ray hits of RaycastOcclusionCull,
+	// so perspective view depth is scaled by the length of the view ray through each pixel.
+	const Size2i &buffer_size = sizes[0];
+	const int end_x = MIN(tile_x + TILE_SIZE, buffer_size.x);
+	const int end_y = MIN(tile_y + TILE_SIZE, buffer_size.y);
+
+	for (int y = tile_y; y < end_y; y++) {
+		const float *row = raster_depth.ptr() + y * stride;
+		float *dst = mips[0] + y * buffer_size.x;
+		for (int x = tile_x; x < end_x; x++) {
+			float depth = row[x];
+			if (depth == FLT_MAX) {
+				dst[x] = p_data->z_far;
+				continue;
+			}
+
+			if (!p_data->camera_orthogonal) {
+				const Vector4 near_point = p_data->inv_projection.xform(Vector4((x + 0.5f) / buffer_size.x * 2.0f - 1.0f, (y + 0.5f) / buffer_size.y * 2.0f - 1.0f, -1.0f, 1.0f));
+				const Vector3 ray = Vector3(near_point.x, near_point.y, near_point.z) / near_point.w;
+				depth *= ray.length() / -ray.z;
+			}
+			dst[x] = MIN(depth, p_data->z_far);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	uint32_t triangle_count = 0;
+	for (const LocalVector<ScreenTriangle> &list : instance_triangles) {
+		triangle_count += list.size();
+	}
+	triangles.resize(triangle_count);
+	triangle_count = 0;
+	for (const LocalVector<ScreenTriangle> &list : instance_triangles) {
+		if (list.size()) {
+			memcpy(triangles.ptr() + triangle_count, list.ptr(), list.size() * sizeof(ScreenTriangle));
+			triangle_count += list.size();
+		}
+	}
+
+	_bin_triangles();
+
+	RasterThreadData td;
+	td.inv_projection = p_cam_projection.inverse();
+	td.camera_orthogonal = p_cam_orthogonal;
+	td.z_far = p_cam_projection.get_z_far() * 1.05f;
+
+	debug_tex_range = td.z_far;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile, &td, tile_bins.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	update_mips();
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		ERR_CONTINUE(!scenario->instances.has(E.instance));
+
+		if (!scenario->dirty_instances.has(E.instance)) {
+			scenario->dirty_instances.insert(E.instance);
+			scenario->dirty_instances_array.push_back(E.instance);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	if (!scenario->instances.has(p_instance)) {
+		scenario->instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario->removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	instance.enabled = p_enabled;
+
+	if (changed && !scenario->dirty_instances.has(p_instance)) {
+		scenario->dirty_instances.insert(p_instance);
+		scenario->dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (instance && !instance->removed) {
+		Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		scenario->removed_instances.push_back(p_instance);
+		instance->removed = true;
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(OccluderInstance *p_instance) {
+	const Occluder *occ = raster_singleton->occluder_owner.get_or_null(p_instance->occluder);
+
+	if (!occ) {
+		p_instance->xformed_vertices.clear();
+		p_instance->indices.clear();
+		p_instance->aabb = AABB();
+		return;
+	}
+
+	const int vertex_count = occ->vertices.size();
+	const Vector3 *read = occ->vertices.ptr();
+	p_instance->xformed_vertices.resize(vertex_count);
+
+	for (int i = 0; i < vertex_count; i++) {
+		const Vector3 v = p_instance->xform.xform(read[i]);
+		p_instance->xformed_vertices[i] = v;
+		if (i == 0) {
+			p_instance->aabb = AABB(v, Vector3());
+		} else {
+			p_instance->aabb.expand_to(v);
+		}
+	}
+
+	p_instance->indices = occ->indices;
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	for (const RID &instance : dirty_instances_array) {
+		OccluderInstance *occ_inst = instances.getptr(instance);
+		if (occ_inst) {
+			_update_dirty_instance(occ_inst);
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+Vector2 RasterOcclusionCull::_get_jitter_offset() const {
+	if (!HZBuffer::occlusion_jitter_enabled) {
+		return Vector2();
+	}
+
+	// Same pattern as RaycastOcclusionCull, which moves the near plane by 0.66 half-pixels, i.e. 0.33 pixels.
+	static const Vector2 pattern[9] = {
+		Vector2(0, 0),
+		Vector2(-1, -1),
+		Vector2(1, -1),
+		Vector2(-1, 1),
+		Vector2(1, 1),
+		Vector2(-0.5f, -0.5f),
+		Vector2(0.5f, -0.5f),
+		Vector2(-0.5f, 0.5f),
+		Vector2(0.5f, 0.5f),
+	};
+
+	return pattern[Engine::get_singleton()->get_frames_drawn() % 9] * 0.33f;
+}
+
+void RasterOcclusionCull::_setup_instance_triangles(uint32_t p_index, SetupThreadData *p_data) {
+	const OccluderInstance *instance = p_data->instances[p_index];
+	LocalVector<ScreenTriangle> &triangles = p_data->buffer->instance_triangles[p_index];
+	triangles.clear();
+
+	const Size2i screen_size = p_data->buffer->get_occlusion_buffer_size();
+	const uint32_t vertex_count = instance->xformed_vertices.size();
+
+	LocalVector<ClipVertex> clip_vertices;
+	clip_vertices.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		const Vector3 view = p_data->view.xform(instance->xformed_vertices[i]);
+		const Vector4 clip = p_data->projection.xform(Vector4(view.x, view.y, view.z, 1.0f));
+		ClipVertex &v = clip_vertices[i];
+		v.x = clip.x;
+		v.y = clip.y;
+		v.z = clip.z;
+		v.w = clip.w;
+		v.view_depth = -view.z;
+		v.outcode = _clip_outcode(v);
+	}
+
+	const int32_t *indices = instance->indices.ptr();
+	const uint32_t index_count = instance->indices.size() - instance->indices.size() % 3;
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		if ((uint32_t)indices[i] >= vertex_count || (uint32_t)indices[i + 1] >= vertex_count || (uint32_t)indices[i + 2] >= vertex_count) {
+			continue;
+		}
+
+		const ClipVertex &a = clip_vertices[indices[i]];
+		const ClipVertex &b = clip_vertices[indices[i + 1]];
+		const ClipVertex &c = clip_vertices[indices[i + 2]];
+
+		if (a.outcode & b.outcode & c.outcode) {
+			continue; // All vertices are outside the same plane.
+		}
+
+		const uint32_t outcodes = a.outcode | b.outcode | c.outcode;
+		if (outcodes == 0) {
+			_emit_triangle(a, b, c, screen_size, p_data->jitter, p_data->camera_orthogonal, triangles);
+			continue;
+		}
+
+		ClipVertex polygon[CLIP_MAX_VERTICES] = { a, b, c };
+		const int count = _clip_polygon(polygon, 3, outcodes);
+		for (int j = 1; j + 1 < count; j++) {
+			_emit_triangle(polygon[0], polygon[j], polygon[j + 1], screen_size, p_data->jitter, p_data->camera_orthogonal, triangles);
+		}
+	}
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	scenario->update();
+
+	// Whole instances outside the frustum are skipped here, the rest is clipped per triangle.
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	visible_instances.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled || instance.indices.is_empty()) {
+			continue;
+		}
+
+		const Vector3 center = instance.aabb.get_center();
+		const Vector3 half_extents = instance.aabb.size * 0.5f;
+		bool outside = false;
+		for (const Plane &plane : planes) {
+			if (plane.distance_to(center) > half_extents.dot(plane.normal.abs())) {
+				outside = true;
+				break;
+			}
+		}
+
+		if (!outside) {
+			visible_instances.push_back(&instance);
+		}
+	}
+
+	buffer->instance_triangles.resize(visible_instances.size());
+
+	if (!visible_instances.is_empty()) {
+		SetupThreadData td;
+		td.instances = visible_instances.ptr();
+		td.buffer = buffer;
+		td.view = p_cam_transform.affine_inverse();
+		td.projection = p_cam_projection;
+		td.jitter = _get_jitter_offset();
+		td.camera_orthogonal = p_cam_orthogonal;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_instance_triangles, &td, visible_instances.size(), -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	buffer->rasterize(p_cam_projection, p_cam_orthogonal);
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
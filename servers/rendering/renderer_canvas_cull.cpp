@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -78,8 +79,71 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	int chunk_count = 1;
+	if (p_child_item_count > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		// Only this canvas' items count, counting stops once there are enough to be worth threading.
+		int item_count = 0;
+		for (int i = 0; i < p_child_item_count && item_count < CULL_THREADED_MIN_ITEMS; i++) {
+			item_count += _count_canvas_items(p_child_items[i].item, CULL_THREADED_MIN_ITEMS - item_count);
+		}
+		if (item_count >= CULL_THREADED_MIN_ITEMS) {
+			chunk_count = MIN(p_child_item_count, pool->get_thread_count() * 2);
+		}
+
+		for (int i = 0; i < p_child_item_count && chunk_count > 1; i++) {
+			if (!_update_canvas_item_rects(p_child_items[i].item, p_canvas_cull_mask)) {
+				chunk_count = 1;
+			}
+		}
+	}
+
+	if (chunk_count > 1) {
+		uint32_t z_lists_size = chunk_count * z_range * 2;
+		if (cull_chunk_z_lists.size() < z_lists_size) {
+			uint32_t old_size = cull_chunk_z_lists.size();
+			cull_chunk_z_lists.resize(z_lists_size);
+			memset(cull_chunk_z_lists.ptr() + old_size, 0, (z_lists_size - old_size) * sizeof(RendererCanvasRender::Item *));
+		}
+
+		CullThreadData data;
+		data.child_items = p_child_items;
+		data.child_item_count = p_child_item_count;
+		data.chunk_count = chunk_count;
+		data.transform = p_transform;
+		data.clip_rect = p_clip_rect;
+		data.canvas_cull_mask = p_canvas_cull_mask;
+
+		WorkerThreadPool::GroupID group_task = pool->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_items_threaded, &data, chunk_count, -1, true, SNAME("CanvasCull"));
+		pool->wait_for_group_task_completion(group_task);
+
+		// Append the chunks in order, clearing their lists for the next use.
+		for (int i = 0; i < chunk_count; i++) {
+			RendererCanvasRender::Item **chunk_z_list = cull_chunk_z_lists.ptr() + i * z_range * 2;
+			RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+			for (int j = 0; j < z_range; j++) {
+				if (!chunk_z_list[j]) {
+					continue;
+				}
+				if (z_last_list[j]) {
+					z_last_list[j]->next = chunk_z_list[j];
+				} else {
+					z_list[j] = chunk_z_list[j];
+				}
+				z_last_list[j] = chunk_z_last_list[j];
+				chunk_z_list[j] = nullptr;
+				chunk_z_last_list[j] = nullptr;
+			}
+		}
+	} else {
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
+	}
+
+	if (cull_redraw_requested.is_set()) {
+		cull_redraw_requested.clear();
+		RenderingServerDefault::redraw_request();
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
@@ -107,6 +171,53 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	}
 }
 
+int RendererCanvasCull::_count_canvas_items(const Item *p_canvas_item, int p_max_count) const {
+	int count = 1;
+	for (const Item *child : p_canvas_item->child_items) {
+		if (count >= p_max_count) {
+			break;
+		}
+		count += _count_canvas_items(child, p_max_count - count);
+	}
+	return count;
+}
+
+bool RendererCanvasCull::_update_canvas_item_rects(const Item *p_canvas_item, uint32_t p_canvas_cull_mask) const {
+	// Same early outs as _cull_canvas_item(), items it won't reach don't need a rect.
+	if (!p_canvas_item->visible || !(p_canvas_item->visibility_layer & p_canvas_cull_mask)) {
+		return true;
+	}
+
+	if (!p_canvas_item->custom_rect && (p_canvas_item->update_when_visible || p_canvas_item->skeleton.is_valid())) {
+		// The rect isn't cached, so the storage would be queried again from the worker threads.
+		for (const Item::Command *c = p_canvas_item->commands; c; c = c->next) {
+			if (c->type == Item::Command::TYPE_MESH || c->type == Item::Command::TYPE_MULTIMESH || c->type == Item::Command::TYPE_PARTICLES) {
+				return false;
+			}
+		}
+	}
+
+	p_canvas_item->get_rect();
+	for (const Item *child : p_canvas_item->child_items) {
+		if (!_update_canvas_item_rects(child, p_canvas_cull_mask)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void RendererCanvasCull::_cull_canvas_items_threaded(uint32_t p_chunk, CullThreadData *p_data) {
+	int from = p_chunk * p_data->child_item_count / p_data->chunk_count;
+	int to = (p_chunk + 1) * p_data->child_item_count / p_data->chunk_count;
+
+	RendererCanvasRender::Item **chunk_z_list = cull_chunk_z_lists.ptr() + p_chunk * z_range * 2;
+	RendererCanvasRender::Item **chunk_z_last_list = chunk_z_list + z_range;
+
+	for (int i = from; i < to; i++) {
+		_cull_canvas_item(p_data->child_items[i].item, p_data->transform, p_data->clip_rect, Color(1, 1, 1, 1), 0, chunk_z_list, chunk_z_last_list, nullptr, nullptr, false, p_data->canvas_cull_mask, Point2(), 1, nullptr);
+	}
+}
+
 void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
 	int child_item_count = p_canvas_item->child_items.size();
 	RendererCanvasCull::Item **child_items = p_canvas_item->child_items.ptrw();
@@ -156,6 +267,77 @@ void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_can
 	}
 }
 
+void RendererCanvasCull::_sort_ysort_children(RendererCanvasCull::Item *p_ysort_owner, RendererCanvasCull::Item **r_items, int p_count) {
+	// r_items comes in collection order, so an item's `ysort_index` is its position in it.
+	LocalVector<int> &order = p_ysort_owner->ysort_order;
+	ItemYSort compare;
+	bool sorted = false;
+
+	if (int(order.size()) == p_count) {
+		// Start from last frame's order. Items that moved are no longer between
+		// their neighbors; set them aside, sort them and merge them back in.
+		thread_local LocalVector<Item *> scratch;
+		if (int(scratch.size()) < p_count * 2) {
+			scratch.resize(p_count * 2);
+		}
+		Item **previous = scratch.ptr();
+		Item **moved = previous + p_count;
+
+		for (int i = 0; i < p_count; i++) {
+			previous[i] = r_items[order[i]];
+		}
+
+		int kept_count = 0;
+		int moved_count = 0;
+		const int max_moved = MAX(p_count / YSORT_INCREMENTAL_MAX_MOVED_DIVISOR, 1);
+		Item *prev = nullptr;
+		for (int i = 0; i < p_count && moved_count <= max_moved; i++) {
+			Item *item = previous[i];
+			if ((prev && compare(item, prev)) || (i + 1 < p_count && compare(previous[i + 1], item))) {
+				moved[moved_count++] = item;
+			} else {
+				previous[kept_count++] = item;
+			}
+			prev = item;
+		}
+
+		bool kept_sorted = moved_count <= max_moved;
+		for (int i = 1; i < kept_count && kept_sorted; i++) {
+			kept_sorted = !compare(previous[i], previous[i - 1]);
+		}
+
+		if (kept_sorted) {
+			if (moved_count > 0) {
+				SortArray<Item *, ItemYSort> sorter;
+				sorter.sort(moved, moved_count);
+				ysort_incremental_sorts.increment();
+			}
+
+			int k = 0;
+			int m = 0;
+			for (int i = 0; i < p_count; i++) {
+				if (m < moved_count && (k == kept_count || compare(moved[m], previous[k]))) {
+					r_items[i] = moved[m++];
+				} else {
+					r_items[i] = previous[k++];
+				}
+			}
+			sorted = true;
+		}
+	}
+
+	if (!sorted) {
+		SortArray<Item *, ItemYSort> sorter;
+		sorter.sort(r_items, p_count);
+		ysort_full_sorts.increment();
+	}
+
+	order.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		order[i] = r_items[i]->ysort_index;
+	}
+}
+
 int RendererCanvasCull::_count_ysort_children(RendererCanvasCull::Item *p_canvas_item) {
 	int ysort_children_count = 0;
 	int child_item_count = p_canvas_item->child_items.size();
@@ -250,7 +432,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		// Something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			cull_redraw_requested.set();
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -278,7 +460,9 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				visibility_notifier_lock.lock();
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				visibility_notifier_lock.unlock();
 				ci->visibility_notifier->just_visible = true;
 			}
 
@@ -440,9 +624,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			child_items[0] = ci;
 			int i = 1;
 			_collect_ysort_children(ci, p_material_owner, Color(1, 1, 1, 1), child_items, i, p_z);
-
-			SortArray<Item *, ItemYSort> sorter;
-			sorter.sort(child_items, child_item_count);
+			_sort_ysort_children(ci, child_items, child_item_count);
 
 			for (i = 0; i < child_item_count; i++) {
 				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
@@ -2543,7 +2725,15 @@ void RendererCanvasCull::_update_dirty_item(Item *p_item) {
 	p_item->update_dependencies = false;
 }
 
+void RendererCanvasCull::update_ysort_info() {
+	ysort_full_sorts_in_frame = ysort_full_sorts.get();
+	ysort_full_sorts.set(0);
+	ysort_incremental_sorts_in_frame = ysort_incremental_sorts.get();
+	ysort_incremental_sorts.set(0);
+}
+
 void RendererCanvasCull::update() {
+	update_ysort_info();
 	update_dirty_items();
 }
 
@@ -31,7 +31,9 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/os/spin_lock.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 #include "servers/rendering/instance_uniforms.h"
@@ -58,6 +60,7 @@ public:
 		Transform2D ysort_xform; // Relative to y-sorted subtree's root item (identity for such root). Its `origin.y` is used for sorting.
 		int ysort_index;
 		int ysort_parent_abs_z_index; // Absolute Z index of parent. Only populated and used when y-sorting.
+		LocalVector<int> ysort_order; // For y-sort roots, the `ysort_index` of each item in last frame's sorted order.
 		uint32_t visibility_layer = 0xffffffff;
 
 		Vector<Item *> child_items;
@@ -201,6 +204,17 @@ public:
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
+	SpinLock visibility_notifier_lock;
+	// Y-sorts start from the previous frame's order and only re-sort the items that moved,
+	// unless more than 1/YSORT_INCREMENTAL_MAX_MOVED_DIVISOR of them did.
+	static constexpr int YSORT_INCREMENTAL_MAX_MOVED_DIVISOR = 4;
+	SafeNumeric<uint32_t> ysort_full_sorts;
+	SafeNumeric<uint32_t> ysort_incremental_sorts;
+	uint32_t ysort_full_sorts_in_frame = 0;
+	uint32_t ysort_incremental_sorts_in_frame = 0;
+
+	// Set while culling instead of calling RenderingServerDefault::redraw_request() directly, so culling threads don't race on it.
+	SafeFlag cull_redraw_requested;
 
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
@@ -217,6 +231,31 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Top level items of a canvas are culled on worker threads in chunks, each into its own z lists,
+	// which are then appended in child order so the result is the same as culling serially.
+	// Each top level item is culled with its whole subtree in one chunk, so the repeat source an item
+	// reads `final_transform` from (itself or an ancestor) is never written by another chunk.
+	static constexpr int CULL_THREADED_MIN_ITEMS = 2048;
+
+	struct CullThreadData {
+		Canvas::ChildItem *child_items = nullptr;
+		int child_item_count = 0;
+		int chunk_count = 0;
+		Transform2D transform;
+		Rect2 clip_rect;
+		uint32_t canvas_cull_mask = 0;
+	};
+
+	// Per chunk z_list followed by z_last_list, kept cleared between uses.
+	LocalVector<RendererCanvasRender::Item *> cull_chunk_z_lists;
+
+	int _count_canvas_items(const Item *p_canvas_item, int p_max_count) const;
+	// Computing the rect of mesh, multimesh and particles items writes to their storage,
+	// so dirty rects are resolved serially before the worker threads read them.
+	// Returns false if an item recomputes its rect on every call, then the canvas is culled serially.
+	bool _update_canvas_item_rects(const Item *p_canvas_item, uint32_t p_canvas_cull_mask) const;
+	void _cull_canvas_items_threaded(uint32_t p_chunk, CullThreadData *p_data);
+
 	Transform2D _current_camera_transform;
 
 public:
@@ -373,6 +412,14 @@ public:
 	void canvas_item_set_default_texture_repeat(RID p_item, RS::CanvasItemTextureRepeat p_repeat);
 
 	void update_visibility_notifiers();
+
+	// Sorts r_items (in collection order) by y, starting from the order p_ysort_owner's subtree had last time.
+	void _sort_ysort_children(RendererCanvasCull::Item *p_ysort_owner, RendererCanvasCull::Item **r_items, int p_count);
+
+	// Latches the number of y-sorts since the last call, as reported by the get_ysort_*_in_frame() getters.
+	void update_ysort_info();
+	uint32_t get_ysort_full_sorts_in_frame() const { return ysort_full_sorts_in_frame; }
+	uint32_t get_ysort_incremental_sorts_in_frame() const { return ysort_incremental_sorts_in_frame; }
 	void update_dirty_items();
 
 	void _update_dirty_item(Item *p_item);
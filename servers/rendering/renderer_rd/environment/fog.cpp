@@ -311,19 +311,16 @@ void Fog::free_fog_shader() {
 	}
 }
 
-void Fog::FogShaderData::set_code(const String &p_code) {
-	//compile
-
+Error Fog::FogShaderData::_compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) {
 	code = p_code;
 	valid = false;
 	ubo_size = 0;
 	uniforms.clear();
 
 	if (code.is_empty()) {
-		return; //just invalid, but no error
+		return OK;
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
 	ShaderCompiler::IdentifierActions actions;
 	actions.entry_point_stages["fog"] = ShaderCompiler::STAGE_COMPUTE;
 
@@ -333,11 +330,21 @@ void Fog::FogShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
-	Fog *fog_singleton = Fog::get_singleton();
+	return Fog::get_singleton()->volumetric_fog.compiler.compile(RS::SHADER_FOG, code, &actions, path, r_gen_code);
+}
+
+void Fog::FogShaderData::set_code(const String &p_code) {
+	ShaderCompiler::GeneratedCode gen_code;
+	Error err = _take_compiled_code(p_code, gen_code);
+
+	if (code.is_empty()) {
+		return; //just invalid, but no error
+	}
 
-	Error err = fog_singleton->volumetric_fog.compiler.compile(RS::SHADER_FOG, code, &actions, path, gen_code);
 	ERR_FAIL_COND_MSG(err != OK, "Fog shader compilation failed.");
 
+	Fog *fog_singleton = Fog::get_singleton();
+
 	if (version.is_null()) {
 		version = fog_singleton->volumetric_fog.shader.version_create();
 	}
@@ -199,6 +199,7 @@ private:
 
 		bool uses_time = false;
 
+		virtual Error _compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code);
 		virtual void set_code(const String &p_Code);
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
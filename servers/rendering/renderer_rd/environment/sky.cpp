@@ -51,19 +51,16 @@ using namespace RendererRD;
 ////////////////////////////////////////////////////////////////////////////////
 // SKY SHADER
 
-void SkyRD::SkyShaderData::set_code(const String &p_code) {
-	//compile
-
+Error SkyRD::SkyShaderData::_compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) {
 	code = p_code;
 	valid = false;
 	ubo_size = 0;
 	uniforms.clear();
 
 	if (code.is_empty()) {
-		return; //just invalid, but no error
+		return OK;
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
 	ShaderCompiler::IdentifierActions actions;
 	actions.entry_point_stages["sky"] = ShaderCompiler::STAGE_FRAGMENT;
 
@@ -104,9 +101,21 @@ void SkyRD::SkyShaderData::set_code(const String &p_code) {
 	// !BAS! Contemplate making `SkyShader sky` accessible from this struct or even part of this struct.
 	RendererSceneRenderRD *scene_singleton = static_cast<RendererSceneRenderRD *>(RendererSceneRenderRD::singleton);
 
-	Error err = scene_singleton->sky.sky_shader.compiler.compile(RS::SHADER_SKY, code, &actions, path, gen_code);
+	return scene_singleton->sky.sky_shader.compiler.compile(RS::SHADER_SKY, code, &actions, path, r_gen_code);
+}
+
+void SkyRD::SkyShaderData::set_code(const String &p_code) {
+	ShaderCompiler::GeneratedCode gen_code;
+	Error err = _take_compiled_code(p_code, gen_code);
+
+	if (code.is_empty()) {
+		return; //just invalid, but no error
+	}
+
 	ERR_FAIL_COND_MSG(err != OK, "Shader compilation failed.");
 
+	RendererSceneRenderRD *scene_singleton = static_cast<RendererSceneRenderRD *>(RendererSceneRenderRD::singleton);
+
 	if (version.is_null()) {
 		version = scene_singleton->sky.sky_shader.shader.version_create();
 	}
@@ -125,6 +125,7 @@ private:
 		bool uses_quarter_res = false;
 		bool uses_light = false;
 
+		virtual Error _compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code);
 		virtual void set_code(const String &p_Code);
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
@@ -37,24 +37,20 @@
 
 using namespace RendererSceneRenderImplementation;
 
-void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
-	//compile
-
+Error SceneShaderForwardClustered::ShaderData::_compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) {
 	code = p_code;
 	ubo_size = 0;
 	uniforms.clear();
 	_clear_vertex_input_mask_cache();
 
 	if (code.is_empty()) {
-		return; //just invalid, but no error
+		return OK;
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
-
 	blend_mode = BLEND_MODE_MIX;
 	depth_testi = DEPTH_TEST_ENABLED;
 	alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
-	int cull_modei = RS::CULL_MODE_BACK;
+	cull_modei = RS::CULL_MODE_BACK;
 
 	uses_point_size = false;
 	uses_alpha = false;
@@ -79,7 +75,7 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	uses_world_coordinates = false;
 	uses_particle_trails = false;
 
-	int depth_drawi = DEPTH_DRAW_OPAQUE;
+	depth_drawi = DEPTH_DRAW_OPAQUE;
 
 	ShaderCompiler::IdentifierActions actions;
 	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
@@ -141,9 +137,18 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
-	MutexLock lock(SceneShaderForwardClustered::singleton_mutex);
-	Error err = SceneShaderForwardClustered::singleton->compiler.compile(RS::SHADER_SPATIAL, code, &actions, path, gen_code);
+	return SceneShaderForwardClustered::singleton->compiler.compile(RS::SHADER_SPATIAL, code, &actions, path, r_gen_code);
+}
 
+void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
+	ShaderCompiler::GeneratedCode gen_code;
+	Error err = _take_compiled_code(p_code, gen_code);
+
+	if (code.is_empty()) {
+		return; //just invalid, but no error
+	}
+
+	MutexLock lock(SceneShaderForwardClustered::singleton_mutex);
 	if (err != OK) {
 		if (version.is_valid()) {
 			SceneShaderForwardClustered::singleton->shader.version_free(version);
@@ -215,6 +215,8 @@ public:
 
 		int blend_mode = BLEND_MODE_MIX;
 		int depth_testi = DEPTH_TEST_ENABLED;
+		int depth_drawi = DEPTH_DRAW_OPAQUE;
+		int cull_modei = RS::CULL_MODE_BACK;
 		int alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
 
 		bool uses_point_size = false;
@@ -271,6 +273,7 @@ public:
 			return !uses_particle_trails && !writes_modelview_or_projection && !uses_vertex && !uses_position && !uses_discard && !uses_depth_prepass_alpha && !uses_alpha_clip && !uses_alpha_antialiasing && backface_culling && !uses_point_size && !uses_world_coordinates && !wireframe;
 		}
 
+		virtual Error _compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code);
 		virtual void set_code(const String &p_Code);
 
 		virtual bool is_animated() const;
@@ -1528,9 +1528,7 @@ void RendererCanvasRenderRD::CanvasShaderData::_create_pipeline(PipelineKey p_pi
 	pipeline_hash_map.add_compiled_pipeline(p_pipeline_key.hash(), pipeline);
 }
 
-void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
-	//compile
-
+Error RendererCanvasRenderRD::CanvasShaderData::_compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) {
 	code = p_code;
 	ubo_size = 0;
 	uniforms.clear();
@@ -1541,11 +1539,9 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 	_clear_vertex_input_mask_cache();
 
 	if (code.is_empty()) {
-		return; //just invalid, but no error
+		return OK;
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
-
 	blend_mode = BLEND_MODE_MIX;
 
 	ShaderCompiler::IdentifierActions actions;
@@ -1565,10 +1561,21 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
+	RendererCanvasRenderRD *canvas_singleton = static_cast<RendererCanvasRenderRD *>(RendererCanvasRender::singleton);
+	return canvas_singleton->shader.compiler.compile(RS::SHADER_CANVAS_ITEM, code, &actions, path, r_gen_code);
+}
+
+void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
+	ShaderCompiler::GeneratedCode gen_code;
+	Error err = _take_compiled_code(p_code, gen_code);
+
+	if (code.is_empty()) {
+		return; //just invalid, but no error
+	}
+
 	RendererCanvasRenderRD *canvas_singleton = static_cast<RendererCanvasRenderRD *>(RendererCanvasRender::singleton);
 	MutexLock lock(canvas_singleton->shader.mutex);
 
-	Error err = canvas_singleton->shader.compiler.compile(RS::SHADER_CANVAS_ITEM, code, &actions, path, gen_code);
 	if (err != OK) {
 		if (version.is_valid()) {
 			canvas_singleton->shader.canvas_shader.version_free(version);
@@ -166,6 +166,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		void _clear_vertex_input_mask_cache();
 		void _create_pipeline(PipelineKey p_pipeline_key);
+		virtual Error _compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code);
 		virtual void set_code(const String &p_Code);
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
@@ -298,6 +298,7 @@ RendererCompositorRD::RendererCompositorRD() {
 					bool strip_debug = GLOBAL_GET("rendering/shader_compiler/shader_cache/strip_debug");
 
 					ShaderRD::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_shader_cache_dir(shader_cache_dir.path_join("compiler"));
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
@@ -342,4 +343,5 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(uniform_set_cache);
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_dir(String());
+	ShaderCompiler::set_shader_cache_dir(String());
 }
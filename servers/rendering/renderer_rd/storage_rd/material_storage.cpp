@@ -32,6 +32,7 @@
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering/renderer_rd/forward_clustered/scene_shader_forward_clustered.h"
 #include "servers/rendering/renderer_rd/forward_mobile/scene_shader_forward_mobile.h"
 #include "servers/rendering/storage/variant_converters.h"
@@ -558,6 +559,25 @@ void MaterialStorage::ShaderData::set_path_hint(const String &p_hint) {
 	path = p_hint;
 }
 
+void MaterialStorage::ShaderData::compile_code(const String &p_code) {
+	compiled_gen_code = ShaderCompiler::GeneratedCode();
+	compile_error = _compile_code(p_code, compiled_gen_code);
+	compiled_code = p_code;
+	code_compiled = true;
+}
+
+Error MaterialStorage::ShaderData::_take_compiled_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) {
+	if (!code_compiled || compiled_code != p_code) {
+		compile_code(p_code);
+	}
+
+	r_gen_code = compiled_gen_code;
+	compiled_gen_code = ShaderCompiler::GeneratedCode();
+	compiled_code = String();
+	code_compiled = false;
+	return compile_error;
+}
+
 void MaterialStorage::ShaderData::set_default_texture_parameter(const StringName &p_name, RID p_texture, int p_index) {
 	if (!p_texture.is_valid()) {
 		if (default_texture_params.has(p_name) && default_texture_params[p_name].has(p_index)) {
@@ -1947,11 +1967,7 @@ void MaterialStorage::shader_free(RID p_rid) {
 	shader_owner.free(p_rid);
 }
 
-void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
-	Shader *shader = shader_owner.get_or_null(p_shader);
-	ERR_FAIL_NULL(shader);
-
-	shader->code = p_code;
+void MaterialStorage::_shader_set_type(Shader *p_shader, const String &p_code) {
 	String mode_string = ShaderLanguage::get_shader_type(p_code);
 
 	ShaderType new_type;
@@ -1969,13 +1985,13 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 		new_type = SHADER_TYPE_MAX;
 	}
 
-	if (new_type != shader->type) {
-		if (shader->data) {
-			memdelete(shader->data);
-			shader->data = nullptr;
+	if (new_type != p_shader->type) {
+		if (p_shader->data) {
+			memdelete(p_shader->data);
+			p_shader->data = nullptr;
 		}
 
-		for (Material *E : shader->owners) {
+		for (Material *E : p_shader->owners) {
 			Material *material = E;
 			material->shader_type = new_type;
 			if (material->data) {
@@ -1984,18 +2000,18 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			}
 		}
 
-		shader->type = new_type;
+		p_shader->type = new_type;
 
 		if (new_type < SHADER_TYPE_MAX && shader_data_request_func[new_type]) {
-			shader->data = shader_data_request_func[new_type]();
+			p_shader->data = shader_data_request_func[new_type]();
 		} else {
-			shader->type = SHADER_TYPE_MAX; //invalid
+			p_shader->type = SHADER_TYPE_MAX; //invalid
 		}
 
-		for (Material *E : shader->owners) {
+		for (Material *E : p_shader->owners) {
 			Material *material = E;
-			if (shader->data) {
-				material->data = material_get_data_request_function(new_type)(shader->data);
+			if (p_shader->data) {
+				material->data = material_get_data_request_function(new_type)(p_shader->data);
 				material->data->self = material->self;
 				material->data->set_next_pass(material->next_pass);
 				material->data->set_render_priority(material->priority);
@@ -2003,14 +2019,22 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			material->shader_type = new_type;
 		}
 
-		if (shader->data) {
-			for (const KeyValue<StringName, HashMap<int, RID>> &E : shader->default_texture_parameter) {
+		if (p_shader->data) {
+			for (const KeyValue<StringName, HashMap<int, RID>> &E : p_shader->default_texture_parameter) {
 				for (const KeyValue<int, RID> &E2 : E.value) {
-					shader->data->set_default_texture_parameter(E.key, E2.value, E2.key);
+					p_shader->data->set_default_texture_parameter(E.key, E2.value, E2.key);
 				}
 			}
 		}
 	}
+}
+
+void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL(shader);
+
+	shader->code = p_code;
+	_shader_set_type(shader, p_code);
 
 	if (shader->data) {
 		shader->data->set_path_hint(shader->path_hint);
@@ -2024,6 +2048,47 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	}
 }
 
+void MaterialStorage::_shader_batch_compile_task(uint32_t p_index, ShaderBatchItem *p_items) {
+	ShaderBatchItem &item = p_items[p_index];
+	item.data->compile_code(item.code);
+}
+
+void MaterialStorage::shader_set_code_batch(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+	ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+
+	// Give every shader the shader data of its new type, so the code can be compiled ahead. Only the first
+	// occurrence of a shader is compiled ahead, the others would overwrite its result.
+	LocalVector<ShaderBatchItem> items;
+	HashSet<Shader *> batched;
+	for (int i = 0; i < p_shaders.size(); i++) {
+		Shader *shader = shader_owner.get_or_null(p_shaders[i]);
+		if (!shader || batched.has(shader)) {
+			continue;
+		}
+		batched.insert(shader);
+
+		_shader_set_type(shader, p_codes[i]);
+		if (shader->data && !p_codes[i].is_empty()) {
+			shader->data->set_path_hint(shader->path_hint);
+			ShaderBatchItem item;
+			item.data = shader->data;
+			item.code = p_codes[i];
+			items.push_back(item);
+		}
+	}
+
+	// Parsing and code generation run in parallel, driver shaders and pipelines are created serially by shader_set_code(),
+	// which picks up the compiled code.
+	if (items.size() >= SHADER_BATCH_THREADED_MIN && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MaterialStorage::_shader_batch_compile_task, items.ptr(), items.size(), -1, true, SNAME("RDShaderBatchCompile"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+
+	for (int i = 0; i < p_shaders.size(); i++) {
+		shader_set_code(p_shaders[i], p_codes[i]);
+	}
+}
+
 void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
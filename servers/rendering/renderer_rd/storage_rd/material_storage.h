@@ -82,10 +82,25 @@ public:
 		virtual bool casts_shadows() const = 0;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
 
+		// Parses the code and generates the shader source, which is the part of set_code() that doesn't use the driver.
+		// It only writes to this shader data, so batches run it on worker threads before calling set_code() serially.
+		void compile_code(const String &p_code);
+
 		virtual ~ShaderData() {}
 
 		static RD::PipelineColorBlendState::Attachment blend_mode_to_blend_attachment(BlendMode p_mode);
 		static bool blend_mode_uses_blend_alpha(BlendMode p_mode);
+
+	protected:
+		virtual Error _compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) = 0;
+		// Returns the result of compile_code() for p_code, compiling it first unless a batch already did.
+		Error _take_compiled_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code);
+
+	private:
+		ShaderCompiler::GeneratedCode compiled_gen_code;
+		String compiled_code;
+		Error compile_error = OK;
+		bool code_compiled = false;
 	};
 
 	struct MaterialData {
@@ -229,6 +244,18 @@ private:
 	mutable RID_Owner<Shader, true> shader_owner;
 	Shader *get_shader(RID p_rid) { return shader_owner.get_or_null(p_rid); }
 
+	void _shader_set_type(Shader *p_shader, const String &p_code);
+
+	// Below this many shaders, a batch is compiled on the calling thread.
+	static constexpr uint32_t SHADER_BATCH_THREADED_MIN = 2;
+
+	struct ShaderBatchItem {
+		ShaderData *data = nullptr;
+		String code;
+	};
+
+	void _shader_batch_compile_task(uint32_t p_index, ShaderBatchItem *p_items);
+
 	/* MATERIAL API */
 
 	typedef MaterialData *(*MaterialDataRequestFunction)(ShaderData *);
@@ -411,6 +438,7 @@ public:
 	virtual void shader_free(RID p_rid) override;
 
 	virtual void shader_set_code(RID p_shader, const String &p_code) override;
+	virtual void shader_set_code_batch(const Vector<RID> &p_shaders, const Vector<String> &p_codes) override;
 	virtual void shader_set_path_hint(RID p_shader, const String &p_path) override;
 	virtual String shader_get_code(RID p_shader) const override;
 	virtual void get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const override;
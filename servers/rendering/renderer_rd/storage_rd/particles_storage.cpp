@@ -1677,10 +1677,7 @@ bool ParticlesStorage::particles_is_inactive(RID p_particles) const {
 
 /* Particles SHADER */
 
-void ParticlesStorage::ParticlesShaderData::set_code(const String &p_code) {
-	ParticlesStorage *particles_storage = ParticlesStorage::get_singleton();
-	//compile
-
+Error ParticlesStorage::ParticlesShaderData::_compile_code(const String &p_code, ShaderCompiler::GeneratedCode &r_gen_code) {
 	code = p_code;
 	valid = false;
 	ubo_size = 0;
@@ -1688,10 +1685,9 @@ void ParticlesStorage::ParticlesShaderData::set_code(const String &p_code) {
 	uses_collision = false;
 
 	if (code.is_empty()) {
-		return; //just invalid, but no error
+		return OK;
 	}
 
-	ShaderCompiler::GeneratedCode gen_code;
 	ShaderCompiler::IdentifierActions actions;
 	actions.entry_point_stages["start"] = ShaderCompiler::STAGE_COMPUTE;
 	actions.entry_point_stages["process"] = ShaderCompiler::STAGE_COMPUTE;
@@ -1715,9 +1711,21 @@ void ParticlesStorage::ParticlesShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
-	Error err = particles_storage->particles_shader.compiler.compile(RS::SHADER_PARTICLES, code, &actions, path, gen_code);
+	return ParticlesStorage::get_singleton()->particles_shader.compiler.compile(RS::SHADER_PARTICLES, code, &actions, path, r_gen_code);
+}
+
+void ParticlesStorage::ParticlesShaderData::set_code(const String &p_code) {
+	ShaderCompiler::GeneratedCode gen_code;
+	Error err = _take_compiled_code(p_code, gen_code);
+
+	if (code.is_empty()) {
+		return; //just invalid, but no error
+	}
+
 	ERR_FAIL_COND_MSG(err != OK, "Shader compilation failed.");
 
+	ParticlesStorage *particles_storage = ParticlesStorage::get_singleton();
+
 	if (version.is_null()) {
 		version = particles_storage->particles_shader.shader.version_create();
 	}
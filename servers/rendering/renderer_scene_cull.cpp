@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -40,6 +41,16 @@
 #include "scene/main/node.h"
 #endif
 
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SCENE_CULL_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SCENE_CULL_SIMD_NEON
+#endif
+#endif
+
 /* HALTON SEQUENCE */
 
 #ifndef _3D_DISABLED
@@ -1305,6 +1316,71 @@ Vector<ObjectID> RendererSceneCull::instances_cull_convex(const Vector<Plane> &p
 	return cull_convex.instances;
 }
 
+AABB RendererSceneCull::instance_get_deformed_aabb(RID p_instance) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_NULL_V(instance, AABB());
+	ERR_FAIL_COND_V(instance->base_type != RS::INSTANCE_MESH, AABB());
+
+	if (instance->update_item.in_list()) {
+		_update_dirty_instance(instance);
+	}
+
+	if (instance->mesh_instance.is_null()) {
+		return RSG::mesh_storage->mesh_get_aabb(instance->base); // Not deformed.
+	}
+	return RSG::mesh_storage->mesh_instance_get_deformed_aabb(instance->mesh_instance);
+}
+
+Vector<AABB> RendererSceneCull::instances_get_deformed_aabbs(const Vector<RID> &p_instances) {
+	Vector<AABB> aabbs;
+	aabbs.resize(p_instances.size());
+
+	// Deform all mesh instances at once, so the storage can process them in parallel.
+	Vector<RID> mesh_instances;
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(p_instances[i]);
+		ERR_CONTINUE(!instance || instance->base_type != RS::INSTANCE_MESH);
+		if (instance->update_item.in_list()) {
+			_update_dirty_instance(instance);
+		}
+		if (instance->mesh_instance.is_valid()) {
+			mesh_instances.push_back(instance->mesh_instance);
+		}
+	}
+	RSG::mesh_storage->mesh_instances_update_deformed(mesh_instances);
+
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(p_instances[i]);
+		if (!instance || instance->base_type != RS::INSTANCE_MESH) {
+			continue;
+		}
+		if (instance->mesh_instance.is_valid()) {
+			aabbs.write[i] = RSG::mesh_storage->mesh_instance_get_deformed_aabb(instance->mesh_instance);
+		} else {
+			aabbs.write[i] = RSG::mesh_storage->mesh_get_aabb(instance->base);
+		}
+	}
+	return aabbs;
+}
+
+Vector<Vector3> RendererSceneCull::instance_get_deformed_surface_vertices(RID p_instance, int p_surface) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_NULL_V(instance, Vector<Vector3>());
+	ERR_FAIL_COND_V(instance->base_type != RS::INSTANCE_MESH, Vector<Vector3>());
+
+	if (instance->update_item.in_list()) {
+		_update_dirty_instance(instance);
+	}
+
+	if (instance->mesh_instance.is_null()) {
+		// Not deformed, return the vertices as stored in the mesh.
+		ERR_FAIL_INDEX_V(p_surface, RSG::mesh_storage->mesh_get_surface_count(instance->base), Vector<Vector3>());
+		Array arrays = RS::get_singleton()->mesh_create_arrays_from_surface_data(RSG::mesh_storage->mesh_get_surface(instance->base, p_surface));
+		return arrays[RS::ARRAY_VERTEX];
+	}
+	return RSG::mesh_storage->mesh_instance_get_deformed_surface_vertices(instance->mesh_instance, p_surface);
+}
+
 void RendererSceneCull::instance_geometry_set_flag(RID p_instance, RS::InstanceFlags p_flags, bool p_enabled) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
@@ -1816,11 +1892,15 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 	}
 
 	if (!p_instance->indexer_id.is_valid()) {
+		// New instances start in the dynamic tree, update() migrates them once they stay still.
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].insert(bvh_aabb, p_instance);
+			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].dynamic_bvh.insert(bvh_aabb, p_instance);
 		} else {
-			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].insert(bvh_aabb, p_instance);
+			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].dynamic_bvh.insert(bvh_aabb, p_instance);
 		}
+		p_instance->indexer_static = false;
+		p_instance->indexer_moved_frame = indexer_frame;
+		p_instance->scenario->indexer_dynamic_instances.add(&p_instance->indexer_dynamic_item);
 
 		p_instance->array_index = p_instance->scenario->instance_data.size();
 		InstanceData idata;
@@ -1906,10 +1986,22 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+		SceneIndexer &indexer = p_instance->scenario->indexers[((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) ? Scenario::INDEXER_GEOMETRY : Scenario::INDEXER_VOLUMES];
+		bool moved = p_instance->transformed_aabb != p_instance->prev_transformed_aabb;
+		if (p_instance->indexer_static) {
+			if (moved) {
+				// Started moving, hand it back to the dynamic tree.
+				indexer.static_bvh.remove(p_instance->indexer_id);
+				p_instance->indexer_id = indexer.dynamic_bvh.insert(bvh_aabb, p_instance);
+				p_instance->indexer_static = false;
+				p_instance->indexer_moved_frame = indexer_frame;
+				p_instance->scenario->indexer_dynamic_instances.add(&p_instance->indexer_dynamic_item);
+			}
 		} else {
-			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
+			indexer.dynamic_bvh.update(p_instance->indexer_id, bvh_aabb);
+			if (moved) {
+				p_instance->indexer_moved_frame = indexer_frame;
+			}
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
 	}
@@ -1987,13 +2079,16 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		pair_allocator.free(pair);
 	}
 
-	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
+	SceneIndexer &indexer = p_instance->scenario->indexers[((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) ? Scenario::INDEXER_GEOMETRY : Scenario::INDEXER_VOLUMES];
+	if (p_instance->indexer_static) {
+		indexer.static_bvh.remove(p_instance->indexer_id);
 	} else {
-		p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].remove(p_instance->indexer_id);
+		indexer.dynamic_bvh.remove(p_instance->indexer_id);
+		p_instance->scenario->indexer_dynamic_instances.remove(&p_instance->indexer_dynamic_item);
 	}
 
 	p_instance->indexer_id = DynamicBVH::ID();
+	p_instance->indexer_static = false;
 
 	//replace this by last
 	int32_t swap_with_index = p_instance->scenario->instance_data.size() - 1;
@@ -2881,6 +2976,80 @@ void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_d
 	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
 }
 
+void RendererSceneCull::InstanceBoundsBlock::load(const PagedArray<InstanceBounds> &p_bounds, uint64_t p_from, uint32_t p_count) {
+	count = p_count;
+	for (uint32_t i = 0; i < p_count; i++) {
+		const real_t *src = p_bounds[p_from + i].bounds;
+		for (uint32_t j = 0; j < 6; j++) {
+			bounds[j][i] = src[j];
+		}
+	}
+	// Unused lanes get empty bounds at the origin; they are masked out of the result anyway.
+	for (uint32_t i = p_count; i < SIZE; i++) {
+		for (uint32_t j = 0; j < 6; j++) {
+			bounds[j][i] = 0;
+		}
+	}
+}
+
+uint32_t RendererSceneCull::InstanceBoundsBlock::in_frustum_mask(const Frustum &p_frustum) const {
+	// Same test as InstanceBounds::in_frustum(), only one plane at a time for all lanes.
+	uint32_t mask = (1u << count) - 1;
+
+#if defined(SCENE_CULL_SIMD_SSE2)
+	__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+
+		__m128 dist = _mm_mul_ps(_mm_set1_ps(plane.normal.x), _mm_load_ps(bounds[signs[0]]));
+		dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.y), _mm_load_ps(bounds[signs[1]])));
+		dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.normal.z), _mm_load_ps(bounds[signs[2]])));
+		dist = _mm_sub_ps(dist, _mm_set1_ps(plane.d));
+
+		inside = _mm_and_ps(inside, _mm_cmplt_ps(dist, _mm_setzero_ps()));
+		if (_mm_movemask_ps(inside) == 0) {
+			return 0;
+		}
+	}
+	return mask & uint32_t(_mm_movemask_ps(inside));
+#elif defined(SCENE_CULL_SIMD_NEON)
+	uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+
+		float32x4_t dist = vmulq_n_f32(vld1q_f32(bounds[signs[0]]), plane.normal.x);
+		dist = vaddq_f32(dist, vmulq_n_f32(vld1q_f32(bounds[signs[1]]), plane.normal.y));
+		dist = vaddq_f32(dist, vmulq_n_f32(vld1q_f32(bounds[signs[2]]), plane.normal.z));
+		dist = vsubq_f32(dist, vdupq_n_f32(plane.d));
+
+		inside = vandq_u32(inside, vcltq_f32(dist, vdupq_n_f32(0.0f)));
+		if (vmaxvq_u32(inside) == 0) {
+			return 0;
+		}
+	}
+	static const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+	return mask & vaddvq_u32(vandq_u32(inside, vld1q_u32(lane_bits)));
+#else
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+
+		for (uint32_t j = 0; j < count; j++) {
+			Vector3 min(bounds[signs[0]][j], bounds[signs[1]][j], bounds[signs[2]][j]);
+			if (plane.distance_to(min) >= 0.0) {
+				mask &= ~(1u << j);
+			}
+		}
+		if (mask == 0) {
+			break;
+		}
+	}
+	return mask;
+#endif
+}
+
 void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to) {
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	float lightmap_probe_update_speed = RSG::light_storage->lightmap_get_probe_capture_update_speed() * RSG::rasterizer->get_frame_delta_time();
@@ -2893,6 +3062,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Instances are processed in blocks: the frustum tests for the whole block run
+	// up front over transposed bounds, folded together with the layer and
+	// visibility dependency checks, and the loop below only reads the resulting bits.
+	InstanceBoundsBlock bounds_block;
+	uint32_t block_lane = 0;
+	uint32_t block_visible_mask = 0;
+	uint32_t block_cascade_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
@@ -2900,16 +3077,58 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 		int32_t visibility_check = -1;
 
-#define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
+#define HIDDEN_BY_VISIBILITY_CHECKS_FLAGS(m_flags) ((m_flags) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || (m_flags) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
+#define HIDDEN_BY_VISIBILITY_CHECKS HIDDEN_BY_VISIBILITY_CHECKS_FLAGS(visibility_flags)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_FRUSTUM_MASK(m_mask) ((m_mask) & (1u << block_lane))
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
+		if (i == p_from || block_lane == InstanceBoundsBlock::SIZE - 1) {
+			block_lane = 0;
+			uint32_t block_count = MIN(uint64_t(InstanceBoundsBlock::SIZE), p_to - i);
+
+			// Lanes hidden by a visibility dependency skip every frustum test,
+			// and lanes outside the visible layers skip the camera frustum test.
+			uint32_t candidate_mask = 0;
+			uint32_t layer_mask = 0;
+			for (uint32_t j = 0; j < block_count; j++) {
+				const InstanceData &block_idata = cull_data.scenario->instance_data[i + j];
+				uint32_t block_visibility_flags = block_idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
+				if (!HIDDEN_BY_VISIBILITY_CHECKS_FLAGS(block_visibility_flags)) {
+					candidate_mask |= 1u << j;
+					if (cull_data.visible_layers & block_idata.layer_mask) {
+						layer_mask |= 1u << j;
+					}
+				}
+			}
+
+			block_visible_mask = 0;
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					block_cascade_masks[j][k] = 0;
+				}
+			}
+
+			if (candidate_mask) {
+				bounds_block.load(cull_data.scenario->instance_aabbs, i, block_count);
+				if (layer_mask) {
+					block_visible_mask = bounds_block.in_frustum_mask(cull_data.cull->frustum) & layer_mask;
+				}
+				for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+					for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+						block_cascade_masks[j][k] = bounds_block.in_frustum_mask(cull_data.cull->shadows[j].cascades[k].frustum) & candidate_mask;
+					}
+				}
+			}
+		} else {
+			block_lane++;
+		}
+
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((IN_FRUSTUM_MASK(block_visible_mask) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3113,7 +3332,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 					continue;
 				}
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if (IN_FRUSTUM_MASK(block_cascade_masks[j][k]) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && (LAYER_CHECK & cull_data.cull->shadows[j].caster_mask)) {
@@ -3125,9 +3344,10 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 			}
 		}
 
+#undef HIDDEN_BY_VISIBILITY_CHECKS_FLAGS
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
-#undef IN_FRUSTUM
+#undef IN_FRUSTUM_MASK
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -4215,16 +4435,44 @@ void RendererSceneCull::update_dirty_instances() const {
 	RSG::utilities->update_dirty_resources();
 }
 
+void RendererSceneCull::_scenario_update_indexers(Scenario *p_scenario) {
+	// Migrate instances that stopped moving to the static trees.
+	SelfList<Instance> *E = p_scenario->indexer_dynamic_instances.first();
+	while (E) {
+		SelfList<Instance> *N = E->next();
+		Instance *instance = E->self();
+		if (indexer_frame - instance->indexer_moved_frame >= SceneIndexer::STATIC_AFTER_FRAMES) {
+			SceneIndexer &indexer = p_scenario->indexers[((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) ? Scenario::INDEXER_GEOMETRY : Scenario::INDEXER_VOLUMES];
+			indexer.dynamic_bvh.remove(instance->indexer_id);
+			instance->indexer_id = indexer.static_bvh.insert(instance->transformed_aabb, instance);
+			instance->indexer_static = true;
+			indexer.static_inserts_since_build++;
+			p_scenario->indexer_dynamic_instances.remove(E);
+		}
+		E = N;
+	}
+
+	for (uint32_t i = 0; i < Scenario::INDEXER_MAX; i++) {
+		SceneIndexer &indexer = p_scenario->indexers[i];
+		if (indexer.static_inserts_since_build > 0 && indexer.static_inserts_since_build * SceneIndexer::STATIC_REBUILD_DIVISOR >= uint32_t(indexer.static_bvh.get_leaf_count())) {
+			indexer.static_bvh.optimize_sah();
+			indexer.static_inserts_since_build = 0;
+		}
+		indexer.dynamic_bvh.optimize_incremental(indexer_update_iterations);
+	}
+}
+
 void RendererSceneCull::update() {
 	//optimize bvhs
 
+	indexer_frame++;
+
 	uint32_t rid_count = scenario_owner.get_rid_count();
 	RID *rids = (RID *)alloca(sizeof(RID) * rid_count);
 	scenario_owner.fill_owned_buffer(rids);
 	for (uint32_t i = 0; i < rid_count; i++) {
 		Scenario *s = scenario_owner.get_or_null(rids[i]);
-		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
-		s->indexers[Scenario::INDEXER_VOLUMES].optimize_incremental(indexer_update_iterations);
+		_scenario_update_indexers(s);
 	}
 	scene_render->update();
 	update_dirty_instances();
@@ -4453,7 +4701,7 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	default_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4479,8 +4727,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
@@ -130,7 +130,8 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	// Software rasterized occlusion culling, used unless a module (e.g. raycast) provides its own backend.
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -255,6 +256,21 @@ public:
 		}
 	};
 
+	struct InstanceBoundsBlock {
+		// Bounds of a few consecutive instances transposed into a
+		// structure of arrays, so each frustum plane is tested against
+		// all of them at once with SIMD.
+
+		static constexpr uint32_t SIZE = 4;
+
+		alignas(16) real_t bounds[6][SIZE];
+		uint32_t count = 0;
+
+		void load(const PagedArray<InstanceBounds> &p_bounds, uint64_t p_from, uint32_t p_count);
+		// Returns a bitmask with one bit set for each instance inside the frustum.
+		uint32_t in_frustum_mask(const Frustum &p_frustum) const;
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -328,6 +344,63 @@ public:
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
+	// Two level spatial index. Instances that have not moved for a while are
+	// migrated to a static tree which is rebuilt with SAH as it grows, movers
+	// stay in a small dynamic tree, and queries walk both.
+	struct SceneIndexer {
+		static constexpr uint32_t STATIC_AFTER_FRAMES = 30;
+		// Rebuild the static tree once this fraction of it was inserted incrementally.
+		static constexpr uint32_t STATIC_REBUILD_DIVISOR = 8;
+
+		DynamicBVH static_bvh;
+		DynamicBVH dynamic_bvh;
+		uint32_t static_inserts_since_build = 0;
+
+		template <typename QueryResult>
+		struct QueryStop {
+			QueryResult &result;
+			bool stopped = false;
+
+			_FORCE_INLINE_ bool operator()(void *p_data) {
+				stopped = result(p_data);
+				return stopped;
+			}
+
+			QueryStop(QueryResult &r_result) :
+					result(r_result) {}
+		};
+
+		template <typename QueryResult>
+		_FORCE_INLINE_ void aabb_query(const AABB &p_aabb, QueryResult &r_result) {
+			QueryStop<QueryResult> stop(r_result);
+			static_bvh.aabb_query(p_aabb, stop);
+			if (!stop.stopped) {
+				dynamic_bvh.aabb_query(p_aabb, r_result);
+			}
+		}
+		template <typename QueryResult>
+		_FORCE_INLINE_ void convex_query(const Plane *p_planes, int p_plane_count, const Vector3 *p_points, int p_point_count, QueryResult &r_result) {
+			QueryStop<QueryResult> stop(r_result);
+			static_bvh.convex_query(p_planes, p_plane_count, p_points, p_point_count, stop);
+			if (!stop.stopped) {
+				dynamic_bvh.convex_query(p_planes, p_plane_count, p_points, p_point_count, r_result);
+			}
+		}
+		template <typename QueryResult>
+		_FORCE_INLINE_ void ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) {
+			QueryStop<QueryResult> stop(r_result);
+			static_bvh.ray_query(p_from, p_to, stop);
+			if (!stop.stopped) {
+				dynamic_bvh.ray_query(p_from, p_to, r_result);
+			}
+		}
+
+		void set_index(uint32_t p_index) {
+			static_bvh.set_index(p_index);
+			dynamic_bvh.set_index(p_index);
+		}
+	};
+
 	struct Scenario {
 		enum IndexerType {
 			INDEXER_GEOMETRY, //for geometry
@@ -335,7 +408,7 @@ public:
 			INDEXER_MAX
 		};
 
-		DynamicBVH indexers[INDEXER_MAX];
+		SceneIndexer indexers[INDEXER_MAX];
 
 		RID self;
 
@@ -350,6 +423,7 @@ public:
 		HashMap<RID, uint64_t> viewport_visibility_masks;
 
 		SelfList<Instance>::List instances;
+		SelfList<Instance>::List indexer_dynamic_instances;
 
 		LocalVector<RID> dynamic_lights;
 
@@ -365,6 +439,7 @@ public:
 	};
 
 	int indexer_update_iterations = 0;
+	uint64_t indexer_frame = 0;
 
 	mutable RID_Owner<Scenario, true> scenario_owner;
 
@@ -468,6 +543,9 @@ public:
 		RID self;
 		//scenario stuff
 		DynamicBVH::ID indexer_id;
+		bool indexer_static = false;
+		uint64_t indexer_moved_frame = 0;
+		SelfList<Instance> indexer_dynamic_item;
 		int32_t array_index = -1;
 		int32_t visibility_index = -1;
 		float visibility_range_begin = 0.0f;
@@ -580,6 +658,7 @@ public:
 		}
 
 		Instance() :
+				indexer_dynamic_item(this),
 				scenario_item(this),
 				update_item(this) {
 			base_type = RS::INSTANCE_NONE;
@@ -842,8 +921,8 @@ public:
 		Instance *instance = nullptr;
 		PagedAllocator<InstancePair> *pair_allocator = nullptr;
 		SelfList<InstancePair>::List pairs_found;
-		DynamicBVH *bvh = nullptr;
-		DynamicBVH *bvh2 = nullptr; //some may need to cull in two
+		SceneIndexer *bvh = nullptr;
+		SceneIndexer *bvh2 = nullptr; //some may need to cull in two
 		uint32_t pair_mask;
 		uint64_t pair_pass;
 		uint32_t cull_mask = 0xFFFFFFFF; // Needed for decals and lights in the mobile and compatibility renderers.
@@ -1077,6 +1156,10 @@ public:
 	virtual Vector<ObjectID> instances_cull_ray(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const;
 	virtual Vector<ObjectID> instances_cull_convex(const Vector<Plane> &p_convex, RID p_scenario = RID()) const;
 
+	virtual AABB instance_get_deformed_aabb(RID p_instance);
+	virtual Vector<AABB> instances_get_deformed_aabbs(const Vector<RID> &p_instances);
+	virtual Vector<Vector3> instance_get_deformed_surface_vertices(RID p_instance, int p_surface);
+
 	virtual void instance_geometry_set_flag(RID p_instance, RS::InstanceFlags p_flags, bool p_enabled);
 	virtual void instance_geometry_set_cast_shadows_setting(RID p_instance, RS::ShadowCastingSetting p_shadow_casting_setting);
 	virtual void instance_geometry_set_material_override(RID p_instance, RID p_material);
@@ -1100,6 +1183,7 @@ public:
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance) const;
 	void _unpair_instance(Instance *p_instance);
+	void _scenario_update_indexers(Scenario *p_scenario);
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
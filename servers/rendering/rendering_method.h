@@ -105,6 +105,10 @@ public:
 	virtual Vector<ObjectID> instances_cull_ray(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const = 0;
 	virtual Vector<ObjectID> instances_cull_convex(const Vector<Plane> &p_convex, RID p_scenario = RID()) const = 0;
 
+	virtual AABB instance_get_deformed_aabb(RID p_instance) = 0;
+	virtual Vector<AABB> instances_get_deformed_aabbs(const Vector<RID> &p_instances) = 0;
+	virtual Vector<Vector3> instance_get_deformed_surface_vertices(RID p_instance, int p_surface) = 0;
+
 	virtual void instance_geometry_set_flag(RID p_instance, RS::InstanceFlags p_flags, bool p_enabled) = 0;
 	virtual void instance_geometry_set_cast_shadows_setting(RID p_instance, RS::ShadowCastingSetting p_shadow_casting_setting) = 0;
 	virtual void instance_geometry_set_material_override(RID p_instance, RID p_material) = 0;
@@ -247,6 +247,8 @@ void RenderingServerDefault::init() {
 		DisplayServer::get_singleton()->release_rendering_thread();
 		WorkerThreadPool::TaskID tid = WorkerThreadPool::get_singleton()->add_task(callable_mp(this, &RenderingServerDefault::_thread_loop), true);
 		command_queue.set_pump_task_id(tid);
+		// The main thread issues most calls, let those skip the lock.
+		command_queue.set_producer_thread(Thread::get_caller_id());
 		command_queue.push(this, &RenderingServerDefault::_assign_mt_ids, tid);
 		command_queue.push_and_sync(this, &RenderingServerDefault::_init);
 		DEV_ASSERT(server_task_id == tid);
@@ -289,6 +291,10 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::canvas_render->get_pipeline_compilations(PIPELINE_SOURCE_DRAW) + RSG::scene->get_pipeline_compilations(PIPELINE_SOURCE_DRAW);
 	} else if (p_info == RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION) {
 		return RSG::canvas_render->get_pipeline_compilations(PIPELINE_SOURCE_SPECIALIZATION) + RSG::scene->get_pipeline_compilations(PIPELINE_SOURCE_SPECIALIZATION);
+	} else if (p_info == RENDERING_INFO_CANVAS_YSORT_FULL_SORTS_IN_FRAME) {
+		return RSG::canvas->get_ysort_full_sorts_in_frame();
+	} else if (p_info == RENDERING_INFO_CANVAS_YSORT_INCREMENTAL_SORTS_IN_FRAME) {
+		return RSG::canvas->get_ysort_incremental_sorts_in_frame();
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -380,7 +386,7 @@ void RenderingServerDefault::_thread_loop() {
 	DisplayServer::get_singleton()->gl_window_make_current(DisplayServer::MAIN_WINDOW_ID); // Move GL to this thread.
 
 	while (!exit) {
-		WorkerThreadPool::get_singleton()->yield();
+		command_queue.wait_for_pending();
 		command_queue.flush_all();
 	}
 
@@ -265,6 +265,7 @@ public:
 	}
 
 	FUNC2(shader_set_code, RID, const String &)
+	FUNC2(shader_set_code_batch, const Vector<RID> &, const Vector<String> &)
 	FUNC2(shader_set_path_hint, RID, const String &)
 	FUNC1RC(String, shader_get_code, RID)
 
@@ -881,6 +882,7 @@ public:
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
 	FUNC3(instance_set_pivot_data, RID, float, bool)
 	FUNC2(instance_set_transform, RID, const Transform3D &)
+	FUNC2BATCH(instances_set_transforms, instance_set_transform, RID, Transform3D)
 	FUNC2(instance_set_interpolated, RID, bool)
 	FUNC1(instance_reset_physics_interpolation, RID)
 	FUNC2(instance_attach_object_instance_id, RID, ObjectID)
@@ -902,6 +904,10 @@ public:
 	FUNC3RC(Vector<ObjectID>, instances_cull_ray, const Vector3 &, const Vector3 &, RID)
 	FUNC2RC(Vector<ObjectID>, instances_cull_convex, const Vector<Plane> &, RID)
 
+	FUNC1R(AABB, instance_get_deformed_aabb, RID)
+	FUNC1R(Vector<AABB>, instances_get_deformed_aabbs, const Vector<RID> &)
+	FUNC2R(PackedVector3Array, instance_get_deformed_surface_vertices, RID, int)
+
 	FUNC3(instance_geometry_set_flag, RID, InstanceFlags, bool)
 	FUNC2(instance_geometry_set_cast_shadows_setting, RID, ShadowCastingSetting)
 	FUNC2(instance_geometry_set_material_override, RID, RID)
@@ -956,6 +962,7 @@ public:
 	FUNC2(canvas_item_set_update_when_visible, RID, bool)
 
 	FUNC2(canvas_item_set_transform, RID, const Transform2D &)
+	FUNC2BATCH(canvas_items_set_transforms, canvas_item_set_transform, RID, Transform2D)
 	FUNC2(canvas_item_set_clip, RID, bool)
 	FUNC2(canvas_item_set_distance_field_mode, RID, bool)
 	FUNC3(canvas_item_set_custom_rect, RID, bool, const Rect2 &)
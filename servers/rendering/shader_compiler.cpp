@@ -30,6 +30,12 @@
 
 #include "shader_compiler.h"
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -274,14 +280,14 @@ static String get_constant_text(SL::DataType p_type, const Vector<SL::Scalar> &p
 	}
 }
 
-String ShaderCompiler::_get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat) {
+String ShaderCompiler::Generator::_get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat) {
 	if (p_filter == ShaderLanguage::FILTER_DEFAULT) {
-		ERR_FAIL_COND_V(actions.default_filter == ShaderLanguage::FILTER_DEFAULT, String());
-		p_filter = actions.default_filter;
+		ERR_FAIL_COND_V(compiler.actions.default_filter == ShaderLanguage::FILTER_DEFAULT, String());
+		p_filter = compiler.actions.default_filter;
 	}
 	if (p_repeat == ShaderLanguage::REPEAT_DEFAULT) {
-		ERR_FAIL_COND_V(actions.default_repeat == ShaderLanguage::REPEAT_DEFAULT, String());
-		p_repeat = actions.default_repeat;
+		ERR_FAIL_COND_V(compiler.actions.default_repeat == ShaderLanguage::REPEAT_DEFAULT, String());
+		p_repeat = compiler.actions.default_repeat;
 	}
 	constexpr const char *name_mapping[] = {
 		"SAMPLER_NEAREST_CLAMP",
@@ -300,7 +306,7 @@ String ShaderCompiler::_get_sampler_name(ShaderLanguage::TextureFilter p_filter,
 	return String(name_mapping[p_filter + (p_repeat == ShaderLanguage::REPEAT_ENABLE ? ShaderLanguage::FILTER_DEFAULT : 0)]);
 }
 
-void ShaderCompiler::_dump_function_deps(const SL::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added) {
+void ShaderCompiler::Generator::_dump_function_deps(const SL::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added) {
 	int fidx = -1;
 
 	for (int i = 0; i < p_node->vfunctions.size(); i++) {
@@ -446,7 +452,7 @@ static String _get_global_shader_uniform_from_type_and_index(const String &p_buf
 	}
 }
 
-String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
+String ShaderCompiler::Generator::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
 	String code;
 
 	switch (p_node->type) {
@@ -562,7 +568,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				if (SL::is_sampler_type(uniform.type)) {
 					// Texture layouts are different for OpenGL GLSL and Vulkan GLSL
 					if (!RS::get_singleton()->is_low_end()) {
-						ucode = "layout(set = " + itos(actions.texture_layout_set) + ", binding = " + itos(actions.base_texture_binding_index + uniform.texture_binding) + ") ";
+						ucode = "layout(set = " + itos(compiler.actions.texture_layout_set) + ", binding = " + itos(compiler.actions.base_texture_binding_index + uniform.texture_binding) + ") ";
 					}
 					ucode += "uniform ";
 				}
@@ -928,7 +934,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					} else {
 						//a scalar or vector
 						if (u.scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_GLOBAL) {
-							code = actions.base_uniform_string + _mkid(vnode->name); //texture, use as is
+							code = compiler.actions.base_uniform_string + _mkid(vnode->name); //texture, use as is
 							//global variable, this means the code points to an index to the global table
 							code = _get_global_shader_uniform_from_type_and_index(p_default_actions.global_buffer_array_variable, code, u.type);
 						} else if (u.scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_INSTANCE) {
@@ -937,7 +943,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							code = _get_global_shader_uniform_from_type_and_index(p_default_actions.global_buffer_array_variable, code, u.type);
 						} else {
 							//regular uniform, index from UBO
-							code = actions.base_uniform_string + _mkid(vnode->name);
+							code = compiler.actions.base_uniform_string + _mkid(vnode->name);
 						}
 					}
 
@@ -949,7 +955,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				}
 			}
 
-			if (vnode->name == time_name) {
+			if (vnode->name == compiler.time_name) {
 				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX) {
 					r_gen_code.uses_vertex_time = true;
 				}
@@ -1028,7 +1034,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					} else {
 						//a scalar or vector
 						if (u.scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_GLOBAL) {
-							code = actions.base_uniform_string + _mkid(anode->name); //texture, use as is
+							code = compiler.actions.base_uniform_string + _mkid(anode->name); //texture, use as is
 							//global variable, this means the code points to an index to the global table
 							code = _get_global_shader_uniform_from_type_and_index(p_default_actions.global_buffer_array_variable, code, u.type);
 						} else if (u.scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_INSTANCE) {
@@ -1037,7 +1043,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 							code = _get_global_shader_uniform_from_type_and_index(p_default_actions.global_buffer_array_variable, code, u.type);
 						} else {
 							//regular uniform, index from UBO
-							code = actions.base_uniform_string + _mkid(anode->name);
+							code = compiler.actions.base_uniform_string + _mkid(anode->name);
 						}
 					}
 				} else {
@@ -1060,7 +1066,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 				code += _dump_node_code(anode->assign_expression, p_level, r_gen_code, p_actions, p_default_actions, true, false);
 			}
 
-			if (anode->name == time_name) {
+			if (anode->name == compiler.time_name) {
 				if (p_actions.entry_point_stages.has(current_func_name) && p_actions.entry_point_stages[current_func_name] == STAGE_VERTEX) {
 					r_gen_code.uses_vertex_time = true;
 				}
@@ -1138,7 +1144,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					ERR_FAIL_COND_V(onode->arguments[0]->type != SL::Node::NODE_TYPE_VARIABLE, String());
 					const SL::VariableNode *vnode = static_cast<const SL::VariableNode *>(onode->arguments[0]);
 					const SL::FunctionNode *func = nullptr;
-					const bool is_internal_func = internal_functions.has(vnode->name);
+					const bool is_internal_func = compiler.internal_functions.has(vnode->name);
 
 					if (!is_internal_func) {
 						for (int i = 0; i < shader->vfunctions.size(); i++) {
@@ -1166,7 +1172,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 						if (is_internal_func) {
 							code += vnode->name;
-							is_texture_func = texture_functions.has(vnode->name);
+							is_texture_func = compiler.texture_functions.has(vnode->name);
 							texture_func_no_uv = (vnode->name == "textureSize" || vnode->name == "textureQueryLevels");
 							texture_func_returns_data = texture_func_no_uv || vnode->name == "textureQueryLod";
 						} else if (p_default_actions.renames.has(vnode->name)) {
@@ -1252,8 +1258,8 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 								String sampler_name;
 								bool is_depth_texture = false;
 
-								if (actions.custom_samplers.has(texture_uniform)) {
-									sampler_name = actions.custom_samplers[texture_uniform];
+								if (compiler.actions.custom_samplers.has(texture_uniform)) {
+									sampler_name = compiler.actions.custom_samplers[texture_uniform];
 								} else {
 									if (shader->uniforms.has(texture_uniform)) {
 										const ShaderLanguage::ShaderNode::Uniform &u = shader->uniforms[texture_uniform];
@@ -1271,8 +1277,8 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 										for (int j = 0; j < function->arguments.size(); j++) {
 											if (function->arguments[j].name == texture_uniform) {
 												if (function->arguments[j].tex_builtin_check) {
-													ERR_CONTINUE(!actions.custom_samplers.has(function->arguments[j].tex_builtin));
-													sampler_name = actions.custom_samplers[function->arguments[j].tex_builtin];
+													ERR_CONTINUE(!compiler.actions.custom_samplers.has(function->arguments[j].tex_builtin));
+													sampler_name = compiler.actions.custom_samplers[function->arguments[j].tex_builtin];
 													found = true;
 													break;
 												}
@@ -1298,7 +1304,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 								}
 
 								String data_type_name = "";
-								if (actions.check_multiview_samplers && (is_screen_texture || is_depth_texture || is_normal_roughness_texture)) {
+								if (compiler.actions.check_multiview_samplers && (is_screen_texture || is_depth_texture || is_normal_roughness_texture)) {
 									data_type_name = "multiviewSampler";
 									multiview_uv_needed = true;
 								} else {
@@ -1306,7 +1312,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 								}
 
 								code += data_type_name + "(" + node_code + ", " + sampler_name + ")";
-							} else if (actions.check_multiview_samplers && correct_texture_uniform && RS::get_singleton()->is_low_end()) {
+							} else if (compiler.actions.check_multiview_samplers && correct_texture_uniform && RS::get_singleton()->is_low_end()) {
 								// Texture function on low end hardware (i.e. OpenGL).
 								// We just need to know if the texture supports multiview.
 
@@ -1335,7 +1341,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 						}
 					}
 					code += ")";
-					if (is_screen_texture && !texture_func_returns_data && actions.apply_luminance_multiplier) {
+					if (is_screen_texture && !texture_func_returns_data && compiler.actions.apply_luminance_multiplier) {
 						code = "(" + code + " * vec4(vec3(sc_luminance_multiplier()), 1.0))";
 					}
 					if (is_normal_roughness_texture && !texture_func_returns_data) {
@@ -1459,7 +1465,355 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+static const char *compiler_cache_file_header = "GDSL";
+static const uint32_t compiler_cache_file_version = 1;
+
+String ShaderCompiler::shader_cache_dir;
+
+static void _append_action_names(StringBuilder &r_builder, const char *p_section, const HashMap<StringName, bool *> &p_flags) {
+	r_builder.append(p_section);
+	for (const KeyValue<StringName, bool *> &E : p_flags) {
+		r_builder.append(String(E.key));
+		r_builder.append(",");
+	}
+}
+
+String ShaderCompiler::_get_cache_file_path(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions) const {
+	StringBuilder tohash;
+	tohash.append("[GodotVersionNumber]");
+	tohash.append(VERSION_NUMBER);
+	tohash.append("[GodotVersionHash]");
+	tohash.append(VERSION_HASH);
+	tohash.append("[RenderingMethod]");
+	tohash.append(OS::get_singleton()->get_current_rendering_method());
+	tohash.append(RS::get_singleton()->is_low_end() ? "[LowEnd]" : "[HighEnd]");
+	tohash.append("[DefaultActions]");
+	tohash.append(actions_sha256);
+	tohash.append("[Mode]");
+	tohash.append(itos(p_mode));
+	tohash.append("[RenderModeValues]");
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions.render_mode_values) {
+		tohash.append(String(E.key) + "=" + itos(E.value.second) + ",");
+	}
+	_append_action_names(tohash, "[RenderModeFlags]", p_actions.render_mode_flags);
+	_append_action_names(tohash, "[UsageFlags]", p_actions.usage_flag_pointers);
+	_append_action_names(tohash, "[WriteFlags]", p_actions.write_flag_pointers);
+	tohash.append("[EntryPoints]");
+	for (const KeyValue<StringName, Stage> &E : p_actions.entry_point_stages) {
+		tohash.append(String(E.key) + "=" + itos(E.value) + ",");
+	}
+	tohash.append("[Code]");
+	tohash.append(p_code);
+
+	return shader_cache_dir.path_join(tohash.as_string().sha256_text()) + ".cache";
+}
+
+static void _store_string_names(Ref<FileAccess> p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &name : p_names) {
+		p_file->store_pascal_string(name);
+	}
+}
+
+static bool _get_string_names(Ref<FileAccess> p_file, Vector<StringName> &r_names) {
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count; i++) {
+		if (p_file->eof_reached()) {
+			return false;
+		}
+		r_names.push_back(p_file->get_pascal_string());
+	}
+	return !p_file->eof_reached();
+}
+
+bool ShaderCompiler::_read_cache_file(Ref<FileAccess> p_file, CacheRecord &r_record, GeneratedCode &r_gen_code) {
+	char header[5] = { 0, 0, 0, 0, 0 };
+	p_file->get_buffer((uint8_t *)header, 4);
+	if (header != String(compiler_cache_file_header) || p_file->get_32() != compiler_cache_file_version) {
+		return false;
+	}
+
+	bool valid = _get_string_names(p_file, r_record.render_modes) && _get_string_names(p_file, r_record.render_mode_flags) && _get_string_names(p_file, r_record.usage_flags) && _get_string_names(p_file, r_record.write_flags);
+	if (!valid) {
+		return false;
+	}
+
+	uint32_t uniform_count = p_file->get_32();
+	for (uint32_t i = 0; i < uniform_count; i++) {
+		StringName name = p_file->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		uniform.order = (int32_t)p_file->get_32();
+		uniform.prop_order = (int32_t)p_file->get_32();
+		uniform.texture_order = (int32_t)p_file->get_32();
+		uniform.texture_binding = (int32_t)p_file->get_32();
+		uniform.type = SL::DataType(p_file->get_32());
+		uniform.precision = SL::DataPrecision(p_file->get_32());
+		uniform.array_size = (int32_t)p_file->get_32();
+		uint32_t default_count = p_file->get_32();
+		if (p_file->eof_reached()) {
+			return false;
+		}
+		uniform.default_value.resize(default_count);
+		for (uint32_t j = 0; j < default_count; j++) {
+			uniform.default_value.write[j].uint = p_file->get_32();
+		}
+		uniform.scope = SL::ShaderNode::Uniform::Scope(p_file->get_32());
+		uniform.hint = SL::ShaderNode::Uniform::Hint(p_file->get_32());
+		uniform.use_color = p_file->get_8();
+		uniform.filter = SL::TextureFilter(p_file->get_32());
+		uniform.repeat = SL::TextureRepeat(p_file->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = p_file->get_float();
+		}
+		uint32_t enum_count = p_file->get_32();
+		if (p_file->eof_reached()) {
+			return false;
+		}
+		for (uint32_t j = 0; j < enum_count; j++) {
+			uniform.hint_enum_names.push_back(p_file->get_pascal_string());
+		}
+		uniform.instance_index = (int32_t)p_file->get_32();
+		uniform.group = p_file->get_pascal_string();
+		uniform.subgroup = p_file->get_pascal_string();
+		if (p_file->eof_reached()) {
+			return false;
+		}
+		r_record.uniforms.insert(name, uniform);
+	}
+
+	uint32_t define_count = p_file->get_32();
+	for (uint32_t i = 0; i < define_count; i++) {
+		r_gen_code.defines.push_back(p_file->get_pascal_string());
+	}
+
+	uint32_t texture_count = p_file->get_32();
+	if (p_file->eof_reached()) {
+		return false;
+	}
+	r_gen_code.texture_uniforms.resize(texture_count);
+	for (uint32_t i = 0; i < texture_count; i++) {
+		GeneratedCode::Texture &texture = r_gen_code.texture_uniforms.write[i];
+		texture.name = p_file->get_pascal_string();
+		texture.type = SL::DataType(p_file->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(p_file->get_32());
+		texture.use_color = p_file->get_8();
+		texture.filter = SL::TextureFilter(p_file->get_32());
+		texture.repeat = SL::TextureRepeat(p_file->get_32());
+		texture.global = p_file->get_8();
+		texture.array_size = (int32_t)p_file->get_32();
+	}
+
+	uint32_t offset_count = p_file->get_32();
+	if (p_file->eof_reached()) {
+		return false;
+	}
+	r_gen_code.uniform_offsets.resize(offset_count);
+	for (uint32_t i = 0; i < offset_count; i++) {
+		r_gen_code.uniform_offsets.write[i] = p_file->get_32();
+	}
+	r_gen_code.uniform_total_size = p_file->get_32();
+	r_gen_code.uniforms = p_file->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		r_gen_code.stage_globals[i] = p_file->get_pascal_string();
+	}
+
+	uint32_t code_count = p_file->get_32();
+	for (uint32_t i = 0; i < code_count; i++) {
+		String key = p_file->get_pascal_string();
+		r_gen_code.code[key] = p_file->get_pascal_string();
+	}
+
+	uint8_t uses = p_file->get_8();
+	r_gen_code.uses_global_textures = uses & (1 << 0);
+	r_gen_code.uses_fragment_time = uses & (1 << 1);
+	r_gen_code.uses_vertex_time = uses & (1 << 2);
+	r_gen_code.uses_screen_texture_mipmaps = uses & (1 << 3);
+	r_gen_code.uses_screen_texture = uses & (1 << 4);
+	r_gen_code.uses_depth_texture = uses & (1 << 5);
+	r_gen_code.uses_normal_roughness_texture = uses & (1 << 6);
+
+	// The file ends with its own length, to detect truncated or partially written files.
+	uint64_t expected_length = p_file->get_position();
+	return p_file->get_64() == expected_length && !p_file->eof_reached();
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_path, IdentifierActions *p_actions, GeneratedCode &r_gen_code) const {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	// Read everything before touching the outputs, so a bad file leaves them untouched.
+	CacheRecord record;
+	GeneratedCode gen_code;
+	bool valid = _read_cache_file(f, record, gen_code);
+	f.unref();
+
+	if (!valid) {
+		// Truncated, corrupt or written by another version. Not an error, the shader is
+		// compiled again and the entry rewritten.
+		DirAccess::remove_absolute(p_path);
+		return false;
+	}
+
+	for (const StringName &E : record.render_modes) {
+		if (p_actions->render_mode_values.has(E)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[E];
+			*p.first = p.second;
+		}
+	}
+	for (const StringName &E : record.render_mode_flags) {
+		if (p_actions->render_mode_flags.has(E)) {
+			*p_actions->render_mode_flags[E] = true;
+		}
+	}
+	for (const StringName &E : record.usage_flags) {
+		if (p_actions->usage_flag_pointers.has(E)) {
+			*p_actions->usage_flag_pointers[E] = true;
+		}
+	}
+	for (const StringName &E : record.write_flags) {
+		if (p_actions->write_flag_pointers.has(E)) {
+			*p_actions->write_flag_pointers[E] = true;
+		}
+	}
+	if (p_actions->uniforms) {
+		for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : record.uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+	}
+
+	r_gen_code = gen_code;
+	cache_hits.increment();
+	return true;
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_path, const CacheRecord &p_record, const GeneratedCode &p_gen_code) const {
+	// Write to a file unique to this process and thread, then move it into place, so
+	// concurrent compilations never read or write a partially written entry.
+	const String temp_path = p_path + "." + itos(OS::get_singleton()->get_process_id()) + "_" + itos(Thread::get_caller_id()) + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+	f->store_buffer((const uint8_t *)compiler_cache_file_header, 4);
+	f->store_32(compiler_cache_file_version);
+
+	_store_string_names(f, p_record.render_modes);
+	_store_string_names(f, p_record.render_mode_flags);
+	_store_string_names(f, p_record.usage_flags);
+	_store_string_names(f, p_record.write_flags);
+
+	f->store_32(p_record.uniforms.size());
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_record.uniforms) {
+		const SL::ShaderNode::Uniform &uniform = E.value;
+		f->store_pascal_string(E.key);
+		f->store_32(uniform.order);
+		f->store_32(uniform.prop_order);
+		f->store_32(uniform.texture_order);
+		f->store_32(uniform.texture_binding);
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uniform.array_size);
+		f->store_32(uniform.default_value.size());
+		for (const SL::Scalar &value : uniform.default_value) {
+			f->store_32(value.uint);
+		}
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_8(uniform.use_color);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int j = 0; j < 3; j++) {
+			f->store_float(uniform.hint_range[j]);
+		}
+		f->store_32(uniform.hint_enum_names.size());
+		for (const String &name : uniform.hint_enum_names) {
+			f->store_pascal_string(name);
+		}
+		f->store_32(uniform.instance_index);
+		f->store_pascal_string(uniform.group);
+		f->store_pascal_string(uniform.subgroup);
+	}
+
+	f->store_32(p_gen_code.defines.size());
+	for (const String &define : p_gen_code.defines) {
+		f->store_pascal_string(define);
+	}
+
+	f->store_32(p_gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : p_gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+
+	f->store_32(p_gen_code.uniform_offsets.size());
+	for (uint32_t offset : p_gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(p_gen_code.uniform_total_size);
+	f->store_pascal_string(p_gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(p_gen_code.stage_globals[i]);
+	}
+
+	f->store_32(p_gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	uint8_t uses = 0;
+	uses |= p_gen_code.uses_global_textures ? (1 << 0) : 0;
+	uses |= p_gen_code.uses_fragment_time ? (1 << 1) : 0;
+	uses |= p_gen_code.uses_vertex_time ? (1 << 2) : 0;
+	uses |= p_gen_code.uses_screen_texture_mipmaps ? (1 << 3) : 0;
+	uses |= p_gen_code.uses_screen_texture ? (1 << 4) : 0;
+	uses |= p_gen_code.uses_depth_texture ? (1 << 5) : 0;
+	uses |= p_gen_code.uses_normal_roughness_texture ? (1 << 6) : 0;
+	f->store_8(uses);
+
+	f->store_64(f->get_position());
+
+	bool written = f->get_error() == OK;
+	f.unref();
+	if (!written || DirAccess::rename_absolute(temp_path, p_path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+static void _redirect_flags(HashMap<StringName, bool *> &r_flags, LocalVector<bool> &r_storage) {
+	r_storage.resize(r_flags.size());
+	uint32_t index = 0;
+	for (KeyValue<StringName, bool *> &E : r_flags) {
+		r_storage[index] = false;
+		E.value = &r_storage[index];
+		index++;
+	}
+}
+
+static void _collect_flags(const HashMap<StringName, bool *> &p_recorded, HashMap<StringName, bool *> &r_flags, Vector<StringName> &r_names) {
+	for (const KeyValue<StringName, bool *> &E : p_recorded) {
+		if (*E.value) {
+			*r_flags[E.key] = true;
+			r_names.push_back(E.key);
+		}
+	}
+}
+
+Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) const {
+	String cache_path;
+	if (!shader_cache_dir.is_empty()) {
+		cache_path = _get_cache_file_path(p_mode, p_code, *p_actions);
+		if (_load_from_cache(cache_path, p_actions, r_gen_code)) {
+			return OK;
+		}
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1467,6 +1821,7 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
 	info.base_varying_index = actions.base_varying_index;
 
+	ShaderLanguage parser;
 	Error err = parser.compile(p_code, info);
 
 	if (err != OK) {
@@ -1556,14 +1911,49 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	r_gen_code.uses_depth_texture = false;
 	r_gen_code.uses_normal_roughness_texture = false;
 
-	used_name_defines.clear();
-	used_rmode_defines.clear();
-	used_flag_pointers.clear();
-	fragment_varyings.clear();
+	Generator generator(*this);
+	generator.shader = parser.get_shader();
 
-	shader = parser.get_shader();
-	function = nullptr;
-	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	if (cache_path.is_empty()) {
+		generator._dump_node_code(generator.shader, 1, r_gen_code, *p_actions, actions, false);
+		return OK;
+	}
+
+	// Generate through a copy of the actions whose flags point to local storage, so the
+	// side effects can be stored along with the code and replayed on a cache hit.
+	CacheRecord record;
+	IdentifierActions recording = *p_actions;
+	LocalVector<bool> render_mode_flags;
+	LocalVector<bool> usage_flags;
+	LocalVector<bool> write_flags;
+	_redirect_flags(recording.render_mode_flags, render_mode_flags);
+	_redirect_flags(recording.usage_flag_pointers, usage_flags);
+	_redirect_flags(recording.write_flag_pointers, write_flags);
+	recording.uniforms = p_actions->uniforms ? &record.uniforms : nullptr;
+
+	generator._dump_node_code(generator.shader, 1, r_gen_code, recording, actions, false);
+
+	for (const StringName &E : generator.shader->render_modes) {
+		if (p_actions->render_mode_values.has(E)) {
+			record.render_modes.push_back(E);
+		}
+	}
+	_collect_flags(recording.render_mode_flags, p_actions->render_mode_flags, record.render_mode_flags);
+	_collect_flags(recording.usage_flag_pointers, p_actions->usage_flag_pointers, record.usage_flags);
+	_collect_flags(recording.write_flag_pointers, p_actions->write_flag_pointers, record.write_flags);
+
+	// Global uniform types come from the project settings, which aren't part of the key.
+	bool uses_global_uniforms = false;
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : record.uniforms) {
+		if (p_actions->uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+		uses_global_uniforms = uses_global_uniforms || E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL;
+	}
+
+	if (!uses_global_uniforms) {
+		_save_to_cache(cache_path, record, r_gen_code);
+	}
 
 	return OK;
 }
@@ -1571,6 +1961,24 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	StringBuilder tohash;
+	const HashMap<StringName, String> *maps[4] = { &actions.renames, &actions.render_mode_defines, &actions.usage_defines, &actions.custom_samplers };
+	for (int i = 0; i < 4; i++) {
+		tohash.append("[Map" + itos(i) + "]");
+		for (const KeyValue<StringName, String> &E : *maps[i]) {
+			tohash.append(String(E.key) + "=" + E.value + "\n");
+		}
+	}
+	tohash.append("[Settings]");
+	tohash.append(itos(actions.default_filter) + "," + itos(actions.default_repeat) + "," + itos(actions.base_texture_binding_index) + "," + itos(actions.texture_layout_set) + "," + itos(actions.base_varying_index) + "," + itos(actions.apply_luminance_multiplier) + "," + itos(actions.check_multiview_samplers));
+	tohash.append("[BaseUniformString]");
+	tohash.append(actions.base_uniform_string);
+	tohash.append("[GlobalBufferArrayVariable]");
+	tohash.append(actions.global_buffer_array_variable);
+	tohash.append("[InstanceUniformIndexVariable]");
+	tohash.append(actions.instance_uniform_index_variable);
+	actions_sha256 = tohash.as_string().sha256_text();
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -1593,5 +2001,16 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	texture_functions.insert("texelFetch");
 }
 
+void ShaderCompiler::set_shader_cache_dir(const String &p_dir) {
+	shader_cache_dir = String();
+	if (p_dir.is_empty()) {
+		return;
+	}
+
+	Error err = DirAccess::make_dir_recursive_absolute(p_dir);
+	ERR_FAIL_COND_MSG(err != OK, "Can't create shader compiler cache folder, no shader code caching will happen: " + p_dir);
+	shader_cache_dir = p_dir;
+}
+
 ShaderCompiler::ShaderCompiler() {
 }
@@ -104,33 +104,64 @@ public:
 	};
 
 private:
-	ShaderLanguage parser;
+	// Holds the state of a single compilation, so several shaders can be
+	// compiled with the same ShaderCompiler from different threads at once.
+	struct Generator {
+		const ShaderCompiler &compiler;
 
-	String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
+		const ShaderLanguage::ShaderNode *shader = nullptr;
+		const ShaderLanguage::FunctionNode *function = nullptr;
+		StringName current_func_name;
 
-	void _dump_function_deps(const ShaderLanguage::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added);
-	String _dump_node_code(const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
+		HashSet<StringName> used_name_defines;
+		HashSet<StringName> used_flag_pointers;
+		HashSet<StringName> used_rmode_defines;
+		HashSet<StringName> fragment_varyings;
+
+		String _get_sampler_name(ShaderLanguage::TextureFilter p_filter, ShaderLanguage::TextureRepeat p_repeat);
+
+		void _dump_function_deps(const ShaderLanguage::ShaderNode *p_node, const StringName &p_for_func, const HashMap<StringName, String> &p_func_code, String &r_to_add, HashSet<StringName> &added);
+		String _dump_node_code(const ShaderLanguage::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_scope = true);
+
+		Generator(const ShaderCompiler &p_compiler) :
+				compiler(p_compiler) {}
+	};
 
-	const ShaderLanguage::ShaderNode *shader = nullptr;
-	const ShaderLanguage::FunctionNode *function = nullptr;
-	StringName current_func_name;
 	StringName time_name;
 	HashSet<StringName> texture_functions;
-
-	HashSet<StringName> used_name_defines;
-	HashSet<StringName> used_flag_pointers;
-	HashSet<StringName> used_rmode_defines;
 	HashSet<StringName> internal_functions;
-	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	// Side effects of a compilation on IdentifierActions, replayed when the result is loaded from the cache.
+	struct CacheRecord {
+		Vector<StringName> render_modes;
+		Vector<StringName> render_mode_flags;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	static String shader_cache_dir;
+	String actions_sha256;
+	mutable SafeNumeric<uint32_t> cache_hits;
+
+	String _get_cache_file_path(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions) const;
+	static bool _read_cache_file(Ref<FileAccess> p_file, CacheRecord &r_record, GeneratedCode &r_gen_code);
+	bool _load_from_cache(const String &p_path, IdentifierActions *p_actions, GeneratedCode &r_gen_code) const;
+	void _save_to_cache(const String &p_path, const CacheRecord &p_record, const GeneratedCode &p_gen_code) const;
+
 public:
-	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	// Thread-safe once initialized, as long as global shader parameters aren't modified meanwhile.
+	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) const;
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	// Caches the generated code on disk, keyed by the shader source and compiler configuration.
+	static void set_shader_cache_dir(const String &p_dir);
+	uint32_t get_cache_hit_count() const { return cache_hits.get(); }
 	ShaderCompiler();
 };
 
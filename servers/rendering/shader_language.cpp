@@ -39,7 +39,6 @@
 
 #define HAS_WARNING(flag) (warning_flags & flag)
 
-SafeNumeric<int> ShaderLanguage::instance_counter;
 
 String ShaderLanguage::get_operator_text(Operator p_op) {
 	static const char *op_names[OP_MAX] = { "==",
@@ -724,21 +723,23 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 						CASE_MAX,
 					} lut_case = CASE_ALL;
 
-					static bool suffix_lut[CASE_MAX][127];
+					// Function local static, so it is initialized only once even when parsing from several threads.
+					static const struct SuffixLUT {
+						bool lut[CASE_MAX][127];
 
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
+						SuffixLUT() {
+							for (int i = 0; i < 127; i++) {
+								char t = char(i);
 
-						for (int i = 0; i < 127; i++) {
-							char t = char(i);
-
-							suffix_lut[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
-							suffix_lut[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
-							suffix_lut[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
-							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
-							suffix_lut[CASE_NONE][i] = false;
+								lut[CASE_ALL][i] = t == '.' || t == 'x' || t == 'e' || t == 'f' || t == 'u' || t == '-' || t == '+';
+								lut[CASE_HEXA_PERIOD][i] = t == 'e' || t == 'f' || t == 'u';
+								lut[CASE_EXPONENT][i] = t == 'f' || t == '-' || t == '+';
+								lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
+								lut[CASE_NONE][i] = false;
+							}
 						}
-					}
+					} suffix_lut_data;
+					const auto &suffix_lut = suffix_lut_data.lut;
 
 					String str;
 					int i = 0;
@@ -3513,7 +3514,19 @@ const ShaderLanguage::BuiltinFuncDef ShaderLanguage::builtin_func_defs[] = {
 	{ nullptr, TYPE_VOID, { TYPE_VOID }, { "" }, TAG_GLOBAL, false }
 };
 
-HashSet<StringName> global_func_set;
+// Built once and never modified afterwards, so parsers on several threads can share it.
+const HashSet<StringName> &ShaderLanguage::_get_global_func_set() {
+	static const HashSet<StringName> global_func_set = []() {
+		HashSet<StringName> func_set;
+		for (int idx = 0; builtin_func_defs[idx].name; idx++) {
+			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
+				func_set.insert(builtin_func_defs[idx].name);
+			}
+		}
+		return func_set;
+	}();
+	return global_func_set;
+}
 
 const ShaderLanguage::BuiltinFuncOutArgs ShaderLanguage::builtin_func_out_args[] = {
 	{ "modf", { 1, -1 } },
@@ -3544,8 +3557,6 @@ const ShaderLanguage::BuiltinEntry ShaderLanguage::frag_only_func_defs[] = {
 	{ nullptr }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
-
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
 
@@ -10990,7 +11001,7 @@ Error ShaderLanguage::_parse_shader(const HashMap<StringName, FunctionInfo> &p_f
 }
 
 bool ShaderLanguage::has_builtin(const HashMap<StringName, ShaderLanguage::FunctionInfo> &p_functions, const StringName &p_name, bool p_check_global_funcs) {
-	if (p_check_global_funcs && global_func_set.has(p_name)) {
+	if (p_check_global_funcs && _get_global_func_set().has(p_name)) {
 		return true;
 	}
 
@@ -11882,17 +11893,6 @@ ShaderLanguage::ShaderLanguage() {
 	nodes = nullptr;
 	completion_class = TAG_GLOBAL;
 
-	if (instance_counter.get() == 0) {
-		int idx = 0;
-		while (builtin_func_defs[idx].name) {
-			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
-				global_func_set.insert(builtin_func_defs[idx].name);
-			}
-			idx++;
-		}
-	}
-	instance_counter.increment();
-
 #ifdef DEBUG_ENABLED
 	warnings_check_map.insert(ShaderWarning::UNUSED_CONSTANT, &used_constants);
 	warnings_check_map.insert(ShaderWarning::UNUSED_FUNCTION, &used_functions);
@@ -11906,8 +11906,4 @@ ShaderLanguage::ShaderLanguage() {
 
 ShaderLanguage::~ShaderLanguage() {
 	clear();
-	instance_counter.decrement();
-	if (instance_counter.get() == 0) {
-		global_func_set.clear();
-	}
 }
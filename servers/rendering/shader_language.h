@@ -855,8 +855,6 @@ public:
 	static bool is_control_flow_keyword(String p_keyword);
 	static void get_builtin_funcs(List<String> *r_keywords);
 
-	static SafeNumeric<int> instance_counter;
-
 	struct BuiltInInfo {
 		DataType type = TYPE_VOID;
 		bool constant = false;
@@ -1181,8 +1179,7 @@ private:
 	static const BuiltinFuncOutArgs builtin_func_out_args[];
 	static const BuiltinFuncConstArgs builtin_func_const_args[];
 	static const BuiltinEntry frag_only_func_defs[];
-
-	static bool is_const_suffix_lut_initialized;
+	static const HashSet<StringName> &_get_global_func_set();
 
 	Error _validate_precision(DataType p_type, DataPrecision p_precision);
 	bool _compare_datatypes(DataType p_datatype_a, String p_datatype_name_a, int p_array_size_a, DataType p_datatype_b, String p_datatype_name_b, int p_array_size_b);
@@ -61,6 +61,13 @@ public:
 	virtual void shader_free(RID p_rid) = 0;
 
 	virtual void shader_set_code(RID p_shader, const String &p_code) = 0;
+	// Storages can override this to parse the shaders in parallel, then create the driver objects serially.
+	virtual void shader_set_code_batch(const Vector<RID> &p_shaders, const Vector<String> &p_codes) {
+		ERR_FAIL_COND(p_shaders.size() != p_codes.size());
+		for (int i = 0; i < p_shaders.size(); i++) {
+			shader_set_code(p_shaders[i], p_codes[i]);
+		}
+	}
 	virtual void shader_set_path_hint(RID p_shader, const String &p_path) = 0;
 	virtual String shader_get_code(RID p_shader) const = 0;
 	virtual void get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const = 0;
@@ -36,6 +36,17 @@
 #include "core/config/project_settings.h"
 #endif
 
+void RendererMeshStorage::mesh_instances_update_deformed(const Vector<RID> &p_mesh_instances) {
+}
+
+AABB RendererMeshStorage::mesh_instance_get_deformed_aabb(RID p_mesh_instance) {
+	ERR_FAIL_V_MSG(AABB(), "This renderer deforms meshes on the GPU, CPU-side deformation results are only available with the dummy renderer.");
+}
+
+Vector<Vector3> RendererMeshStorage::mesh_instance_get_deformed_surface_vertices(RID p_mesh_instance, int p_surface) {
+	ERR_FAIL_V_MSG(Vector<Vector3>(), "This renderer deforms meshes on the GPU, CPU-side deformation results are only available with the dummy renderer.");
+}
+
 RID RendererMeshStorage::multimesh_allocate() {
 	return _multimesh_allocate();
 }
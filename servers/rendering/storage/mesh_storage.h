@@ -89,6 +89,11 @@ public:
 	virtual void mesh_instance_set_canvas_item_transform(RID p_mesh_instance, const Transform2D &p_transform) = 0;
 	virtual void update_mesh_instances() = 0;
 
+	// CPU-side results of skinning and blend shapes, only available on renderers that deform meshes on the CPU.
+	virtual void mesh_instances_update_deformed(const Vector<RID> &p_mesh_instances);
+	virtual AABB mesh_instance_get_deformed_aabb(RID p_mesh_instance);
+	virtual Vector<Vector3> mesh_instance_get_deformed_surface_vertices(RID p_mesh_instance, int p_surface);
+
 	/* MULTIMESH API */
 	struct MultiMeshInterpolator {
 		RS::MultimeshTransformFormat _transform_format = RS::MULTIMESH_TRANSFORM_3D;
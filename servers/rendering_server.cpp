@@ -102,6 +102,22 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+TypedArray<AABB> RenderingServer::_instances_get_deformed_aabbs_bind(const TypedArray<RID> &p_instances) {
+	Vector<RID> instances;
+	instances.resize(p_instances.size());
+	for (int i = 0; i < p_instances.size(); i++) {
+		instances.write[i] = p_instances[i];
+	}
+
+	Vector<AABB> aabbs = instances_get_deformed_aabbs(instances);
+	TypedArray<AABB> ret;
+	ret.resize(aabbs.size());
+	for (int i = 0; i < aabbs.size(); i++) {
+		ret[i] = aabbs[i];
+	}
+	return ret;
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -2056,6 +2072,15 @@ TypedArray<Dictionary> RenderingServer::_canvas_item_get_instance_shader_paramet
 	return convert_property_list(&params);
 }
 
+void RenderingServer::_shader_set_code_batch(const TypedArray<RID> &p_shaders, const PackedStringArray &p_codes) {
+	Vector<RID> shaders;
+	shaders.resize(p_shaders.size());
+	for (int i = 0; i < p_shaders.size(); i++) {
+		shaders.write[i] = p_shaders[i];
+	}
+	shader_set_code_batch(shaders, p_codes);
+}
+
 TypedArray<Image> RenderingServer::_bake_render_uv2(RID p_base, const TypedArray<RID> &p_material_overrides, const Size2i &p_image_size) {
 	TypedArray<RID> mat_overrides;
 	for (int i = 0; i < p_material_overrides.size(); i++) {
@@ -2073,6 +2098,32 @@ void RenderingServer::_particles_set_trail_bind_poses(RID p_particles, const Typ
 	particles_set_trail_bind_poses(p_particles, tbposes);
 }
 
+void RenderingServer::_instances_set_transforms(const TypedArray<RID> &p_instances, const TypedArray<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_transforms.size());
+	for (int i = 0; i < p_instances.size(); i++) {
+		instances.write[i] = p_instances[i];
+		transforms.write[i] = p_transforms[i];
+	}
+	instances_set_transforms(instances, transforms);
+}
+
+void RenderingServer::_canvas_items_set_transforms(const TypedArray<RID> &p_items, const TypedArray<Transform2D> &p_transforms) {
+	ERR_FAIL_COND(p_items.size() != p_transforms.size());
+	Vector<RID> items;
+	Vector<Transform2D> transforms;
+	items.resize(p_items.size());
+	transforms.resize(p_transforms.size());
+	for (int i = 0; i < p_items.size(); i++) {
+		items.write[i] = p_items[i];
+		transforms.write[i] = p_transforms[i];
+	}
+	canvas_items_set_transforms(items, transforms);
+}
+
 String RenderingServer::get_current_rendering_driver_name() const {
 	// Needs to remain in OS, since it's actually OS that interacts with it, but it's better exposed here.
 	return ::OS::get_singleton()->get_current_rendering_driver_name();
@@ -2301,6 +2352,7 @@ void RenderingServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("shader_create"), &RenderingServer::shader_create);
 	ClassDB::bind_method(D_METHOD("shader_set_code", "shader", "code"), &RenderingServer::shader_set_code);
+	ClassDB::bind_method(D_METHOD("shader_set_code_batch", "shaders", "codes"), &RenderingServer::_shader_set_code_batch);
 	ClassDB::bind_method(D_METHOD("shader_set_path_hint", "shader", "path"), &RenderingServer::shader_set_path_hint);
 	ClassDB::bind_method(D_METHOD("shader_get_code", "shader"), &RenderingServer::shader_get_code);
 	ClassDB::bind_method(D_METHOD("get_shader_parameter_list", "shader"), &RenderingServer::_shader_get_shader_parameter_list);
@@ -3164,6 +3216,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms);
 	ClassDB::bind_method(D_METHOD("instance_set_interpolated", "instance", "interpolated"), &RenderingServer::instance_set_interpolated);
 	ClassDB::bind_method(D_METHOD("instance_reset_physics_interpolation", "instance"), &RenderingServer::instance_reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
@@ -3196,6 +3249,10 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &RenderingServer::_instances_cull_ray_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_convex", "convex", "scenario"), &RenderingServer::_instances_cull_convex_bind, DEFVAL(RID()));
 
+	ClassDB::bind_method(D_METHOD("instance_get_deformed_aabb", "instance"), &RenderingServer::instance_get_deformed_aabb);
+	ClassDB::bind_method(D_METHOD("instances_get_deformed_aabbs", "instances"), &RenderingServer::_instances_get_deformed_aabbs_bind);
+	ClassDB::bind_method(D_METHOD("instance_get_deformed_surface_vertices", "instance", "surface"), &RenderingServer::instance_get_deformed_surface_vertices);
+
 	BIND_ENUM_CONSTANT(INSTANCE_NONE);
 	BIND_ENUM_CONSTANT(INSTANCE_MESH);
 	BIND_ENUM_CONSTANT(INSTANCE_MULTIMESH);
@@ -3268,6 +3325,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_set_light_mask", "item", "mask"), &RenderingServer::canvas_item_set_light_mask);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_visibility_layer", "item", "visibility_layer"), &RenderingServer::canvas_item_set_visibility_layer);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_transform", "item", "transform"), &RenderingServer::canvas_item_set_transform);
+	ClassDB::bind_method(D_METHOD("canvas_items_set_transforms", "items", "transforms"), &RenderingServer::_canvas_items_set_transforms);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_clip", "item", "clip"), &RenderingServer::canvas_item_set_clip);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_distance_field_mode", "item", "enabled"), &RenderingServer::canvas_item_set_distance_field_mode);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_custom_rect", "item", "use_custom_rect", "rect"), &RenderingServer::canvas_item_set_custom_rect, DEFVAL(Rect2()));
@@ -3495,6 +3553,8 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_PIPELINE_COMPILATIONS_SURFACE);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_YSORT_FULL_SORTS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_YSORT_INCREMENTAL_SORTS_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(PIPELINE_SOURCE_CANVAS);
 	BIND_ENUM_CONSTANT(PIPELINE_SOURCE_MESH);
@@ -811,4 +811,22 @@
 		}                                                                                                                                                                                                           \
 	}
 
+// Applies m_single to every pair of array elements, queued as a single command.
+#define FUNC2BATCH(m_type, m_single, m_arg1, m_arg2)                                   \
+	virtual void m_type(const Vector<m_arg1> &p1, const Vector<m_arg2> &p2) override { \
+		WRITE_ACTION                                                                   \
+		ERR_FAIL_COND(p1.size() != p2.size());                                         \
+		if (p1.is_empty()) {                                                           \
+			return;                                                                    \
+		}                                                                              \
+		if (Thread::get_caller_id() != server_thread) {                                \
+			command_queue.push_batch(server_name, &ServerName::m_single, p1, p2);      \
+		} else {                                                                       \
+			command_queue.flush_if_pending();                                          \
+			for (int i = 0; i < p1.size(); i++) {                                      \
+				server_name->m_single(p1[i], p2[i]);                                   \
+			}                                                                          \
+		}                                                                              \
+	}
+
 #endif // SERVER_WRAP_MT_COMMON_H
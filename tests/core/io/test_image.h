@@ -443,6 +443,82 @@ TEST_CASE("[Image] Convert image") {
 	CHECK_MESSAGE(image2->get_data() == image_data, "Image conversion to invalid type (Image::FORMAT_MAX + 1) should not alter image.");
 }
 
+TEST_CASE("[Image] Processing large images") {
+	// Large enough to be split across worker threads and to use the SIMD mipmap paths.
+	const int width = 512;
+	const int height = 384;
+
+	PackedByteArray data_rgba8;
+	data_rgba8.resize(width * height * 4);
+	PackedFloat32Array data_rgbaf;
+	data_rgbaf.resize(width * height * 4);
+	for (int i = 0; i < data_rgba8.size(); i++) {
+		data_rgba8.write[i] = (i * 7 + (i / 1024) * 13) & 0xFF;
+		data_rgbaf.write[i] = (i % 97) * 0.125f;
+	}
+	Ref<Image> image_rgba8 = Image::create_from_data(width, height, false, Image::FORMAT_RGBA8, data_rgba8);
+	Ref<Image> image_rgbaf = Image::create_from_data(width, height, false, Image::FORMAT_RGBAF, data_rgbaf.to_byte_array());
+
+	SUBCASE("Generating mipmaps") {
+		REQUIRE(image_rgba8->generate_mipmaps() == OK);
+		REQUIRE(image_rgbaf->generate_mipmaps() == OK);
+
+		const uint8_t *mip_rgba8 = image_rgba8->get_data().ptr() + image_rgba8->get_mipmap_offset(1);
+		const float *mip_rgbaf = (const float *)(image_rgbaf->get_data().ptr() + image_rgbaf->get_mipmap_offset(1));
+		bool all_equal = true;
+		for (int y = 0; y < height / 2 && all_equal; y++) {
+			for (int x = 0; x < width / 2; x++) {
+				for (int c = 0; c < 4; c++) {
+					const int up = ((y * 2) * width + x * 2) * 4 + c;
+					const int down = up + width * 4;
+					const uint8_t expected_rgba8 = (data_rgba8[up] + data_rgba8[up + 4] + data_rgba8[down] + data_rgba8[down + 4] + 2) >> 2;
+					const float expected_rgbaf = (data_rgbaf[up] + data_rgbaf[up + 4] + data_rgbaf[down] + data_rgbaf[down + 4]) * 0.25f;
+					const int dst = (y * (width / 2) + x) * 4 + c;
+					all_equal = all_equal && mip_rgba8[dst] == expected_rgba8 && mip_rgbaf[dst] == expected_rgbaf;
+				}
+			}
+		}
+		CHECK_MESSAGE(all_equal, "The first mipmap level should be the 2x2 average of the base level.");
+
+		Ref<Image> last_mip = image_rgba8->get_image_from_mipmap(image_rgba8->get_mipmap_count());
+		CHECK(last_mip->get_size() == Vector2(1, 1));
+	}
+
+	SUBCASE("Resizing") {
+		Ref<Image> resized = image_rgba8->duplicate();
+		resized->resize(width * 2, height * 2, Image::INTERPOLATE_NEAREST);
+		bool all_equal = true;
+		for (int y = 0; y < height * 2 && all_equal; y += 3) {
+			for (int x = 0; x < width * 2; x += 5) {
+				all_equal = all_equal && resized->get_pixel(x, y) == image_rgba8->get_pixel(x / 2, y / 2);
+			}
+		}
+		CHECK_MESSAGE(all_equal, "Nearest neighbor upscaling by 2 should repeat each source pixel.");
+
+		for (int i = Image::INTERPOLATE_BILINEAR; i <= Image::INTERPOLATE_LANCZOS; i++) {
+			Ref<Image> scaled = image_rgbaf->duplicate();
+			scaled->resize(width / 3, height / 3, (Image::Interpolation)i);
+			CHECK(scaled->get_size() == Vector2(width / 3, height / 3));
+		}
+	}
+
+	SUBCASE("Converting") {
+		Ref<Image> converted = image_rgba8->duplicate();
+		converted->convert(Image::FORMAT_RGB8);
+		const uint8_t *rgb = converted->get_data().ptr();
+		bool all_equal = true;
+		for (int i = 0; i < width * height && all_equal; i++) {
+			all_equal = rgb[i * 3] == data_rgba8[i * 4] && rgb[i * 3 + 1] == data_rgba8[i * 4 + 1] && rgb[i * 3 + 2] == data_rgba8[i * 4 + 2];
+		}
+		CHECK_MESSAGE(all_equal, "Converting RGBA8 to RGB8 should drop only the alpha channel.");
+
+		converted = image_rgbaf->duplicate();
+		converted->convert(Image::FORMAT_RGF);
+		CHECK(converted->get_pixel(width - 1, height - 1).r == image_rgbaf->get_pixel(width - 1, height - 1).r);
+		CHECK(converted->get_pixel(width - 1, height - 1).g == image_rgbaf->get_pixel(width - 1, height - 1).g);
+	}
+}
+
 } // namespace TestImage
 
 #endif // TEST_IMAGE_H
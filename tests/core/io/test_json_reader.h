@@ -0,0 +1,220 @@
+/**************************************************************************/
+/*  test_json_reader.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_READER_H
+#define TEST_JSON_READER_H
+
+#include "core/io/json_reader.h"
+#include "core/io/stream_peer.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestJSONReader {
+
+Ref<JSONReader> make_reader(const String &p_json) {
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	buffer->set_data_array(p_json.to_utf8_buffer());
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	reader->open_stream(buffer);
+	return reader;
+}
+
+TEST_CASE("[JSONReader] Reading tokens") {
+	Ref<JSONReader> reader = make_reader(R"({"a": [1, "two", true, null], "b": {}})");
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_BEGIN);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_KEY);
+	CHECK(reader->get_value() == Variant("a"));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_BEGIN);
+	CHECK(reader->get_depth() == 2);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant(1.0));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant("two"));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant(true));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_VALUE);
+	CHECK(reader->get_value() == Variant());
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_END);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant("b"));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_BEGIN);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->get_depth() == 0);
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONReader] Reading strings with escapes") {
+	Ref<JSONReader> reader = make_reader(R"(["line\nbreak", "été", "😀", "日本"])");
+	Array a = reader->read_value();
+	REQUIRE(a.size() == 4);
+	CHECK(a[0] == Variant("line\nbreak"));
+	CHECK(a[1] == Variant(String::utf8("été")));
+	CHECK(a[2] == Variant(String::chr(0x1F600)));
+	CHECK(a[3] == Variant(String::utf8("日本")));
+}
+
+TEST_CASE("[JSONReader] Reading whole values and skipping sections") {
+	Ref<JSONReader> reader = make_reader(R"({"skip": {"x": [1, 2, {"y": 3}]}, "keep": {"z": [4.5, "w"]}})");
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant("skip"));
+	CHECK(reader->skip_section() == OK);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant("keep"));
+
+	Dictionary d = reader->read_value();
+	Array z = d["z"];
+	REQUIRE(z.size() == 2);
+	CHECK(z[0] == Variant(4.5));
+	CHECK(z[1] == Variant("w"));
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONReader] Reading packed arrays") {
+	Ref<JSONReader> reader = make_reader(R"({"f": [1.5, -2, 3e2], "i": [9007199254740993, -4], "e": [], "n": [[1], [2, 3]]})");
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->read() == OK);
+	PackedFloat32Array f = reader->read_packed_float32_array();
+	CHECK(f == PackedFloat32Array({ 1.5, -2, 300 }));
+
+	CHECK(reader->read() == OK);
+	PackedInt64Array i = reader->read_packed_int64_array();
+	CHECK(i == PackedInt64Array({ 9007199254740993, -4 }));
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->read_packed_float64_array().is_empty());
+	CHECK(reader->get_error_message().is_empty());
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant("n"));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_BEGIN);
+	CHECK(reader->read_packed_int32_array() == PackedInt32Array({ 1 }));
+	CHECK(reader->read_packed_int32_array() == PackedInt32Array({ 2, 3 }));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_END);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONReader] Invalid documents") {
+	const char *invalid[] = {
+		"[1, 2",
+		"[1 2]",
+		"[1, ]",
+		R"({"a" 1})",
+		R"({"a": 1,})",
+		"{1: 2}",
+		"[tru]",
+		R"(["unterminated])",
+		"[1] [2]",
+		"[1e]",
+		"[1e+]",
+		"[1.]",
+		"[--1]",
+		"[-]",
+		"[1.e5]",
+		"[012]",
+		"[-01]",
+		"[00]",
+	};
+
+	for (const char *json : invalid) {
+		Ref<JSONReader> reader = make_reader(json);
+		Error err = OK;
+		while (err == OK) {
+			err = reader->read();
+		}
+		CHECK_MESSAGE(err == ERR_PARSE_ERROR, vformat("Parsing `%s` should fail.", json));
+		CHECK(!reader->get_error_message().is_empty());
+	}
+
+	Ref<JSONReader> reader = make_reader(R"(["a", 1])");
+	CHECK(reader->read_packed_float32_array().is_empty());
+	CHECK(reader->get_error_message() == "Expected number");
+
+	reader = make_reader("[1, 2e]");
+	CHECK(reader->read_packed_float32_array().is_empty());
+	CHECK(reader->get_error_message() == "Malformed number");
+
+	reader = make_reader("[1, 007]");
+	CHECK(reader->read_packed_int32_array().is_empty());
+	CHECK(reader->get_error_message() == "Malformed number");
+
+	// A single zero is still fine.
+	reader = make_reader("[0, -0, 0.5, 0e1, 10]");
+	CHECK(reader->read_packed_float32_array() == PackedFloat32Array({ 0, 0, 0.5, 0, 10 }));
+}
+
+TEST_CASE("[JSONReader] Reading from a file across buffer boundaries") {
+	const String path = TestUtils::get_temp_path("json_reader_large.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("[");
+		for (int i = 0; i < 50000; i++) {
+			f->store_string(i > 0 ? ", " : "");
+			f->store_string(itos(i));
+		}
+		f->store_string("]");
+	}
+
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	REQUIRE(reader->open(path) == OK);
+	PackedInt32Array values = reader->read_packed_int32_array();
+	REQUIRE(values.size() == 50000);
+	CHECK(values[0] == 0);
+	CHECK(values[12345] == 12345);
+	CHECK(values[49999] == 49999);
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+} // namespace TestJSONReader
+
+#endif // TEST_JSON_READER_H
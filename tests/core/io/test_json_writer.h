@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*  test_json_writer.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_WRITER_H
+#define TEST_JSON_WRITER_H
+
+#include "core/io/json.h"
+#include "core/io/json_writer.h"
+#include "core/io/stream_peer.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestJSONWriter {
+
+TEST_CASE("[JSONWriter] Writing a document") {
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	writer->open_stream(buffer);
+
+	CHECK(writer->begin_object() == OK);
+	CHECK(writer->write_key("name") == OK);
+	CHECK(writer->write_value("say \"hi\"") == OK);
+	CHECK(writer->write_key("ints") == OK);
+	CHECK(writer->write_value(PackedInt32Array({ 1, -2, 3 })) == OK);
+	CHECK(writer->write_key("floats") == OK);
+	CHECK(writer->write_value(PackedFloat32Array({ 0.5, 0 })) == OK);
+	CHECK(writer->write_key("list") == OK);
+	CHECK(writer->begin_array() == OK);
+	CHECK(writer->write_value(true) == OK);
+	CHECK(writer->begin_object() == OK);
+	CHECK(writer->end_object() == OK);
+	CHECK(writer->write_value(Variant()) == OK);
+	CHECK(writer->end_array() == OK);
+	CHECK(writer->end_object() == OK);
+	CHECK(writer->close() == OK);
+
+	const String json = String::utf8((const char *)buffer->get_data_array().ptr(), buffer->get_data_array().size());
+	CHECK(json == R"({"name":"say \"hi\"","ints":[1,-2,3],"floats":[0.5,0.0],"list":[true,{},null]})");
+
+	Dictionary parsed = JSON::parse_string(json);
+	CHECK(parsed["name"] == Variant("say \"hi\""));
+}
+
+TEST_CASE("[JSONWriter] Writing 64-bit packed arrays") {
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	writer->open_stream(buffer);
+
+	CHECK(writer->begin_array() == OK);
+	CHECK(writer->write_value(PackedInt64Array({ 9007199254740993, -1 })) == OK);
+	CHECK(writer->write_value(PackedFloat64Array({ 1.5, -0.25 })) == OK);
+	CHECK(writer->write_value(PackedInt32Array()) == OK);
+	CHECK(writer->end_array() == OK);
+	CHECK(writer->close() == OK);
+
+	const String json = String::utf8((const char *)buffer->get_data_array().ptr(), buffer->get_data_array().size());
+	CHECK(json == "[[9007199254740993,-1],[1.5,-0.25],[]]");
+}
+
+TEST_CASE("[JSONWriter] Opening a new file writes out the previous one") {
+	const String first_path = TestUtils::get_temp_path("json_writer_first.json");
+	const String second_path = TestUtils::get_temp_path("json_writer_second.json");
+
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	CHECK(writer->open(first_path) == OK);
+	CHECK(writer->write_value(PackedInt32Array({ 1, 2 })) == OK);
+	CHECK(writer->open(second_path) == OK);
+	CHECK(writer->write_value(true) == OK);
+	CHECK(writer->close() == OK);
+
+	CHECK(FileAccess::get_file_as_string(first_path) == "[1,2]");
+	CHECK(FileAccess::get_file_as_string(second_path) == "true");
+}
+
+TEST_CASE("[JSONWriter] Write errors are reported") {
+	const String path = TestUtils::get_temp_path("json_writer_read_only.json");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->close();
+
+	// Writing to a file opened for reading fails.
+	f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	writer->open_file(f);
+
+	SUBCASE("Values bigger than the buffer") {
+		// Written straight to the file, bypassing the buffer.
+		ERR_PRINT_OFF;
+		CHECK(writer->write_value(String("a").repeat(100000)) == ERR_FILE_CANT_WRITE);
+		CHECK(writer->close() == ERR_FILE_CANT_WRITE);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Buffered values") {
+		CHECK(writer->write_value(PackedInt32Array({ 1, 2 })) == OK);
+		ERR_PRINT_OFF;
+		CHECK(writer->close() == ERR_FILE_CANT_WRITE);
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[JSONWriter] Invalid structure") {
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	writer->open_stream(buffer);
+
+	ERR_PRINT_OFF;
+	CHECK(writer->write_key("no object") != OK);
+	CHECK(writer->begin_object() == OK);
+	CHECK(writer->write_value(1) != OK);
+	CHECK(writer->end_array() != OK);
+	CHECK(writer->write_key("a") == OK);
+	CHECK(writer->end_object() != OK);
+	CHECK(writer->close() == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestJSONWriter
+
+#endif // TEST_JSON_WRITER_H
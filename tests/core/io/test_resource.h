@@ -112,6 +112,57 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Saving and loading packed arrays in binary format") {
+	PackedByteArray bytes;
+	PackedInt32Array ints;
+	PackedInt64Array longs;
+	PackedFloat32Array floats;
+	PackedFloat64Array doubles;
+	PackedVector2Array vec2s;
+	PackedVector3Array vec3s;
+	PackedColorArray colors;
+	PackedVector4Array vec4s;
+	// Odd sizes make sure padding is handled between consecutive arrays.
+	for (int i = 0; i < 1001; i++) {
+		bytes.push_back(i % 256);
+		ints.push_back(i * 3 - 500);
+		longs.push_back(int64_t(i) << 33);
+		floats.push_back(i * 0.5f);
+		doubles.push_back(i * 0.25);
+		vec2s.push_back(Vector2(i, -i));
+		vec3s.push_back(Vector3(i, i * 2, i * 3));
+		colors.push_back(Color(i / 1000.0, 0.5, 0.25, 1.0));
+		vec4s.push_back(Vector4(i, 1, 2, 3));
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("ints", ints);
+	resource->set_meta("longs", longs);
+	resource->set_meta("floats", floats);
+	resource->set_meta("doubles", doubles);
+	resource->set_meta("vec2s", vec2s);
+	resource->set_meta("vec3s", vec3s);
+	resource->set_meta("colors", colors);
+	resource->set_meta("vec4s", vec4s);
+	resource->set_meta("empty", PackedVector3Array());
+	const String save_path_binary = TestUtils::get_temp_path("resource_packed_arrays.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	const Ref<Resource> &loaded_resource = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(PackedByteArray(loaded_resource->get_meta("bytes")) == bytes);
+	CHECK(PackedInt32Array(loaded_resource->get_meta("ints")) == ints);
+	CHECK(PackedInt64Array(loaded_resource->get_meta("longs")) == longs);
+	CHECK(PackedFloat32Array(loaded_resource->get_meta("floats")) == floats);
+	CHECK(PackedFloat64Array(loaded_resource->get_meta("doubles")) == doubles);
+	CHECK(PackedVector2Array(loaded_resource->get_meta("vec2s")) == vec2s);
+	CHECK(PackedVector3Array(loaded_resource->get_meta("vec3s")) == vec3s);
+	CHECK(PackedColorArray(loaded_resource->get_meta("colors")) == colors);
+	CHECK(PackedVector4Array(loaded_resource->get_meta("vec4s")) == vec4s);
+	CHECK(PackedVector3Array(loaded_resource->get_meta("empty")).is_empty());
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestBVH {
+
+// Two trees, paired so that each item remembers which tree it is in.
+typedef BVH_Tree<int, 2, 2, 8, BVH_DummyPairTestFunction<int>, BVH_DummyCullTestFunction<int>, true> TestTree;
+
+static AABB _get_root_aabb(const TestTree &p_tree, uint32_t p_tree_id) {
+	AABB aabb;
+	p_tree._nodes[p_tree._root_node_id[p_tree_id]].aabb.to(aabb);
+	return aabb;
+}
+
+static TestTree::TLeaf &_get_leaf(TestTree &p_tree, BVHHandle p_handle) {
+	return p_tree._node_get_leaf(p_tree._nodes[p_tree._refs[p_handle.id()].tnode_id]);
+}
+
+TEST_CASE("[BVH] Update only refits the trees with dirty leaves") {
+	int items[4] = { 0, 1, 2, 3 };
+
+	TestTree tree;
+	// Keep the incremental optimization from moving items around, so only the refit changes the trees.
+	tree._incremental_optimize_tree_mask = 0;
+
+	const BVHHandle static_a = tree.item_add(&items[0], true, AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)), 0, 0, 1 << 1);
+	const BVHHandle static_b = tree.item_add(&items[1], true, AABB(Vector3(10, 0, 0), Vector3(1, 1, 1)), 0, 0, 1 << 1);
+	const BVHHandle dynamic_a = tree.item_add(&items[2], true, AABB(Vector3(0, 5, 0), Vector3(1, 1, 1)), 0, 1, 1 << 0);
+	const BVHHandle dynamic_b = tree.item_add(&items[3], true, AABB(Vector3(10, 5, 0), Vector3(1, 1, 1)), 0, 1, 1 << 0);
+	tree.update();
+	CHECK(!tree._tree_needs_refit[0]);
+	CHECK(!tree._tree_needs_refit[1]);
+
+	// The items of each tree share a single leaf.
+	REQUIRE(&_get_leaf(tree, static_a) == &_get_leaf(tree, static_b));
+	REQUIRE(&_get_leaf(tree, dynamic_a) == &_get_leaf(tree, dynamic_b));
+
+	// Removing an item at the edge of a leaf leaves its bound too large until the next update.
+	tree.item_remove(dynamic_b);
+	CHECK(_get_leaf(tree, dynamic_a).is_dirty());
+	CHECK(tree._tree_needs_refit[1]);
+	CHECK(!tree._tree_needs_refit[0]);
+	CHECK(_get_root_aabb(tree, 1).has_point(Vector3(10.5, 5.5, 0.5)));
+
+	// A leaf marked dirty without flagging its tree shows whether that tree is skipped.
+	_get_leaf(tree, static_a).set_dirty(true);
+
+	tree.update();
+	CHECK(!tree._tree_needs_refit[1]);
+	CHECK_MESSAGE(!_get_leaf(tree, dynamic_a).is_dirty(), "The dirty leaf should have been refit.");
+	CHECK_FALSE(_get_root_aabb(tree, 1).has_point(Vector3(10.5, 5.5, 0.5)));
+	CHECK(_get_root_aabb(tree, 1).has_point(Vector3(0.5, 5.5, 0.5)));
+	CHECK_MESSAGE(_get_leaf(tree, static_a).is_dirty(), "Trees that don't need a refit should be skipped.");
+	CHECK(_get_root_aabb(tree, 0).has_point(Vector3(10.5, 0.5, 0.5)));
+
+	tree.item_remove(dynamic_a);
+	tree.item_remove(static_b);
+	tree.item_remove(static_a);
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
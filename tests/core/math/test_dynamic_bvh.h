@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  test_dynamic_bvh.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DYNAMIC_BVH_H
+#define TEST_DYNAMIC_BVH_H
+
+#include "core/math/dynamic_bvh.h"
+#include "core/templates/hash_set.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestDynamicBVH {
+
+struct CountQueryResult {
+	HashSet<intptr_t> found;
+
+	bool operator()(void *p_data) {
+		found.insert((intptr_t)p_data);
+		return false;
+	}
+};
+
+static AABB _element_aabb(int p_index) {
+	// A loose grid with some overlapping elements.
+	return AABB(Vector3(p_index % 64, (p_index / 64) % 16, p_index / 1024) * 2.0, Vector3(1.5, 1.5, 1.5 + (p_index % 3)));
+}
+
+TEST_CASE("[DynamicBVH] SAH rebuild keeps elements and query results") {
+	const int element_count = 4096;
+	const AABB query_box(Vector3(10, 3, 1), Vector3(20, 8, 3));
+
+	DynamicBVH bvh;
+	LocalVector<DynamicBVH::ID> ids;
+	for (int i = 0; i < element_count; i++) {
+		ids.push_back(bvh.insert(_element_aabb(i), (void *)intptr_t(i + 1)));
+	}
+
+	CountQueryResult before;
+	bvh.aabb_query(query_box, before);
+	CHECK(before.found.size() > 0);
+
+	SUBCASE("Single threaded") {
+		bvh.optimize_sah(false);
+	}
+	SUBCASE("Multithreaded") {
+		bvh.optimize_sah(true);
+	}
+
+	CHECK(bvh.get_leaf_count() == element_count);
+
+	CountQueryResult after;
+	bvh.aabb_query(query_box, after);
+	CHECK(after.found.size() == before.found.size());
+	for (const intptr_t &E : before.found) {
+		CHECK(after.found.has(E));
+	}
+
+	// IDs from before the rebuild are still usable.
+	bvh.update(ids[0], AABB(Vector3(1000, 1000, 1000), Vector3(1, 1, 1)));
+	for (int i = 1; i < element_count; i += 2) {
+		bvh.remove(ids[i]);
+	}
+	CHECK(bvh.get_leaf_count() == element_count / 2);
+
+	CountQueryResult far;
+	bvh.aabb_query(AABB(Vector3(999, 999, 999), Vector3(3, 3, 3)), far);
+	CHECK(far.found.size() == 1);
+	CHECK(far.found.has(1));
+}
+
+} // namespace TestDynamicBVH
+
+#endif // TEST_DYNAMIC_BVH_H
@@ -166,6 +166,29 @@ TEST_CASE("[String] UTF8 with CR") {
 	CHECK(no_cr == base.replace("\r", ""));
 }
 
+TEST_CASE("[String] UTF8 with long ASCII runs") {
+	// Places non-ASCII characters, CR and NUL at every offset around the block sizes used by bulk conversion.
+	const String ascii = "The quick brown fox jumps over the lazy dog 0123456789";
+	const char32_t specials[] = { U'é', U'日', 0x1F600, U'\r' };
+	for (const char32_t special : specials) {
+		for (int pos = 0; pos < ascii.length(); pos++) {
+			String s = ascii.substr(0, pos) + String::chr(special) + ascii.substr(pos);
+			CharString cs = s.utf8();
+
+			String decoded;
+			CHECK(decoded.parse_utf8(cs.get_data()) == OK);
+			CHECK(decoded == s);
+			CHECK(decoded.parse_utf8(cs.get_data(), cs.length()) == OK);
+			CHECK(decoded == s);
+			CHECK(decoded.parse_utf8(cs.get_data(), cs.length(), true) == OK);
+			CHECK(decoded == s.replace("\r", ""));
+		}
+	}
+
+	const char with_nul[] = "0123456789abcdefghijklmnopqrstuv\0wxyz";
+	CHECK(String::utf8(with_nul, sizeof(with_nul) - 1) == "0123456789abcdefghijklmnopqrstuv");
+}
+
 TEST_CASE("[String] Invalid UTF8 (non-standard)") {
 	ERR_PRINT_OFF
 	static const uint8_t u8str[] = { 0x45, 0xE3, 0x81, 0x8A, 0xE3, 0x82, 0x88, 0xE3, 0x81, 0x86, 0xF0, 0x9F, 0x8E, 0xA4, 0xF0, 0x82, 0x82, 0xAC, 0xED, 0xA0, 0x81, 0 };
@@ -561,6 +561,124 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 
 	sts.destroy_threads();
 }
+
+class BatchTarget {
+public:
+	LocalVector<int> ids;
+	LocalVector<real_t> values;
+
+	void set_value(int p_id, real_t p_value) {
+		ids.push_back(p_id);
+		values.push_back(p_value);
+	}
+};
+
+TEST_CASE("[CommandQueue] Test Batched Commands") {
+	CommandQueueMT command_queue;
+	BatchTarget target;
+
+	Vector<int> ids;
+	Vector<real_t> values;
+	for (int i = 0; i < 1000; i++) {
+		ids.push_back(i);
+		values.push_back(i * 0.5);
+	}
+
+	command_queue.push_batch(&target, &BatchTarget::set_value, ids, values);
+	command_queue.push(&target, &BatchTarget::set_value, -1, 0.0);
+
+	// Changing the arrays after pushing must not affect the queued batch.
+	ids.write[0] = 1000;
+
+	CHECK_MESSAGE(target.ids.is_empty(), "Batched commands should not run before flushing.");
+	command_queue.flush_all();
+
+	REQUIRE(target.ids.size() == 1001);
+	bool in_order = true;
+	for (int i = 0; i < 1000; i++) {
+		in_order = in_order && target.ids[i] == i && target.values[i] == i * 0.5;
+	}
+	CHECK_MESSAGE(in_order, "Batched commands should run once per element, in order.");
+	CHECK_MESSAGE(target.ids[1000] == -1, "Commands pushed after a batch should run after it.");
+}
+
+struct ProducerRingState {
+	CommandQueueMT command_queue;
+	BatchTarget target;
+
+	static void push_from_other_thread(void *p_userdata) {
+		ProducerRingState *state = static_cast<ProducerRingState *>(p_userdata);
+		for (int i = 0; i < 10; i++) {
+			state->command_queue.push(&state->target, &BatchTarget::set_value, -1 - i, 0.0);
+		}
+	}
+};
+
+TEST_CASE("[CommandQueue] Test Producer Ring Ordering") {
+	ProducerRingState state;
+	state.command_queue.set_producer_thread(Thread::get_caller_id());
+
+	// Enough commands to fill the ring several times, so some of them take the locked buffer instead.
+	const int producer_count = 100000;
+	for (int i = 0; i < producer_count / 2; i++) {
+		state.command_queue.push(&state.target, &BatchTarget::set_value, i, 0.0);
+	}
+
+	// Pushes from other threads use the locked buffer, but still run after what the producer pushed before.
+	Thread thread;
+	thread.start(&ProducerRingState::push_from_other_thread, &state);
+	thread.wait_to_finish();
+
+	for (int i = producer_count / 2; i < producer_count; i++) {
+		state.command_queue.push(&state.target, &BatchTarget::set_value, i, 0.0);
+	}
+
+	CHECK_MESSAGE(state.target.ids.is_empty(), "Ring commands should not run before flushing.");
+	state.command_queue.flush_all();
+
+	REQUIRE(state.target.ids.size() == producer_count + 10);
+	bool in_order = true;
+	for (int i = 0; i < producer_count / 2; i++) {
+		in_order = in_order && state.target.ids[i] == i;
+	}
+	for (int i = 0; i < 10; i++) {
+		in_order = in_order && state.target.ids[producer_count / 2 + i] == -1 - i;
+	}
+	for (int i = producer_count / 2; i < producer_count; i++) {
+		in_order = in_order && state.target.ids[i + 10] == i;
+	}
+	CHECK_MESSAGE(in_order, "Commands should run in submission order across the ring and the locked buffer.");
+}
+
+class RefTarget {
+public:
+	int calls = 0;
+
+	void keep(Ref<RefCounted> p_object) {
+		calls++;
+	}
+};
+
+TEST_CASE("[CommandQueue] Test Destroying Unflushed Commands") {
+	Ref<RefCounted> object;
+	object.instantiate();
+	RefTarget target;
+
+	// One queue pushes through the producer ring, the other through the locked buffer.
+	CommandQueueMT *ring_queue = memnew(CommandQueueMT);
+	ring_queue->set_producer_thread(Thread::get_caller_id());
+	ring_queue->push(&target, &RefTarget::keep, object);
+	CommandQueueMT *locked_queue = memnew(CommandQueueMT);
+	locked_queue->push(&target, &RefTarget::keep, object);
+	CHECK(object->get_reference_count() == 3);
+
+	memdelete(ring_queue);
+	memdelete(locked_queue);
+
+	CHECK_MESSAGE(target.calls == 0, "Unflushed commands should not run when the queue is destroyed.");
+	CHECK_MESSAGE(object->get_reference_count() == 1, "Unflushed commands should release their arguments when the queue is destroyed.");
+}
+
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
@@ -1755,6 +1755,55 @@ TEST_CASE("[Variant] Writer and parser array") {
 	CHECK_MESSAGE(a_parsed == Variant(a), "Should parse back.");
 }
 
+TEST_CASE("[Variant] Parser packed arrays and constructors") {
+	VariantParser::StreamString ss;
+	String errs;
+	int line = 1;
+	Variant parsed;
+
+	ss.s = "PackedFloat32Array(1, -2.5, 3e2,\n 0.125 ; comment\n, inf, inf_neg)";
+	CHECK(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	PackedFloat32Array floats = parsed;
+	REQUIRE(floats.size() == 6);
+	CHECK(floats[0] == 1);
+	CHECK(floats[1] == -2.5);
+	CHECK(floats[2] == 300);
+	CHECK(floats[3] == 0.125);
+	CHECK(floats[4] == (float)INFINITY);
+	CHECK(floats[5] == (float)-INFINITY);
+
+	VariantParser::StreamString ss_int;
+	ss_int.s = "PackedInt64Array(9007199254740993, -4)";
+	CHECK(VariantParser::parse(&ss_int, parsed, errs, line) == OK);
+	CHECK(PackedInt64Array(parsed) == PackedInt64Array({ 9007199254740993, -4 }));
+
+	VariantParser::StreamString ss_vec;
+	ss_vec.s = "PackedVector3Array(1, 2, 3, 4, 5, 6)";
+	CHECK(VariantParser::parse(&ss_vec, parsed, errs, line) == OK);
+	CHECK(PackedVector3Array(parsed) == PackedVector3Array({ Vector3(1, 2, 3), Vector3(4, 5, 6) }));
+
+	VariantParser::StreamString ss_empty;
+	ss_empty.s = "PackedFloat64Array()";
+	CHECK(VariantParser::parse(&ss_empty, parsed, errs, line) == OK);
+	CHECK(PackedFloat64Array(parsed).is_empty());
+
+	VariantParser::StreamString ss_ctor;
+	ss_ctor.s = "Vector2(0.5, nan)";
+	CHECK(VariantParser::parse(&ss_ctor, parsed, errs, line) == OK);
+	CHECK(Vector2(parsed).x == 0.5);
+	CHECK(Math::is_nan(Vector2(parsed).y));
+
+	ERR_PRINT_OFF;
+	VariantParser::StreamString ss_trailing;
+	ss_trailing.s = "PackedFloat32Array(1, 2, )";
+	CHECK(VariantParser::parse(&ss_trailing, parsed, errs, line) == ERR_PARSE_ERROR);
+
+	VariantParser::StreamString ss_missing_comma;
+	ss_missing_comma.s = "PackedFloat32Array(1 2)";
+	CHECK(VariantParser::parse(&ss_missing_comma, parsed, errs, line) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON;
+}
+
 TEST_CASE("[Variant] Writer recursive array") {
 	// There is no way to accurately represent a recursive array,
 	// the only thing we can do is make sure the writer doesn't blow up
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  test_canvas_ysort.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CANVAS_YSORT_H
+#define TEST_CANVAS_YSORT_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCanvasYSort {
+
+typedef RendererCanvasCull::Item Item;
+
+// Collects the items in collection order, y-sorts them like the canvas culler does and checks the result against a full sort.
+static void sort_and_check(RendererCanvasCull &p_cull, Item *p_owner, Item *p_items, int p_count) {
+	LocalVector<Item *> collected;
+	LocalVector<Item *> expected;
+	for (int i = 0; i < p_count; i++) {
+		p_items[i].ysort_index = i;
+		collected.push_back(&p_items[i]);
+		expected.push_back(&p_items[i]);
+	}
+
+	SortArray<Item *, RendererCanvasCull::ItemYSort> sorter;
+	sorter.sort(expected.ptr(), expected.size());
+
+	p_cull._sort_ysort_children(p_owner, collected.ptr(), collected.size());
+	p_cull.update_ysort_info();
+
+	for (int i = 0; i < p_count; i++) {
+		CHECK_MESSAGE(collected[i] == expected[i], vformat("Item %d differs from a full sort.", i));
+	}
+}
+
+static void set_y(Item &p_item, real_t p_y) {
+	p_item.ysort_xform = Transform2D(0, Vector2(0, p_y));
+}
+
+TEST_CASE("[RendererCanvasCull] Incremental y-sort matches a full sort") {
+	RendererCanvasCull cull;
+	Item owner;
+
+	const int item_count = 40;
+	Item items[item_count];
+	for (int i = 0; i < item_count; i++) {
+		// Scrambled, with some ties that are broken by collection order.
+		set_y(items[i], (i * 7) % 13);
+	}
+
+	// Nothing to start from: full sort.
+	sort_and_check(cull, &owner, items, item_count);
+	CHECK(cull.get_ysort_full_sorts_in_frame() == 1);
+	CHECK(cull.get_ysort_incremental_sorts_in_frame() == 0);
+
+	// Nothing moved: the previous order is reused without sorting.
+	sort_and_check(cull, &owner, items, item_count);
+	CHECK(cull.get_ysort_full_sorts_in_frame() == 0);
+	CHECK(cull.get_ysort_incremental_sorts_in_frame() == 0);
+
+	// A few items moved: only those are re-sorted and merged back in.
+	set_y(items[3], -5);
+	set_y(items[17], 100);
+	set_y(items[25], 6.5);
+	sort_and_check(cull, &owner, items, item_count);
+	CHECK(cull.get_ysort_full_sorts_in_frame() == 0);
+	CHECK(cull.get_ysort_incremental_sorts_in_frame() == 1);
+
+	// Most items moved: full sort.
+	for (int i = 0; i < item_count; i++) {
+		set_y(items[i], item_count - i);
+	}
+	sort_and_check(cull, &owner, items, item_count);
+	CHECK(cull.get_ysort_full_sorts_in_frame() == 1);
+	CHECK(cull.get_ysort_incremental_sorts_in_frame() == 0);
+
+	// The number of items changed: full sort.
+	sort_and_check(cull, &owner, items, item_count - 1);
+	CHECK(cull.get_ysort_full_sorts_in_frame() == 1);
+	CHECK(cull.get_ysort_incremental_sorts_in_frame() == 0);
+}
+
+} // namespace TestCanvasYSort
+
+#endif // TEST_CANVAS_YSORT_H
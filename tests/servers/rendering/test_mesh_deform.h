@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  test_mesh_deform.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESH_DEFORM_H
+#define TEST_MESH_DEFORM_H
+
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMeshDeform {
+
+// Two vertices on the X axis, the first bound to bone 0 and the second to bone 1.
+static Array make_skinned_arrays() {
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 0, 0) });
+	arrays[RS::ARRAY_BONES] = PackedInt32Array({ 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0 });
+	arrays[RS::ARRAY_WEIGHTS] = PackedFloat32Array({ 1, 0, 0, 0, 1, 0, 0, 0, 0.5, 0.5, 0, 0 });
+	return arrays;
+}
+
+TEST_CASE("[SceneTree][MeshDeform] Skinning follows the bone transforms") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, make_skinned_arrays());
+
+	RID skeleton = rs->skeleton_create();
+	rs->skeleton_allocate_data(skeleton, 2);
+	rs->skeleton_bone_set_transform(skeleton, 1, Transform3D(Basis(), Vector3(0, 2, 0)));
+	CHECK(rs->skeleton_get_bone_count(skeleton) == 2);
+	CHECK(rs->skeleton_bone_get_transform(skeleton, 1).origin.is_equal_approx(Vector3(0, 2, 0)));
+
+	RID scenario = rs->scenario_create();
+	RID instance = rs->instance_create2(mesh, scenario);
+	rs->instance_attach_skeleton(instance, skeleton);
+
+	PackedVector3Array vertices = rs->instance_get_deformed_surface_vertices(instance, 0);
+	REQUIRE(vertices.size() == 3);
+	CHECK(vertices[0].is_equal_approx(Vector3(0, 0, 0)));
+	CHECK(vertices[1].is_equal_approx(Vector3(1, 2, 0)));
+	CHECK_MESSAGE(vertices[2].is_equal_approx(Vector3(1, 1, 0)), "Bone transforms should be blended by weight.");
+
+	AABB aabb = rs->instance_get_deformed_aabb(instance);
+	CHECK(aabb.position.is_equal_approx(Vector3(0, 0, 0)));
+	CHECK(aabb.size.is_equal_approx(Vector3(1, 2, 0)));
+
+	// Changing a bone invalidates the cached result.
+	rs->skeleton_bone_set_transform(skeleton, 1, Transform3D(Basis(Vector3(0, 0, 1), Math_PI / 2), Vector3()));
+	vertices = rs->instance_get_deformed_surface_vertices(instance, 0);
+	CHECK(vertices[1].is_equal_approx(Vector3(0, 1, 0)));
+
+	rs->free(instance);
+	rs->free(scenario);
+	rs->free(skeleton);
+	rs->free(mesh);
+}
+
+TEST_CASE("[SceneTree][MeshDeform] Blend shapes and batched queries") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0) });
+	Array shape;
+	shape.resize(RS::ARRAY_MAX);
+	shape[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(3, 0, 0), Vector3(0, 1, 0) });
+
+	RID mesh = rs->mesh_create();
+	rs->mesh_set_blend_shape_count(mesh, 1);
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays, Array({ shape }));
+	CHECK(rs->mesh_get_blend_shape_count(mesh) == 1);
+
+	RID scenario = rs->scenario_create();
+	const int instance_count = 8;
+	TypedArray<RID> instances;
+	for (int i = 0; i < instance_count; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_blend_shape_weight(instance, 0, i / float(instance_count - 1));
+		instances.push_back(instance);
+	}
+
+	PackedVector3Array vertices = rs->instance_get_deformed_surface_vertices(instances[instance_count - 1], 0);
+	REQUIRE(vertices.size() == 3);
+	CHECK(vertices[1].is_equal_approx(Vector3(3, 0, 0)));
+
+	rs->mesh_set_blend_shape_mode(mesh, RS::BLEND_SHAPE_MODE_RELATIVE);
+	Vector<RID> instance_rids;
+	for (int i = 0; i < instance_count; i++) {
+		instance_rids.push_back(instances[i]);
+	}
+	Vector<AABB> aabbs = rs->instances_get_deformed_aabbs(instance_rids);
+	REQUIRE(aabbs.size() == instance_count);
+	for (int i = 0; i < instance_count; i++) {
+		const real_t weight = i / real_t(instance_count - 1);
+		// In relative mode, the shape is added on top of the base mesh.
+		CHECK(aabbs[i].size.x == doctest::Approx(1 + 3 * weight));
+		CHECK(aabbs[i].size.y == doctest::Approx(1 + weight));
+	}
+
+	for (int i = 0; i < instance_count; i++) {
+		rs->free(instances[i]);
+	}
+	rs->free(scenario);
+	rs->free(mesh);
+}
+
+TEST_CASE("[SceneTree][MeshDeform] Changing the blend shape count of a mesh with instances") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID mesh = rs->mesh_create();
+	RID mesh_instance = RSG::mesh_storage->mesh_instance_create(mesh);
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0) });
+	Array shape;
+	shape.resize(RS::ARRAY_MAX);
+	shape[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(3, 0, 0), Vector3(0, 1, 0) });
+
+	// The instance was created without blend shapes, its weights have to follow the mesh.
+	rs->mesh_set_blend_shape_count(mesh, 1);
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays, Array({ shape }));
+	RSG::mesh_storage->mesh_instance_set_blend_shape_weight(mesh_instance, 0, 1.0);
+
+	Vector<Vector3> vertices = RSG::mesh_storage->mesh_instance_get_deformed_surface_vertices(mesh_instance, 0);
+	REQUIRE(vertices.size() == 3);
+	CHECK(vertices[1].is_equal_approx(Vector3(3, 0, 0)));
+
+	// Shrinking the count drops the weights of the removed shapes.
+	rs->mesh_clear(mesh);
+	rs->mesh_set_blend_shape_count(mesh, 0);
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+	vertices = RSG::mesh_storage->mesh_instance_get_deformed_surface_vertices(mesh_instance, 0);
+	REQUIRE(vertices.size() == 3);
+	CHECK(vertices[1].is_equal_approx(Vector3(1, 0, 0)));
+
+	RSG::mesh_storage->mesh_instance_free(mesh_instance);
+	rs->free(mesh);
+}
+
+} // namespace TestMeshDeform
+
+#endif // TEST_MESH_DEFORM_H
@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static bool is_box_occluded(RendererSceneOcclusionCull::HZBuffer *p_buffer, const AABB &p_box, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const real_t bounds[6] = { p_box.position.x, p_box.position.y, p_box.position.z, p_box.position.x + p_box.size.x, p_box.position.y + p_box.size.y, p_box.position.z + p_box.size.z };
+	uint64_t occlusion_timeout = 0;
+	return p_buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), occlusion_timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Occlusion by a quad") {
+	RasterOcclusionCull occlusion_cull;
+
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	occlusion_cull.add_scenario(scenario);
+
+	// A 4x4 quad facing the camera at the origin.
+	const RID occluder = occlusion_cull.occluder_allocate();
+	occlusion_cull.occluder_initialize(occluder);
+	CHECK(occlusion_cull.is_occluder(occluder));
+	occlusion_cull.occluder_set_mesh(occluder, PackedVector3Array({ Vector3(-2, -2, 0), Vector3(2, -2, 0), Vector3(2, 2, 0), Vector3(-2, 2, 0) }), PackedInt32Array({ 0, 1, 2, 0, 2, 3 }));
+	occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+
+	occlusion_cull.add_buffer(buffer);
+	occlusion_cull.buffer_set_scenario(buffer, scenario);
+	occlusion_cull.buffer_set_size(buffer, Vector2i(64, 48));
+
+	RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull.buffer_get_ptr(buffer);
+	REQUIRE(hz_buffer != nullptr);
+	CHECK(hz_buffer->get_occlusion_buffer_size() == Size2i(64, 48));
+
+	const AABB behind = AABB(Vector3(-0.5, -0.5, -3), Vector3(1, 1, 1));
+	const AABB in_front = AABB(Vector3(-0.5, -0.5, 1), Vector3(1, 1, 1));
+	const AABB beside = AABB(Vector3(4, -0.5, -3), Vector3(1, 1, 1));
+
+	const Transform3D cam_transform = Transform3D(Basis(), Vector3(0, 0, 5));
+
+	SUBCASE("Perspective camera") {
+		Projection cam_projection;
+		cam_projection.set_perspective(60, 4.0 / 3.0, 0.1, 100);
+		occlusion_cull.buffer_update(buffer, cam_transform, cam_projection, false);
+
+		CHECK(is_box_occluded(hz_buffer, behind, cam_transform, cam_projection));
+		CHECK_FALSE(is_box_occluded(hz_buffer, in_front, cam_transform, cam_projection));
+		CHECK_FALSE(is_box_occluded(hz_buffer, beside, cam_transform, cam_projection));
+	}
+
+	SUBCASE("Orthogonal camera") {
+		Projection cam_projection;
+		cam_projection.set_orthogonal(-8, 8, -6, 6, 0.1, 100);
+		occlusion_cull.buffer_update(buffer, cam_transform, cam_projection, true);
+
+		CHECK(is_box_occluded(hz_buffer, behind, cam_transform, cam_projection));
+		CHECK_FALSE(is_box_occluded(hz_buffer, in_front, cam_transform, cam_projection));
+		CHECK_FALSE(is_box_occluded(hz_buffer, beside, cam_transform, cam_projection));
+	}
+
+	SUBCASE("Camera close to the occluder") {
+		// Triangles crossing the near plane and the screen edges have to be clipped.
+		const Transform3D close_transform = Transform3D(Basis(), Vector3(0.5, 0, 0.2));
+		Projection cam_projection;
+		cam_projection.set_perspective(90, 4.0 / 3.0, 0.1, 100);
+		occlusion_cull.buffer_update(buffer, close_transform, cam_projection, false);
+
+		CHECK(is_box_occluded(hz_buffer, behind, close_transform, cam_projection));
+	}
+
+	SUBCASE("Disabled and removed instances") {
+		Projection cam_projection;
+		cam_projection.set_perspective(60, 4.0 / 3.0, 0.1, 100);
+
+		occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(), false);
+		occlusion_cull.buffer_update(buffer, cam_transform, cam_projection, false);
+		CHECK_FALSE(is_box_occluded(hz_buffer, behind, cam_transform, cam_projection));
+
+		occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+		occlusion_cull.buffer_update(buffer, cam_transform, cam_projection, false);
+		CHECK(is_box_occluded(hz_buffer, behind, cam_transform, cam_projection));
+
+		occlusion_cull.scenario_remove_instance(scenario, instance);
+		occlusion_cull.buffer_update(buffer, cam_transform, cam_projection, false);
+		CHECK_FALSE(is_box_occluded(hz_buffer, behind, cam_transform, cam_projection));
+	}
+
+	occlusion_cull.remove_buffer(buffer);
+	occlusion_cull.remove_scenario(scenario);
+	occlusion_cull.free_occluder(occluder);
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  test_scene_cull_bounds.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_CULL_BOUNDS_H
+#define TEST_SCENE_CULL_BOUNDS_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/test_macros.h"
+
+namespace TestSceneCullBounds {
+
+TEST_CASE("[SceneCull] Frustum tests of bounds blocks match single bounds") {
+	RandomPCG rng(5678);
+
+	PagedArrayPool<RendererSceneCull::InstanceBounds> pool;
+	PagedArray<RendererSceneCull::InstanceBounds> bounds;
+	bounds.set_page_pool(&pool);
+
+	// Boxes of all sizes around the cameras, many of them crossing the frustum planes.
+	const uint32_t bounds_count = 203;
+	for (uint32_t i = 0; i < bounds_count; i++) {
+		const Vector3 position(rng.random(-20.0, 20.0), rng.random(-20.0, 20.0), rng.random(-20.0, 20.0));
+		const Vector3 size(rng.random(0.0, 6.0), rng.random(0.0, 6.0), rng.random(0.0, 6.0));
+		bounds.push_back(RendererSceneCull::InstanceBounds(AABB(position, size)));
+	}
+
+	int inside = 0;
+	int outside = 0;
+	for (int frustum_index = 0; frustum_index < 20; frustum_index++) {
+		Projection projection;
+		if (frustum_index % 2) {
+			projection.set_perspective(rng.random(30.0, 110.0), rng.random(0.5, 2.0), 0.05, rng.random(5.0, 40.0));
+		} else {
+			const real_t size = rng.random(2.0, 20.0);
+			projection.set_orthogonal(-size, size, -size, size, 0.05, rng.random(5.0, 40.0));
+		}
+		const Basis basis = Basis::from_euler(Vector3(rng.random(-Math_PI, Math_PI), rng.random(-Math_PI, Math_PI), rng.random(-Math_PI, Math_PI)));
+		const Transform3D transform(basis, Vector3(rng.random(-5.0, 5.0), rng.random(-5.0, 5.0), rng.random(-5.0, 5.0)));
+		const RendererSceneCull::Frustum frustum(projection.get_projection_planes(transform));
+
+		// Blocks of every size, starting at every offset of the bounds.
+		for (uint32_t block_count = 1; block_count <= RendererSceneCull::InstanceBoundsBlock::SIZE; block_count++) {
+			for (uint32_t from = 0; from + block_count <= bounds_count; from += block_count) {
+				RendererSceneCull::InstanceBoundsBlock block;
+				block.load(bounds, from, block_count);
+				const uint32_t mask = block.in_frustum_mask(frustum);
+
+				CHECK((mask >> block_count) == 0);
+				for (uint32_t lane = 0; lane < block_count; lane++) {
+					const bool in_frustum = bounds[from + lane].in_frustum(frustum);
+					CHECK(bool(mask & (1u << lane)) == in_frustum);
+					if (in_frustum) {
+						inside++;
+					} else {
+						outside++;
+					}
+				}
+			}
+		}
+	}
+	CHECK(inside > 0);
+	CHECK(outside > 0);
+
+	bounds.reset();
+	pool.reset();
+}
+
+} // namespace TestSceneCullBounds
+
+#endif // TEST_SCENE_CULL_BOUNDS_H
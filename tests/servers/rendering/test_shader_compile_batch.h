@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  test_shader_compile_batch.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILE_BATCH_H
+#define TEST_SHADER_COMPILE_BATCH_H
+
+#include "scene/resources/material.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompileBatch {
+
+static String make_shader_code(int p_uniform_count) {
+	String code = "shader_type spatial;\n";
+	for (int i = 0; i < p_uniform_count; i++) {
+		code += vformat("uniform float param_%d = %d.0;\n", i, i);
+	}
+	code += "void fragment() {\n\tALBEDO = vec3(1.0);\n}\n";
+	return code;
+}
+
+TEST_CASE("[SceneTree][ShaderCompileBatch] Batch matches individual compilation") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	const int shader_count = 32;
+	Vector<RID> batch_shaders;
+	Vector<RID> single_shaders;
+	Vector<String> codes;
+	for (int i = 0; i < shader_count; i++) {
+		batch_shaders.push_back(rs->shader_create());
+		single_shaders.push_back(rs->shader_create());
+		codes.push_back(make_shader_code(i % 5));
+	}
+
+	rs->shader_set_code_batch(batch_shaders, codes);
+	for (int i = 0; i < shader_count; i++) {
+		rs->shader_set_code(single_shaders[i], codes[i]);
+	}
+
+	for (int i = 0; i < shader_count; i++) {
+		List<PropertyInfo> batch_params;
+		List<PropertyInfo> single_params;
+		rs->get_shader_parameter_list(batch_shaders[i], &batch_params);
+		rs->get_shader_parameter_list(single_shaders[i], &single_params);
+		CHECK_MESSAGE(batch_params.size() == i % 5, vformat("Shader %d should expose its uniforms.", i));
+		CHECK(batch_params.size() == single_params.size());
+	}
+
+	for (int i = 0; i < shader_count; i++) {
+		rs->free(batch_shaders[i]);
+		rs->free(single_shaders[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompileBatch] Invalid shaders don't affect the rest of the batch") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	Vector<RID> shaders;
+	Vector<String> codes;
+	for (int i = 0; i < 4; i++) {
+		shaders.push_back(rs->shader_create());
+	}
+	codes.push_back(make_shader_code(1));
+	codes.push_back("shader_type spatial;\nuniform float broken = ;\n");
+	codes.push_back(make_shader_code(2));
+	codes.push_back("");
+
+	ERR_PRINT_OFF;
+	rs->shader_set_code_batch(shaders, codes);
+	ERR_PRINT_ON;
+
+	const int expected[4] = { 1, 0, 2, 0 };
+	for (int i = 0; i < 4; i++) {
+		List<PropertyInfo> params;
+		rs->get_shader_parameter_list(shaders[i], &params);
+		CHECK(params.size() == expected[i]);
+		rs->free(shaders[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompileBatch] Flushing dirty materials compiles their shaders") {
+	BaseMaterial3D::flush_changes();
+
+	// Different features give each material its own shader, so the flush sets the code of several shaders at once.
+	Ref<StandardMaterial3D> plain;
+	plain.instantiate();
+	Ref<StandardMaterial3D> transparent;
+	transparent.instantiate();
+	transparent->set_transparency(BaseMaterial3D::TRANSPARENCY_ALPHA);
+	Ref<StandardMaterial3D> unshaded;
+	unshaded.instantiate();
+	unshaded->set_shading_mode(BaseMaterial3D::SHADING_MODE_UNSHADED);
+
+	BaseMaterial3D::flush_changes();
+
+	const Ref<StandardMaterial3D> materials[3] = { plain, transparent, unshaded };
+	for (const Ref<StandardMaterial3D> &material : materials) {
+		List<PropertyInfo> params;
+		RS::get_singleton()->get_shader_parameter_list(material->get_shader_rid(), &params);
+		CHECK_MESSAGE(params.size() > 0, "The batched shader code should have been compiled.");
+	}
+	CHECK(plain->get_shader_rid() != transparent->get_shader_rid());
+	CHECK(plain->get_shader_rid() != unshaded->get_shader_rid());
+}
+
+} // namespace TestShaderCompileBatch
+
+#endif // TEST_SHADER_COMPILE_BATCH_H
@@ -0,0 +1,210 @@
+/**************************************************************************/
+/*  test_shader_compiler_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_CACHE_H
+#define TEST_SHADER_COMPILER_CACHE_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestShaderCompilerCache {
+
+struct CompileResult {
+	Error error = FAILED;
+	ShaderCompiler::GeneratedCode gen_code;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	bool uses_alpha = false;
+	bool writes_albedo = false;
+	bool unshaded = false;
+	int cull_mode = 0;
+};
+
+static CompileResult compile_shader(const ShaderCompiler &p_compiler, const String &p_code) {
+	CompileResult result;
+
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.usage_flag_pointers["ALPHA"] = &result.uses_alpha;
+	actions.write_flag_pointers["ALBEDO"] = &result.writes_albedo;
+	actions.render_mode_flags["unshaded"] = &result.unshaded;
+	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&result.cull_mode, 2);
+	actions.uniforms = &result.uniforms;
+
+	result.error = p_compiler.compile(RS::SHADER_SPATIAL, p_code, &actions, "", result.gen_code);
+	return result;
+}
+
+static int count_cache_files(const String &p_dir) {
+	int count = 0;
+	for (const String &file : DirAccess::get_files_at(p_dir)) {
+		if (file.ends_with(".cache")) {
+			count++;
+		}
+	}
+	return count;
+}
+
+TEST_CASE("[SceneTree][ShaderCompilerCache] Cached results match a fresh compilation") {
+	const String cache_dir = TestUtils::get_temp_path("shader_compiler_cache");
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->dir_exists(cache_dir)) {
+		da->change_dir(cache_dir);
+		da->erase_contents_recursive();
+	}
+
+	ShaderCompiler compiler;
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	compiler.initialize(default_actions);
+
+	const String code = R"(
+shader_type spatial;
+render_mode unshaded, cull_disabled;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+uniform float amount : hint_range(0.0, 2.0) = 1.5;
+
+void fragment() {
+	ALBEDO = tint.rgb * amount;
+	ALPHA = 0.5;
+}
+)";
+
+	const CompileResult uncached = compile_shader(compiler, code);
+	REQUIRE(uncached.error == OK);
+
+	ShaderCompiler::set_shader_cache_dir(cache_dir);
+
+	const CompileResult cold = compile_shader(compiler, code);
+	CHECK(cold.error == OK);
+	CHECK(compiler.get_cache_hit_count() == 0);
+	CHECK_MESSAGE(count_cache_files(cache_dir) == 1, "The result should have been written to the cache.");
+	CHECK_MESSAGE(DirAccess::get_files_at(cache_dir).size() == 1, "No temporary file should be left behind.");
+
+	const CompileResult warm = compile_shader(compiler, code);
+	CHECK(warm.error == OK);
+	CHECK_MESSAGE(compiler.get_cache_hit_count() == 1, "The second compilation should have been loaded from the cache.");
+	CHECK(count_cache_files(cache_dir) == 1);
+
+	for (const CompileResult *result : { &cold, &warm }) {
+		CHECK(result->uses_alpha);
+		CHECK(result->writes_albedo);
+		CHECK(result->unshaded);
+		CHECK(result->cull_mode == 2);
+		CHECK(result->gen_code.code.size() == uncached.gen_code.code.size());
+		for (const KeyValue<String, String> &E : uncached.gen_code.code) {
+			REQUIRE(result->gen_code.code.has(E.key));
+			CHECK(result->gen_code.code[E.key] == E.value);
+		}
+		CHECK(result->gen_code.uniforms == uncached.gen_code.uniforms);
+		CHECK(result->gen_code.uniform_total_size == uncached.gen_code.uniform_total_size);
+		CHECK(result->gen_code.uniform_offsets == uncached.gen_code.uniform_offsets);
+
+		REQUIRE(result->uniforms.has("amount"));
+		const ShaderLanguage::ShaderNode::Uniform &amount = result->uniforms["amount"];
+		CHECK(amount.hint == ShaderLanguage::ShaderNode::Uniform::HINT_RANGE);
+		CHECK(amount.hint_range[1] == doctest::Approx(2.0f));
+		REQUIRE(amount.default_value.size() == 1);
+		CHECK(amount.default_value[0].real == doctest::Approx(1.5f));
+		REQUIRE(result->uniforms.has("tint"));
+		CHECK(result->uniforms["tint"].hint == ShaderLanguage::ShaderNode::Uniform::HINT_SOURCE_COLOR);
+	}
+
+	const CompileResult other = compile_shader(compiler, code.replace("0.5;", "0.25;"));
+	CHECK(other.error == OK);
+	CHECK(compiler.get_cache_hit_count() == 1);
+	CHECK_MESSAGE(count_cache_files(cache_dir) == 2, "Different code should get its own cache entry.");
+
+	ShaderCompiler::set_shader_cache_dir(String());
+}
+
+TEST_CASE("[SceneTree][ShaderCompilerCache] Bad cache files are silently replaced") {
+	const String cache_dir = TestUtils::get_temp_path("shader_compiler_cache_bad");
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->dir_exists(cache_dir)) {
+		da->change_dir(cache_dir);
+		da->erase_contents_recursive();
+	}
+
+	ShaderCompiler compiler;
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	compiler.initialize(default_actions);
+	ShaderCompiler::set_shader_cache_dir(cache_dir);
+
+	const String code = R"(
+shader_type spatial;
+
+void fragment() {
+	ALBEDO = vec3(0.5);
+}
+)";
+
+	REQUIRE(compile_shader(compiler, code).error == OK);
+	const PackedStringArray files = DirAccess::get_files_at(cache_dir);
+	REQUIRE(files.size() == 1);
+	const String cache_file = cache_dir.path_join(files[0]);
+	const Vector<uint8_t> contents = FileAccess::get_file_as_bytes(cache_file);
+
+	SUBCASE("Truncated file") {
+		Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+		f->store_buffer(contents.ptr(), contents.size() / 2);
+	}
+
+	SUBCASE("Corrupt file") {
+		Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+		f->store_buffer((const uint8_t *)"GDSLcorrupt", 11);
+	}
+
+	SUBCASE("Other version") {
+		Vector<uint8_t> other_version = contents;
+		other_version.write[4]++;
+		Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+		f->store_buffer(other_version);
+	}
+
+	// Not an error: compiled again, without reporting anything, and the entry rewritten.
+	CHECK(compile_shader(compiler, code).error == OK);
+	CHECK(compiler.get_cache_hit_count() == 0);
+	CHECK(FileAccess::get_file_as_bytes(cache_file) == contents);
+
+	CHECK(compile_shader(compiler, code).error == OK);
+	CHECK(compiler.get_cache_hit_count() == 1);
+
+	ShaderCompiler::set_shader_cache_dir(String());
+}
+
+} // namespace TestShaderCompilerCache
+
+#endif // TEST_SHADER_COMPILER_CACHE_H
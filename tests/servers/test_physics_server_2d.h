@@ -0,0 +1,394 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+// A grid of static rectangles and circles with gaps between them, so queries both hit and miss.
+struct QueryScene {
+	RID space;
+	RID rect_shape;
+	RID circle_shape;
+	LocalVector<RID> bodies;
+
+	QueryScene() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		rect_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(rect_shape, Vector2(1, 1));
+		circle_shape = ps->circle_shape_create();
+		ps->shape_set_data(circle_shape, 0.5);
+
+		for (int x = -1; x <= 1; x++) {
+			for (int y = -1; y <= 1; y++) {
+				RID body = ps->body_create();
+				ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+				ps->body_set_space(body, space);
+				ps->body_add_shape(body, (x + y) % 2 ? circle_shape : rect_shape);
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(x * 4 + y * 0.5, y * 4)));
+				bodies.push_back(body);
+			}
+		}
+
+		ps->step(1.0 / 60.0);
+	}
+
+	~QueryScene() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(rect_shape);
+		ps->free(circle_shape);
+		ps->free(space);
+	}
+};
+
+// Enough queries to be split into several chunks by servers that run batches in parallel.
+static const int QUERY_COUNT = 25 * 5;
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Batched queries match single queries") {
+	QueryScene scene;
+	PhysicsDirectSpaceState2D *space_state = PhysicsServer2D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(space_state != nullptr);
+
+	LocalVector<Vector2> points;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		points.push_back(Vector2((i % 25) * 0.6 - 7.2, (i / 25) * 3.1 - 6.2 + (i % 3) * 0.4));
+	}
+
+	SUBCASE("Rays") {
+		LocalVector<Vector2> from;
+		LocalVector<Vector2> to;
+		for (const Vector2 &point : points) {
+			from.push_back(point - Vector2(0, 10));
+			to.push_back(point + Vector2(1, 10));
+		}
+
+		PhysicsDirectSpaceState2D::RayParameters parameters;
+		LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+		results.resize(QUERY_COUNT);
+		LocalVector<bool> hits;
+		hits.resize(QUERY_COUNT);
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), QUERY_COUNT, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState2D::RayResult result;
+			const bool hit = space_state->intersect_ray(parameters, result);
+			CHECK(hits[i] == hit);
+			if (hit && hits[i]) {
+				hit_count++;
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+				CHECK(results[i].position.is_equal_approx(result.position));
+				CHECK(results[i].normal.is_equal_approx(result.normal));
+			}
+		}
+		CHECK_MESSAGE(hit_count > 0, "Some of the rays should hit.");
+		CHECK_MESSAGE(hit_count < QUERY_COUNT, "Some of the rays should miss.");
+	}
+
+	SUBCASE("Points") {
+		PhysicsDirectSpaceState2D::PointParameters parameters;
+		LocalVector<PhysicsDirectSpaceState2D::ShapeResult> results;
+		results.resize(QUERY_COUNT);
+		LocalVector<bool> hits;
+		hits.resize(QUERY_COUNT);
+		space_state->intersect_points(parameters, points.ptr(), QUERY_COUNT, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.position = points[i];
+			PhysicsDirectSpaceState2D::ShapeResult result;
+			const bool hit = space_state->intersect_point(parameters, &result, 1) > 0;
+			CHECK(hits[i] == hit);
+			if (hit && hits[i]) {
+				hit_count++;
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+			}
+		}
+		CHECK_MESSAGE(hit_count > 0, "Some of the points should be inside a shape.");
+		CHECK_MESSAGE(hit_count < QUERY_COUNT, "Some of the points should be outside every shape.");
+	}
+
+	SUBCASE("Shape casts") {
+		LocalVector<Vector2> origins;
+		LocalVector<Vector2> motions;
+		for (const Vector2 &point : points) {
+			origins.push_back(point - Vector2(0, 10));
+			motions.push_back(Vector2(1, 20));
+		}
+
+		PhysicsDirectSpaceState2D::ShapeParameters parameters;
+		parameters.shape_rid = scene.circle_shape;
+		LocalVector<real_t> safe;
+		safe.resize(QUERY_COUNT);
+		LocalVector<real_t> unsafe;
+		unsafe.resize(QUERY_COUNT);
+		space_state->cast_motions(parameters, origins.ptr(), motions.ptr(), QUERY_COUNT, safe.ptr(), unsafe.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.transform.set_origin(origins[i]);
+			parameters.motion = motions[i];
+			real_t closest_safe = 1.0;
+			real_t closest_unsafe = 1.0;
+			space_state->cast_motion(parameters, closest_safe, closest_unsafe);
+			CHECK(safe[i] == doctest::Approx(closest_safe));
+			CHECK(unsafe[i] == doctest::Approx(closest_unsafe));
+			hit_count += closest_unsafe < 1.0 ? 1 : 0;
+		}
+		CHECK_MESSAGE(hit_count > 0, "Some of the casts should collide.");
+		CHECK_MESSAGE(hit_count < QUERY_COUNT, "Some of the casts should be free.");
+	}
+}
+
+// A few boxes dropped on a floor, sized in pixels like 2D scenes are.
+// With p_shuffle, the bodies keep their creation order but are allocated elsewhere and enter the space in reverse,
+// which changes the order they are activated in and the order their pairs are reported in.
+struct BoxPile {
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	LocalVector<RID> bodies;
+
+	BoxPile(bool p_shuffle = false) {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		floor_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(floor_shape, Vector2(200, 20));
+		box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(10, 10));
+
+		LocalVector<RID> fillers;
+		if (p_shuffle) {
+			for (int i = 0; i < 7; i++) {
+				fillers.push_back(ps->body_create());
+			}
+		}
+
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 20)));
+		bodies.push_back(floor);
+
+		for (int i = 0; i < 12; i++) {
+			RID box = ps->body_create();
+			ps->body_add_shape(box, box_shape);
+			ps->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(i * 0.3, Vector2((i % 3) * 8, -20 - i * 22)));
+			bodies.push_back(box);
+		}
+
+		for (const RID &filler : fillers) {
+			ps->free(filler);
+		}
+
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			ps->body_set_space(bodies[p_shuffle ? bodies.size() - 1 - i : i], space);
+		}
+	}
+
+	void step(int p_steps) {
+		for (int i = 0; i < p_steps; i++) {
+			PhysicsServer2D::get_singleton()->step(1.0 / 60.0);
+		}
+	}
+
+	uint64_t get_state_hash() const {
+		return PhysicsServer2D::get_singleton()->space_get_state_hash(space);
+	}
+
+	~BoxPile() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+	}
+};
+
+// Returns the state hash of a box pile after p_steps steps.
+static uint64_t simulate_box_pile(int p_steps, bool p_shuffle) {
+	BoxPile pile(p_shuffle);
+	pile.step(p_steps);
+	return pile.get_state_hash();
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] State hash of deterministic simulations") {
+	const Variant deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", true);
+
+	const uint64_t initial_hash = simulate_box_pile(0, false);
+	const uint64_t first_hash = simulate_box_pile(120, false);
+	const uint64_t second_hash = simulate_box_pile(120, false);
+	const uint64_t shuffled_hash = simulate_box_pile(120, true);
+
+	CHECK_MESSAGE(first_hash == second_hash, "Running the same scene twice should give the same state.");
+	CHECK_MESSAGE(first_hash == shuffled_hash, "Activation and pair order shouldn't change the state, only creation order.");
+	CHECK_MESSAGE(first_hash != initial_hash, "The bodies should have moved.");
+
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", deterministic);
+}
+
+// Saves the state of a box pile after p_saved_steps steps, steps on, then restores it and steps again.
+static void check_save_and_restore(int p_saved_steps) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	BoxPile pile;
+	pile.step(p_saved_steps);
+
+	const uint64_t saved_hash = pile.get_state_hash();
+	const PackedByteArray state = ps->space_save_state(pile.space);
+	REQUIRE(!state.is_empty());
+
+	pile.step(30);
+	const uint64_t first_hash = pile.get_state_hash();
+	CHECK_MESSAGE(first_hash != saved_hash, "The bodies should have moved after the state was saved.");
+
+	ps->space_restore_state(pile.space, state);
+	CHECK_MESSAGE(pile.get_state_hash() == saved_hash, "Restoring should bring back the saved bodies.");
+
+	pile.step(30);
+	CHECK_MESSAGE(pile.get_state_hash() == first_hash, "Stepping from a restored state should repeat the same steps.");
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Saving and restoring the state of a space") {
+	const Variant deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", true);
+
+	SUBCASE("Falling bodies") {
+		check_save_and_restore(5);
+	}
+
+	SUBCASE("Pairs in contact") {
+		// The lowest boxes have landed by now, so their pairs carry impulses to warm start the next steps with.
+		check_save_and_restore(40);
+	}
+
+	SUBCASE("Malformed states are rejected") {
+		BoxPile pile;
+		pile.step(10);
+		const uint64_t hash = pile.get_state_hash();
+		PackedByteArray state = PhysicsServer2D::get_singleton()->space_save_state(pile.space);
+		state.resize(state.size() - 1);
+		ERR_PRINT_OFF;
+		PhysicsServer2D::get_singleton()->space_restore_state(pile.space, state);
+		ERR_PRINT_ON;
+		CHECK(pile.get_state_hash() == hash);
+	}
+
+	ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", deterministic);
+}
+
+// Enough active bodies for servers that integrate them on worker threads to do so.
+static const int FREE_BODY_COUNT = 96;
+
+// Launches bodies p_first to p_first + p_count - 1 far enough apart that they never touch, each with its own
+// velocities, damping and force. Steps p_steps times and returns their transforms, and checks that the
+// broadphase has followed them.
+static LocalVector<Transform2D> simulate_free_bodies(int p_first, int p_count, int p_steps) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID circle_shape = ps->circle_shape_create();
+	ps->shape_set_data(circle_shape, 0.5);
+
+	LocalVector<RID> bodies;
+	for (int i = p_first; i < p_first + p_count; i++) {
+		RID body = ps->body_create();
+		ps->body_set_space(body, space);
+		ps->body_add_shape(body, circle_shape);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 12) * 20, (i / 12) * 20)));
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(Math::sin(i * 1.0), -2 + Math::cos(i * 0.7)));
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, Math::cos(i * 0.4));
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_LINEAR_DAMP, (i % 5) * 0.1);
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_GRAVITY_SCALE, 0.5 + (i % 3) * 0.25);
+		ps->body_add_constant_force(body, Vector2(i % 4 - 1.5, 0), Vector2(0, 0.1));
+		bodies.push_back(body);
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	LocalVector<Transform2D> transforms;
+	PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+	for (const RID &body : bodies) {
+		const Transform2D transform = ps->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		transforms.push_back(transform);
+
+		PhysicsDirectSpaceState2D::PointParameters parameters;
+		parameters.position = transform.get_origin();
+		PhysicsDirectSpaceState2D::ShapeResult result;
+		CHECK(space_state->intersect_point(parameters, &result, 1) == 1);
+		CHECK(result.rid == body);
+	}
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(circle_shape);
+	ps->free(space);
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Bodies integrate the same alone and in large groups") {
+	const LocalVector<Transform2D> grouped = simulate_free_bodies(0, FREE_BODY_COUNT, 60);
+	REQUIRE(grouped.size() == uint32_t(FREE_BODY_COUNT));
+
+	// A single body is always integrated serially, so each one alone is the reference for the group.
+	for (int i = 0; i < FREE_BODY_COUNT; i++) {
+		const LocalVector<Transform2D> alone = simulate_free_bodies(i, 1, 60);
+		CHECK_MESSAGE(grouped[i] == alone[0], vformat("Body %d should move the same alone and in the group.", i));
+		CHECK(grouped[i].get_rotation() != 0.0);
+	}
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,658 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// A grid of static boxes with gaps between them, so queries both hit and miss.
+struct QueryScene {
+	RID space;
+	RID box_shape;
+	RID sphere_shape;
+	LocalVector<RID> bodies;
+
+	QueryScene() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		box_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+		ps->shape_set_data(box_shape, Vector3(1, 1, 1));
+		sphere_shape = ps->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+		ps->shape_set_data(sphere_shape, 0.5);
+
+		for (int x = -1; x <= 1; x++) {
+			for (int z = -1; z <= 1; z++) {
+				RID body = ps->body_create();
+				ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+				ps->body_set_space(body, space);
+				ps->body_add_shape(body, (x + z) % 2 ? sphere_shape : box_shape);
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 4, (x - z) * 0.5, z * 4)));
+				bodies.push_back(body);
+			}
+		}
+
+		ps->step(1.0 / 60.0);
+	}
+
+	~QueryScene() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(box_shape);
+		ps->free(sphere_shape);
+		ps->free(space);
+	}
+};
+
+// Enough queries to be split into several chunks by servers that run batches in parallel.
+static const int QUERY_COUNT = 25 * 5;
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries match single queries") {
+	QueryScene scene;
+	PhysicsDirectSpaceState3D *space_state = PhysicsServer3D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(space_state != nullptr);
+
+	LocalVector<Vector3> points;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		points.push_back(Vector3((i % 25) * 0.6 - 7.2, (i / 25) * 0.5 - 1.0, (i % 7) * 2.1 - 6.3));
+	}
+
+	SUBCASE("Rays") {
+		LocalVector<Vector3> from;
+		LocalVector<Vector3> to;
+		for (const Vector3 &point : points) {
+			from.push_back(point + Vector3(0, 10, 0));
+			to.push_back(point - Vector3(1, 10, 0));
+		}
+
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		results.resize(QUERY_COUNT);
+		LocalVector<bool> hits;
+		hits.resize(QUERY_COUNT);
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), QUERY_COUNT, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult result;
+			const bool hit = space_state->intersect_ray(parameters, result);
+			CHECK(hits[i] == hit);
+			if (hit && hits[i]) {
+				hit_count++;
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+				CHECK(results[i].position.is_equal_approx(result.position));
+				CHECK(results[i].normal.is_equal_approx(result.normal));
+			}
+		}
+		CHECK_MESSAGE(hit_count > 0, "Some of the rays should hit.");
+		CHECK_MESSAGE(hit_count < QUERY_COUNT, "Some of the rays should miss.");
+	}
+
+	SUBCASE("Points") {
+		PhysicsDirectSpaceState3D::PointParameters parameters;
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		results.resize(QUERY_COUNT);
+		LocalVector<bool> hits;
+		hits.resize(QUERY_COUNT);
+		space_state->intersect_points(parameters, points.ptr(), QUERY_COUNT, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.position = points[i];
+			PhysicsDirectSpaceState3D::ShapeResult result;
+			const bool hit = space_state->intersect_point(parameters, &result, 1) > 0;
+			CHECK(hits[i] == hit);
+			if (hit && hits[i]) {
+				hit_count++;
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+			}
+		}
+		CHECK_MESSAGE(hit_count > 0, "Some of the points should be inside a shape.");
+		CHECK_MESSAGE(hit_count < QUERY_COUNT, "Some of the points should be outside every shape.");
+	}
+
+	SUBCASE("Shape casts") {
+		LocalVector<Vector3> origins;
+		LocalVector<Vector3> motions;
+		for (const Vector3 &point : points) {
+			origins.push_back(point + Vector3(0, 10, 0));
+			motions.push_back(Vector3(1, -20, 0));
+		}
+
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = scene.sphere_shape;
+		LocalVector<real_t> safe;
+		safe.resize(QUERY_COUNT);
+		LocalVector<real_t> unsafe;
+		unsafe.resize(QUERY_COUNT);
+		space_state->cast_motions(parameters, origins.ptr(), motions.ptr(), QUERY_COUNT, safe.ptr(), unsafe.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.transform.origin = origins[i];
+			parameters.motion = motions[i];
+			real_t closest_safe = 1.0;
+			real_t closest_unsafe = 1.0;
+			space_state->cast_motion(parameters, closest_safe, closest_unsafe);
+			CHECK(safe[i] == doctest::Approx(closest_safe));
+			CHECK(unsafe[i] == doctest::Approx(closest_unsafe));
+			hit_count += closest_unsafe < 1.0 ? 1 : 0;
+		}
+		CHECK_MESSAGE(hit_count > 0, "Some of the casts should collide.");
+		CHECK_MESSAGE(hit_count < QUERY_COUNT, "Some of the casts should be free.");
+	}
+}
+
+// A few boxes dropped on a floor.
+// With p_shuffle, the bodies keep their creation order but are allocated elsewhere and enter the space in reverse,
+// which changes the order they are activated in and the order their pairs are reported in.
+struct BoxPile {
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	LocalVector<RID> bodies;
+
+	BoxPile(bool p_shuffle = false) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		floor_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+		ps->shape_set_data(floor_shape, Vector3(10, 1, 10));
+		box_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		LocalVector<RID> fillers;
+		if (p_shuffle) {
+			for (int i = 0; i < 7; i++) {
+				fillers.push_back(ps->body_create());
+			}
+		}
+
+		RID floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+		bodies.push_back(floor);
+
+		for (int i = 0; i < 12; i++) {
+			RID box = ps->body_create();
+			ps->body_add_shape(box, box_shape);
+			ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), i * 0.3), Vector3((i % 3) * 0.4, 1 + i * 1.1, (i % 2) * 0.3)));
+			bodies.push_back(box);
+		}
+
+		for (const RID &filler : fillers) {
+			ps->free(filler);
+		}
+
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			ps->body_set_space(bodies[p_shuffle ? bodies.size() - 1 - i : i], space);
+		}
+	}
+
+	void step(int p_steps) {
+		for (int i = 0; i < p_steps; i++) {
+			PhysicsServer3D::get_singleton()->step(1.0 / 60.0);
+		}
+	}
+
+	uint64_t get_state_hash() const {
+		return PhysicsServer3D::get_singleton()->space_get_state_hash(space);
+	}
+
+	~BoxPile() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+	}
+};
+
+// Returns the state hash of a box pile after p_steps steps.
+static uint64_t simulate_box_pile(int p_steps, bool p_shuffle) {
+	BoxPile pile(p_shuffle);
+	pile.step(p_steps);
+	return pile.get_state_hash();
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] State hash of deterministic simulations") {
+	const Variant deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+
+	const uint64_t initial_hash = simulate_box_pile(0, false);
+	const uint64_t first_hash = simulate_box_pile(120, false);
+	const uint64_t second_hash = simulate_box_pile(120, false);
+	const uint64_t shuffled_hash = simulate_box_pile(120, true);
+
+	CHECK_MESSAGE(first_hash == second_hash, "Running the same scene twice should give the same state.");
+	CHECK_MESSAGE(first_hash == shuffled_hash, "Activation and pair order shouldn't change the state, only creation order.");
+	CHECK_MESSAGE(first_hash != initial_hash, "The bodies should have moved.");
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", deterministic);
+}
+
+// Saves the state of a box pile after p_saved_steps steps, steps on, then restores it and steps again.
+static void check_save_and_restore(int p_saved_steps) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	BoxPile pile;
+	pile.step(p_saved_steps);
+
+	const uint64_t saved_hash = pile.get_state_hash();
+	const PackedByteArray state = ps->space_save_state(pile.space);
+	REQUIRE(!state.is_empty());
+
+	pile.step(30);
+	const uint64_t first_hash = pile.get_state_hash();
+	CHECK_MESSAGE(first_hash != saved_hash, "The bodies should have moved after the state was saved.");
+
+	ps->space_restore_state(pile.space, state);
+	CHECK_MESSAGE(pile.get_state_hash() == saved_hash, "Restoring should bring back the saved bodies.");
+
+	pile.step(30);
+	CHECK_MESSAGE(pile.get_state_hash() == first_hash, "Stepping from a restored state should repeat the same steps.");
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Saving and restoring the state of a space") {
+	const Variant deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+
+	SUBCASE("Falling bodies") {
+		check_save_and_restore(5);
+	}
+
+	SUBCASE("Pairs in contact") {
+		// The lowest boxes have landed by now, so their pairs carry impulses to warm start the next steps with.
+		check_save_and_restore(40);
+	}
+
+	SUBCASE("Malformed states are rejected") {
+		BoxPile pile;
+		pile.step(10);
+		const uint64_t hash = pile.get_state_hash();
+		PackedByteArray state = PhysicsServer3D::get_singleton()->space_save_state(pile.space);
+		state.resize(state.size() - 1);
+		ERR_PRINT_OFF;
+		PhysicsServer3D::get_singleton()->space_restore_state(pile.space, state);
+		ERR_PRINT_ON;
+		CHECK(pile.get_state_hash() == hash);
+	}
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", deterministic);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Sleeping bodies keep their pairs and wake up when hit") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID floor_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+	ps->shape_set_data(floor_shape, Vector3(10, 1, 10));
+	RID box_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = ps->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	ps->shape_set_data(sphere_shape, 0.5);
+
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	ps->body_set_space(floor, space);
+
+	// A stack of two boxes resting on the floor, so the bottom box only touches the top one through their pair.
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 2; i++) {
+		RID box = ps->body_create();
+		ps->body_add_shape(box, box_shape);
+		ps->body_set_max_contacts_reported(box, 4);
+		ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.5 + i, 0)));
+		ps->body_set_space(box, space);
+		boxes.push_back(box);
+	}
+
+	const PackedByteArray initial_state = ps->space_save_state(space);
+
+	for (int i = 0; i < 120; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	for (const RID &box : boxes) {
+		REQUIRE(bool(ps->body_get_state(box, PhysicsServer3D::BODY_STATE_SLEEPING)));
+	}
+
+	// Falling asleep moves the boxes to another broadphase tree, which must not unpair them.
+	ps->step(1.0 / 60.0);
+	const uint64_t asleep_hash = ps->space_get_state_hash(space);
+	const PackedByteArray asleep_state = ps->space_save_state(space);
+	CHECK_MESSAGE(asleep_state.size() > initial_state.size(), "The pairs of the pile should be saved with the state.");
+
+	for (int i = 0; i < 60; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	CHECK(ps->space_get_state_hash(space) == asleep_hash);
+	CHECK_MESSAGE(ps->space_save_state(space).size() == asleep_state.size(), "Sleeping bodies should keep their pairs.");
+	for (const RID &box : boxes) {
+		CHECK(bool(ps->body_get_state(box, PhysicsServer3D::BODY_STATE_SLEEPING)));
+		CHECK_MESSAGE(ps->body_get_direct_state(box)->get_contact_count() > 0, "Sleeping bodies should keep their contacts.");
+	}
+
+	// A sphere dropped on the pile wakes the top box, and the bottom one through the pair they kept while asleep.
+	RID sphere = ps->body_create();
+	ps->body_add_shape(sphere, sphere_shape);
+	ps->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 4, 0)));
+	ps->body_set_space(sphere, space);
+
+	bool woken[2] = { false, false };
+	for (int i = 0; i < 120; i++) {
+		ps->step(1.0 / 60.0);
+		for (uint32_t j = 0; j < boxes.size(); j++) {
+			woken[j] = woken[j] || !bool(ps->body_get_state(boxes[j], PhysicsServer3D::BODY_STATE_SLEEPING));
+		}
+	}
+	CHECK_MESSAGE(woken[1], "The sphere should wake up the box it lands on.");
+	CHECK_MESSAGE(woken[0], "The box below should wake up with the one on top of it.");
+
+	const Vector3 sphere_origin = Transform3D(ps->body_get_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+	CHECK_MESSAGE(sphere_origin.y > 2.0, "The sphere should land on the pile, not fall through it.");
+	CHECK(sphere_origin.y < 3.0);
+	const Vector3 top_origin = Transform3D(ps->body_get_state(boxes[1], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+	CHECK(top_origin.y > 1.0);
+
+	ps->free(sphere);
+	for (const RID &box : boxes) {
+		ps->free(box);
+	}
+	ps->free(floor);
+	ps->free(sphere_shape);
+	ps->free(box_shape);
+	ps->free(floor_shape);
+	ps->free(space);
+}
+
+// Enough active bodies for servers that integrate them on worker threads to do so.
+static const int FREE_BODY_COUNT = 96;
+
+// Launches bodies p_first to p_first + p_count - 1 far enough apart that they never touch, each with its own
+// velocities, damping and force. Steps p_steps times and returns their transforms, and checks that the
+// broadphase has followed them.
+static LocalVector<Transform3D> simulate_free_bodies(int p_first, int p_count, int p_steps) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID sphere_shape = ps->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	ps->shape_set_data(sphere_shape, 0.5);
+
+	LocalVector<RID> bodies;
+	for (int i = p_first; i < p_first + p_count; i++) {
+		RID body = ps->body_create();
+		ps->body_set_space(body, space);
+		ps->body_add_shape(body, sphere_shape);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((i % 12) * 20, 0, (i / 12) * 20)));
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(Math::sin(i * 1.0), 2 + Math::cos(i * 0.7), Math::sin(i * 1.3)));
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(Math::cos(i * 0.4), Math::sin(i * 0.9), 1));
+		ps->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP, (i % 5) * 0.1);
+		ps->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.5 + (i % 3) * 0.25);
+		ps->body_add_constant_force(body, Vector3(i % 4 - 1.5, 0, 0), Vector3(0, 0.1, 0));
+		bodies.push_back(body);
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	LocalVector<Transform3D> transforms;
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+	for (const RID &body : bodies) {
+		const Transform3D transform = ps->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		transforms.push_back(transform);
+
+		PhysicsDirectSpaceState3D::PointParameters parameters;
+		parameters.position = transform.origin;
+		PhysicsDirectSpaceState3D::ShapeResult result;
+		CHECK(space_state->intersect_point(parameters, &result, 1) == 1);
+		CHECK(result.rid == body);
+	}
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(sphere_shape);
+	ps->free(space);
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Bodies integrate the same alone and in large groups") {
+	const LocalVector<Transform3D> grouped = simulate_free_bodies(0, FREE_BODY_COUNT, 60);
+	REQUIRE(grouped.size() == uint32_t(FREE_BODY_COUNT));
+
+	// A single body is always integrated serially, so each one alone is the reference for the group.
+	for (int i = 0; i < FREE_BODY_COUNT; i++) {
+		const LocalVector<Transform3D> alone = simulate_free_bodies(i, 1, 60);
+		CHECK_MESSAGE(grouped[i] == alone[0], vformat("Body %d should move the same alone and in the group.", i));
+		CHECK(grouped[i].basis != Basis());
+	}
+}
+
+// A floor, a wall and a ceiling, with rows of kinematic boxes moving into each of them.
+struct SlideScene {
+	RID space;
+	RID box_shape;
+	LocalVector<RID> static_shapes;
+	LocalVector<RID> static_bodies;
+	LocalVector<RID> bodies;
+	LocalVector<Vector3> motions;
+
+	static const int ROW_SIZE = 4;
+
+	void add_static_box(const Vector3 &p_half_extents, const Vector3 &p_position) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		RID shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+		ps->shape_set_data(shape, p_half_extents);
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_set_space(body, space);
+		ps->body_add_shape(body, shape);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+		static_shapes.push_back(shape);
+		static_bodies.push_back(body);
+	}
+
+	void add_row(const Vector3 &p_position, const Vector3 &p_motion) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (int i = 0; i < ROW_SIZE; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_KINEMATIC);
+			ps->body_set_space(body, space);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position + Vector3(0, 0, i * 3)));
+			bodies.push_back(body);
+			motions.push_back(p_motion);
+		}
+	}
+
+	SlideScene() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		box_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		// Floor top at y = 0, wall face at x = 9, ceiling bottom at y = 9.
+		add_static_box(Vector3(50, 1, 50), Vector3(0, -1, 0));
+		add_static_box(Vector3(1, 10, 50), Vector3(10, 10, 0));
+		add_static_box(Vector3(5, 1, 50), Vector3(-10, 10, 0));
+
+		// Falling onto the floor, running into the wall, and jumping into the ceiling.
+		add_row(Vector3(0, 0.6, 0), Vector3(2, -1, 0));
+		add_row(Vector3(8, 2, 0), Vector3(2, 0, 1));
+		add_row(Vector3(-10, 8, 0), Vector3(1, 2, 0));
+
+		ps->step(1.0 / 60.0);
+	}
+
+	~SlideScene() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		for (const RID &body : static_bodies) {
+			ps->free(body);
+		}
+		for (const RID &shape : static_shapes) {
+			ps->free(shape);
+		}
+		ps->free(box_shape);
+		ps->free(space);
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched move and slide") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	SlideScene scene;
+	const int count = scene.bodies.size();
+	const int row_size = SlideScene::ROW_SIZE;
+
+	PhysicsServer3D::SlideParameters parameters;
+	parameters.update_transforms = false;
+
+	SUBCASE("Floor, wall and ceiling") {
+		LocalVector<PhysicsServer3D::SlideResult> results;
+		results.resize(count);
+		ps->body_move_and_slide_batch(scene.bodies.ptr(), scene.motions.ptr(), count, parameters, results.ptr());
+
+		for (int i = 0; i < count; i++) {
+			const PhysicsServer3D::SlideResult &result = results[i];
+			const Transform3D from = ps->body_get_state(scene.bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(result.transform.origin.is_equal_approx(from.origin + result.travel));
+			CHECK(result.collision_count >= 1);
+			CHECK(result.remainder.is_zero_approx());
+
+			if (i < row_size) {
+				// Lands 0.1 lower, then slides the rest of the way along the floor.
+				CHECK(result.on_floor);
+				CHECK_FALSE(result.on_wall);
+				CHECK_FALSE(result.on_ceiling);
+				CHECK(result.floor_normal.is_equal_approx(Vector3(0, 1, 0)));
+				CHECK(result.travel.x == doctest::Approx(2.0).epsilon(0.01));
+				CHECK(result.travel.y == doctest::Approx(-0.1).epsilon(0.02));
+			} else if (i < 2 * row_size) {
+				// Stops against the wall 0.5 further, and keeps going along it.
+				CHECK_FALSE(result.on_floor);
+				CHECK(result.on_wall);
+				CHECK_FALSE(result.on_ceiling);
+				CHECK(result.travel.x == doctest::Approx(0.5).epsilon(0.01));
+				CHECK(result.travel.z == doctest::Approx(1.0).epsilon(0.01));
+			} else {
+				// Bumps the ceiling 0.5 higher, and slides under it.
+				CHECK_FALSE(result.on_floor);
+				CHECK_FALSE(result.on_wall);
+				CHECK(result.on_ceiling);
+				CHECK(result.travel.x == doctest::Approx(1.0).epsilon(0.01));
+				CHECK(result.travel.y == doctest::Approx(0.5).epsilon(0.01));
+			}
+		}
+	}
+
+	SUBCASE("Remainders") {
+		// Without any slide left, what is left of the motion after the first hit is returned.
+		parameters.max_slides = 1;
+		LocalVector<PhysicsServer3D::SlideResult> results;
+		results.resize(count);
+		ps->body_move_and_slide_batch(scene.bodies.ptr(), scene.motions.ptr(), count, parameters, results.ptr());
+
+		for (int i = 0; i < count; i++) {
+			const PhysicsServer3D::SlideResult &result = results[i];
+			CHECK(result.collision_count == 1);
+			const Vector3 expected_remainder = (scene.motions[i] - result.travel).slide(i < row_size ? Vector3(0, 1, 0) : (i < 2 * row_size ? Vector3(-1, 0, 0) : Vector3(0, -1, 0)));
+			CHECK(result.remainder.distance_to(expected_remainder) < 0.01);
+			CHECK_FALSE(result.remainder.is_zero_approx());
+		}
+	}
+
+	SUBCASE("Parallel batches match the serial default") {
+		// More bodies than fit in one chunk of a server that slides them in parallel.
+		REQUIRE(count > 8);
+
+		LocalVector<PhysicsServer3D::SlideResult> results;
+		results.resize(count);
+		ps->body_move_and_slide_batch(scene.bodies.ptr(), scene.motions.ptr(), count, parameters, results.ptr());
+
+		LocalVector<PhysicsServer3D::SlideResult> serial_results;
+		serial_results.resize(count);
+		ps->PhysicsServer3D::body_move_and_slide_batch(scene.bodies.ptr(), scene.motions.ptr(), count, parameters, serial_results.ptr());
+
+		for (int i = 0; i < count; i++) {
+			CHECK(results[i].transform.is_equal_approx(serial_results[i].transform));
+			CHECK(results[i].travel.is_equal_approx(serial_results[i].travel));
+			CHECK(results[i].remainder.is_equal_approx(serial_results[i].remainder));
+			CHECK(results[i].floor_normal.is_equal_approx(serial_results[i].floor_normal));
+			CHECK(results[i].collision_count == serial_results[i].collision_count);
+			CHECK(results[i].on_floor == serial_results[i].on_floor);
+			CHECK(results[i].on_wall == serial_results[i].on_wall);
+			CHECK(results[i].on_ceiling == serial_results[i].on_ceiling);
+		}
+	}
+
+	SUBCASE("Transforms are updated") {
+		parameters.update_transforms = true;
+		LocalVector<PhysicsServer3D::SlideResult> results;
+		results.resize(count);
+		ps->body_move_and_slide_batch(scene.bodies.ptr(), scene.motions.ptr(), count, parameters, results.ptr());
+
+		// Kinematic bodies get their new transform on the next step.
+		ps->step(1.0 / 60.0);
+
+		for (int i = 0; i < count; i++) {
+			const Transform3D transform = ps->body_get_state(scene.bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform.is_equal_approx(results[i].transform));
+		}
+	}
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H